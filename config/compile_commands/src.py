@@ -19,20 +19,25 @@ from common import (
 EXTENSIONS: Final[List[str]] = ["cc"]
 
 
+# The sources that are compiled once for each configuration
+PER_BUILD_SOURCES: Final[List[str]] = ["main.cc", "generated_environment.cc"]
+
+
 def create_main_compile_command_(
+    file: Path,
     build_id: str,
     champsim_dir: Path = DEFAULT_CHAMPSIM_DIR,
     config_dir: Path = DEFAULT_CONFIG_DIR,
 ) -> CompileCommand:
-    """Create the compile command for main.cc.
+    """Create the compile command for a source that is compiled for each configuration.
 
+    :param file: Path to the source file.
     :param build_id: The ChampSim build ID.
     :param champsim_dir: Path to the ChampSim repository.
     :param config_dir: Path to the ChampSim config directory.
-    :return: Compile command for main.cc.
+    :return: Compile command for the source file.
     """
-    file: Final[Path] = champsim_dir / "src" / "main.cc"
-    object_file: Final[Path] = config_dir / f"{build_id}_main.o"
+    object_file: Final[Path] = config_dir / f"{build_id}_{file.stem}.o"
 
     return CompileCommand(
         arguments=[
@@ -41,6 +46,8 @@ def create_main_compile_command_(
             *get_options(champsim_dir / "absolute.options"),
             f"-I{config_dir}",
             f"-DCHAMPSIM_BUILD=0x{build_id}",
+            "-iquote",
+            f"{config_dir / build_id}",
             "-c",
             "-o",
             f"{object_file.absolute()}",
@@ -98,9 +105,9 @@ def create_src_compile_command(
     :param config_dir: Path to the ChampSim config directory.
     :return Compile command for the source file.
     """
-    if file.parts[-1] == "main.cc":
+    if file.parts[-1] in PER_BUILD_SOURCES:
         return create_main_compile_command_(
-            build_id, champsim_dir=champsim_dir, config_dir=config_dir
+            file, build_id, champsim_dir=champsim_dir, config_dir=config_dir
         )
     else:
         return create_src_compile_command_(
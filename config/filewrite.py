@@ -162,10 +162,18 @@ class Fragment:
                 print('Touching file:', str(legacy_marker))
             legacy_marker.touch()
 
+        # Legacy modules can only be chosen in the configuration
+        runtime_modules = []
+        if config_file.get('runtime_modules'):
+            runtime_modules = [(kind, module) for kind in ('pref', 'repl') for module in module_info[kind].values() if not module.get('legacy')]
+
+        # Each configuration has its own instantiation files, so that only its own translation units see them
+        instdir_name = os.path.join(objdir_name, build_id)
+
         fileparts = [
             # Instantiation file
-            (os.path.join(objdir_name, 'core_inst.inc'), cxx_file(get_instantiation_header(len(elements['cores']), config_file, build_id=build_id))),
-            (os.path.join(objdir_name, 'core_inst.cc.inc'), cxx_file(get_instantiation_lines(build_id=build_id, **elements))),
+            (os.path.join(instdir_name, 'core_inst.inc'), cxx_file(get_instantiation_header(len(elements['cores']), len(elements['caches']), len(elements['ptws']), config_file, build_id=build_id, runtime_modules=bool(runtime_modules), dram_name=elements['pmem']['name']))),
+            (os.path.join(instdir_name, 'core_inst.cc.inc'), cxx_file(get_instantiation_lines(build_id=build_id, runtime_modules=runtime_modules, **elements))),
 
             # Makefile generation
             (os.path.join(makedir_name, '_configuration.mk'), (
@@ -22,7 +22,7 @@ import multiprocessing as mp
 from . import util
 from . import cxx
 
-pmem_fmtstr = 'champsim::chrono::picoseconds{{{clock_period_dbus}}}, champsim::chrono::picoseconds{{{clock_period_mc}}}, std::size_t{{{_tRP}}}, std::size_t{{{_tRCD}}}, std::size_t{{{_tCAS}}}, std::size_t{{{_tRAS}}}, champsim::chrono::microseconds{{{_refresh_period}}}, {{{_ulptr}}}, {rq_size}, {wq_size}, {channels}, champsim::data::bytes{{{channel_width}}}, {_bank_rows}, {_bank_columns}, {ranks}, {bankgroups}, {banks}, {_refreshes_per_period}'
+pmem_fmtstr = 'champsim::chrono::picoseconds{{{clock_period_dbus}}}, champsim::chrono::picoseconds{{{clock_period_mc}}}, std::size_t{{{_tRP}}}, std::size_t{{{_tRCD}}}, std::size_t{{{_tCAS}}}, std::size_t{{{_tRAS}}}, champsim::chrono::microseconds{{{_refresh_period}}}, {{{_ulptr}}}, {_rq_size}, {_wq_size}, {channels}, champsim::data::bytes{{{channel_width}}}, {_bank_rows}, {_bank_columns}, {ranks}, {bankgroups}, {banks}, {_refreshes_per_period}, champsim::static_dram_address_mapping<{channel_width}, block_size / {channel_width}, {channels}, {bankgroups}, {banks}, {_bank_columns}, {ranks}, {_bank_rows}>::decoder'
 vmem_fmtstr = 'champsim::data::bytes{{{pte_page_size}}}, {num_levels}, champsim::chrono::picoseconds{{{clock_period}*{minor_fault_penalty}}}, {dram_name}, {_randomization}'
 
 queue_fmtstr = '{rq_size}, {pq_size}, {wq_size}, champsim::data::bits{{{_offset_bits}}}, {_queue_check_full_addr:b}'
@@ -81,6 +81,7 @@ cache_builder_parts = {
     'max_fill': '.fill_bandwidth(champsim::bandwidth::maximum_type{{{max_fill}}})',
     '_offset_bits': '.offset_bits(champsim::data::bits{{{_offset_bits}}})',
     'prefetch_activate': '.prefetch_activate({^prefetch_activate_string})',
+    'ip_attribution': '.ip_attribution({ip_attribution})',
     '_replacement_data': '.replacement<{^replacement_string}>()',
     '_prefetcher_data': '.prefetcher<{^prefetcher_string}>()',
     'lower_translate': '.lower_translate(&{^lower_translate_queues})',
@@ -193,6 +194,11 @@ def get_ptw_builder(ptw, ul_pairs):
         ('pscl2_set', 'pscl2_way'): '.add_pscl(2, {pscl2_set}, {pscl2_way})'
     }
 
+    local_ptw_flag_parts = {
+        ('occupancy_stats', True): '.set_occupancy_stats()',
+        ('occupancy_stats', False): '.reset_occupancy_stats()'
+    }
+
     uppers = (v for v in ul_pairs if v[0] == ptw.get('name'))
     local_params = {
         '^upper_levels_string': vector_string(f'&channels.at({ul_pairs.index(v)})' for v in uppers),
@@ -205,7 +211,8 @@ def get_ptw_builder(ptw, ul_pairs):
         ('champsim::ptw_builder{{ champsim::defaults::default_ptw }}',),
         required_parts,
         (v for k,v in ptw_builder_parts.items() if k in ptw),
-        (v for keys,v in local_ptw_builder_parts.items() if any(k in ptw for k in keys))
+        (v for keys,v in local_ptw_builder_parts.items() if any(k in ptw for k in keys)),
+        (v for k,v in local_ptw_flag_parts.items() if k[0] in ptw and k[1] == ptw[k[0]])
     ), indent=1, line_end=''))
     yield from (part.format(**ptw, **local_params) for part in builder_parts)
 
@@ -226,6 +233,22 @@ def get_ref_vector_function(rtype, func_name, basename):
     yield from cxx.function(func_name, wrapped, rtype=wrapped_rtype)
     yield ''
 
+def get_overridden_builder(name, builder):
+    '''
+    Wrap a builder so that the parameters overridden when the simulator starts replace the configured ones.
+
+    :param name: The name of the component that the builder makes.
+    :param builder: The lines of the builder.
+    '''
+    head, tail = util.cut(builder, n=-1)
+    yield f'overrides.apply("{name}",'
+    yield from ('  '+l for l in head)
+    yield from ('  '+l+')' for l in tail)
+
+def get_overridden_value(component, parameter, value):
+    ''' Generate an expression for a parameter that can be overridden when the simulator starts. '''
+    return f'overrides.value("{component}", "{parameter}", {value})'
+
 def get_builder_function_call(class_name, builders):
     '''
     Generate a call to a function that consumes builders.
@@ -312,9 +335,31 @@ def decorate_queues(caches, ptws, pmem):
 def get_queue_info(ul_pairs, decoration):
     return [decoration.get(ll) for ll,_ in ul_pairs]
 
-def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
+def get_large_page_policy(large_pages):
+    def as_address(val):
+        return f'champsim::address{{{int(val, 0) if isinstance(val, str) else int(val)}}}'
+
+    asids = ', '.join(str(int(asid)) for asid in large_pages['asids'])
+    ranges = ', '.join(f'{{{as_address(begin)}, {as_address(end)}}}' for begin, end in large_pages['ranges'])
+    return f'champsim::large_page_policy{{champsim::data::bytes{{{large_pages["size"]}}}, {{{asids}}}, {{{ranges}}}, {int(large_pages["promotion_threshold"])}, champsim::data::bytes{{{large_pages["reserved"]}}}}}'
+
+def get_runtime_module_registry(classname, runtime_modules):
+    '''
+    Generate the function that registers the modules that can be selected at runtime, by the names of their directories.
+    '''
+    adders = {'pref': 'add_prefetcher', 'repl': 'add_replacement'}
+    body = (
+        'champsim::module_registry retval{};',
+        *(f'retval.{adders[kind]}<class {m["class"]}>("{os.path.basename(m["path"])}");' for kind, m in runtime_modules),
+        'return retval;'
+    )
+    yield from cxx.function(f'{classname}::runtime_modules', body, rtype='champsim::module_registry')
+
+def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id, runtime_modules=()):
     '''
     Generate the lines for a C++ file that instantiates a configuration.
+
+    :param runtime_modules: a sequence of pairs of a module type tag ('pref' or 'repl') and the module's data, for the modules that can be selected at runtime
     '''
     classname = f'champsim::configured::generated_environment<0x{build_id}>'
     ul_pairs = get_upper_levels(cores, caches, ptws)
@@ -324,7 +369,8 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
         *(c['_branch_predictor_data'] for c in cores),
         *(c['_btb_data'] for c in cores),
         *(c['_prefetcher_data'] for c in caches),
-        *(c['_replacement_data'] for c in caches)
+        *(c['_replacement_data'] for c in caches),
+        (m for _, m in runtime_modules)
     ))
     yield from module_include_files(datas)
 
@@ -339,10 +385,12 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
         pmem_fmtstr.format(
             clock_period_dbus=int(1000000/pmem['data_rate']),
             clock_period_mc=int(1000000/pmem['frequency']),
-            _tRP=int(pmem['tRP']),
-            _tRCD=int(pmem['tRCD']),
-            _tCAS=int(pmem['tCAS']),
-            _tRAS=int(pmem['tRAS']),
+            _tRP=get_overridden_value(pmem['name'], 'tRP', int(pmem['tRP'])),
+            _tRCD=get_overridden_value(pmem['name'], 'tRCD', int(pmem['tRCD'])),
+            _tCAS=get_overridden_value(pmem['name'], 'tCAS', int(pmem['tCAS'])),
+            _tRAS=get_overridden_value(pmem['name'], 'tRAS', int(pmem['tRAS'])),
+            _rq_size=get_overridden_value(pmem['name'], 'rq_size', int(pmem['rq_size'])),
+            _wq_size=get_overridden_value(pmem['name'], 'wq_size', int(pmem['wq_size'])),
             _bank_rows=int(pmem['bank_rows']), #added for supporting old configs, mainly column size change
             _bank_columns=int(pmem['columns']*8 if 'columns' in pmem else pmem['bank_columns']),
             _refresh_period=int(1000*pmem['refresh_period']),
@@ -358,7 +406,7 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
             dram_name=pmem['name'], 
             clock_period=global_clock_period,
             _randomization= '{}' if (isinstance(vmem['randomization'],bool) and vmem['randomization'] == False) else int(vmem['randomization']),
-            **vmem),
+            **vmem) + (', ' + get_large_page_policy(vmem['large_pages']) if 'large_pages' in vmem else ''),
         '},',
     )
 
@@ -370,18 +418,28 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
 
     cache_instantiation_body = (
         'caches {',
-        *get_builder_function_call('CACHE', map(functools.partial(get_cache_builder, ul_pairs=ul_pairs), caches)),
+        *get_builder_function_call('CACHE', (get_overridden_builder(c['name'], get_cache_builder(c, ul_pairs=ul_pairs)) for c in caches)),
         '},'
     )
 
     core_instantiation_body = (
         'cores {',
         *get_builder_function_call('O3_CPU',
-                                   map(functools.partial(get_cpu_builder, caches=caches, ul_pairs=ul_pairs), cores)),
-        '}'
+                                   (get_overridden_builder(c['name'], get_cpu_builder(c, caches=caches, ul_pairs=ul_pairs)) for c in cores)),
+        '},'
     )
 
-    yield f'champsim::configured::generated_environment<0x{build_id}>::generated_environment() :'
+    # The components in the same order as operable_view()
+    component_instantiation_body = (
+        'components{std::tuple_cat(',
+        f'champsim::tie_front<{len(cores)}>(cores),',
+        f'champsim::tie_front<{len(caches)}>(caches),',
+        f'champsim::tie_front<{len(ptws)}>(ptws),',
+        'std::tie(DRAM)',
+        ')}'
+    )
+
+    yield f'champsim::configured::generated_environment<0x{build_id}>::generated_environment(const champsim::geometry_overrides& overrides) :'
     yield from itertools.chain(
     )
     yield from channel_instantiation_body
@@ -390,6 +448,7 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from ptw_instantiation_body
     yield from cache_instantiation_body
     yield from core_instantiation_body
+    yield from component_instantiation_body
     yield '{'
     yield '}'
     yield ''
@@ -417,8 +476,29 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from cxx.function(f'{classname}::dram_view', [f'return {pmem["name"]};'], rtype='MEMORY_CONTROLLER&')
     yield ''
 
-def get_instantiation_header(num_cpus, env, build_id):
+    yield from cxx.function(f'{classname}::operate_on', ['return components.operate_on(clock);'],
+                            args=(('const champsim::chrono::clock&', 'clock'),), rtype='long')
+    yield ''
+
+    if runtime_modules:
+        yield from get_runtime_module_registry(classname, runtime_modules)
+        yield ''
+
+def get_component_type(num_cpus, num_caches, num_ptws):
+    '''
+    Generate the type that holds a reference to each component, with its concrete type.
+    '''
+    members = itertools.chain(
+        itertools.repeat('O3_CPU', num_cpus),
+        itertools.repeat('CACHE', num_caches),
+        itertools.repeat('PageTableWalker', num_ptws),
+        ('MEMORY_CONTROLLER',)
+    )
+    return f'champsim::operable_tuple<{", ".join(members)}>'
+
+def get_instantiation_header(num_cpus, num_caches, num_ptws, env, build_id, runtime_modules=False, dram_name='DRAM'):
     yield '#include "environment.h"'
+    yield '#include "geometry_overrides.h"'
     yield '#include "vmem.h"'
     yield '#include <forward_list>'
     yield 'template <>'
@@ -430,18 +510,22 @@ def get_instantiation_header(num_cpus, env, build_id):
         'std::forward_list<PageTableWalker> ptws;',
         'std::forward_list<CACHE> caches;',
         'std::forward_list<O3_CPU> cores;',
+        f'{get_component_type(num_cpus, num_caches, num_ptws)} components;',
 
         'public:',
         f'constexpr static std::size_t num_cpus = {num_cpus};',
         f'constexpr static std::size_t block_size = {env["block_size"]};',
         f'constexpr static std::size_t page_size = {env["page_size"]};',
+        f'constexpr static std::string_view dram_name{{"{dram_name}"}};',
 
-        'generated_environment();',
+        'explicit generated_environment(const champsim::geometry_overrides& overrides = {});',
         'std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final;',
         'std::vector<std::reference_wrapper<CACHE>> cache_view() final;',
         'std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final;',
         'MEMORY_CONTROLLER& dram_view() final;',
-        'std::vector<std::reference_wrapper<operable>> operable_view() final;'
+        'std::vector<std::reference_wrapper<operable>> operable_view() final;',
+        'long operate_on(const champsim::chrono::clock& clock) final;',
+        *(('champsim::module_registry runtime_modules() final;',) if runtime_modules else ())
     )
     struct_name = f'champsim::configured::generated_environment<0x{build_id}> final'
     yield from cxx.struct(struct_name, struct_body, superclass='champsim::environment')
@@ -293,7 +293,7 @@ class NormalizedConfiguration:
             print('P: vmem', list(self.vmem.keys()))
 
         self.root = util.subdict(config_file,
-            ('block_size', 'page_size', 'heartbeat_frequency')
+            ('block_size', 'page_size', 'heartbeat_frequency', 'runtime_modules')
         )
 
     def merge(self, rhs):
@@ -341,6 +341,12 @@ class NormalizedConfiguration:
             self.vmem,
             { 'pte_page_size': int_or_prefixed_size("4kB"), 'num_levels': 5, 'minor_fault_penalty': 200, 'randomization': 1}
         )
+        if 'large_pages' in vmem:
+            vmem = util.chain({ 'large_pages': util.chain(
+                transform_for_keys(vmem['large_pages'], ('size', 'reserved'), int_or_prefixed_size),
+                vmem['large_pages'],
+                { 'size': int_or_prefixed_size("2MB"), 'asids': [], 'ranges': [], 'promotion_threshold': 1, 'reserved': 0 }
+            )}, util.subdict(vmem, ('large_pages',), invert=True))
 
         # Give cores numeric indices and default cache names
         cores = [{'_index': i, **core_default_names(cpu)} for i,cpu in enumerate(self.cores)]
@@ -445,6 +451,7 @@ class NormalizedConfiguration:
 
         config_extern = {
             **util.subdict(root_config, ('block_size', 'page_size', 'heartbeat_frequency')),
+            'runtime_modules': bool(root_config.get('runtime_modules', False)),
             'num_cores': len(cores)
         }
 
@@ -486,14 +493,19 @@ def parse_config(*configs, module_dir=None, branch_dir=None, btb_dir=None, pref_
             print(k, v.paths)
     elements, module_info, config_file = merged_config.apply_defaults_in(**contexts, verbose=verbose)
 
+    # Sorted, so that the build id of a configuration is the same each time it is configured
     if compile_all_modules:
-        modules_to_compile = [*set(itertools.chain(*(d.keys() for d in module_info.values())))]
+        modules_to_compile = sorted(set(itertools.chain(*(d.keys() for d in module_info.values()))))
     else:
-        modules_to_compile = [*set(d['name'] for d in itertools.chain(
+        modules_to_compile = sorted(set(d['name'] for d in itertools.chain(
             *(c['_replacement_data'] for c in elements['caches']),
             *(c['_prefetcher_data'] for c in elements['caches']),
             *(c['_branch_predictor_data'] for c in elements['cores']),
             *(c['_btb_data'] for c in elements['cores'])
-        ))]
+        )))
+
+    # Every prefetcher and replacement policy must be linked for them to be selected at runtime
+    if config_file['runtime_modules']:
+        modules_to_compile = sorted(set(itertools.chain(modules_to_compile, module_info['pref'].keys(), module_info['repl'].keys())))
 
     return executable_name(*configs), elements, modules_to_compile, module_info, config_file
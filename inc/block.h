@@ -31,6 +31,7 @@ struct cache_block {
   champsim::address data{};
 
   uint32_t pf_metadata = 0;
+  champsim::address prefetch_ip{}; // the instruction whose access issued the prefetch that filled this block
 };
 } // namespace champsim
 
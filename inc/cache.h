@@ -73,6 +73,8 @@ class CACHE : public champsim::operable
     bool is_translated;
     bool translate_issued = false;
 
+    champsim::address prefetch_ip{};
+
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     champsim::chrono::clock::time_point event_cycle = champsim::chrono::clock::time_point::max();
@@ -100,6 +102,7 @@ public:
 
     access_type type;
     bool prefetch_from_this;
+    champsim::address prefetch_ip{};
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
@@ -123,6 +126,9 @@ private:
   void issue_translation(tag_lookup_type& q_entry) const;
   void dump_all_addrs() const;
 
+  // Tell the replacement policy of a valid block, as if it had just been filled
+  void replay_fill(long set, long way, const champsim::cache_block& blk) const;
+
 public:
   using BLOCK = champsim::cache_block;
 
@@ -150,6 +156,10 @@ private:
   std::deque<tag_lookup_type> inflight_tag_check{};
   std::deque<tag_lookup_type> translation_stash{};
 
+  // The instruction whose access is being shown to the prefetcher, so that the prefetches it issues can be attributed to it.
+  // It is empty outside of an access, such as in the prefetcher's cycle and fill hooks.
+  champsim::address prefetch_trigger_ip{};
+
 public:
   std::vector<channel_type*> upper_levels;
   channel_type* lower_level;
@@ -168,6 +178,7 @@ public:
   bool match_offset_bits;
   bool virtual_prefetch;
   std::vector<access_type> pref_activate_mask;
+  std::size_t ip_attribution_size;
 
   using stats_type = cache_stats;
 
@@ -234,6 +245,10 @@ public:
   struct prefetcher_module_concept {
     virtual ~prefetcher_module_concept() = default;
 
+    // Whether any of the prefetchers has the hook. The cache does not call a hook that none of them has.
+    bool calls_cycle_operate = true;
+    bool calls_branch_operate = true;
+
     virtual void bind(CACHE* cache) = 0;
 
     virtual void impl_prefetcher_initialize() = 0;
@@ -264,7 +279,15 @@ public:
   template <typename... Ps>
   struct prefetcher_module_model final : prefetcher_module_concept {
     std::tuple<Ps...> intern_;
-    explicit prefetcher_module_model(CACHE* cache) : intern_(Ps{cache}...) { (void)cache; /* silence -Wunused-but-set-parameter when sizeof...(Ps) == 0 */ }
+    explicit prefetcher_module_model(CACHE* cache) : intern_(Ps{cache}...)
+    {
+      (void)cache; /* silence -Wunused-but-set-parameter when sizeof...(Ps) == 0 */
+      using champsim::modules::prefetcher;
+      calls_cycle_operate = (false || ... || prefetcher::has_cycle_operate<Ps&>);
+      calls_branch_operate = (false || ... ||
+                              (prefetcher::has_branch_operate<Ps&, champsim::address, uint8_t, champsim::address>
+                               || prefetcher::has_branch_operate<Ps&, uint64_t, uint8_t, uint64_t>));
+    }
     void bind(CACHE* cache)
     {
       std::apply([cache = cache](auto&... p) { (..., p.bind(cache)); }, intern_);
@@ -305,6 +328,18 @@ public:
   std::unique_ptr<prefetcher_module_concept> pref_module_pimpl;
   std::unique_ptr<replacement_module_concept> repl_module_pimpl;
 
+  /**
+   * Replace the prefetcher of a cache that has already been initialized, and initialize the new one.
+   * Prefetches already in flight complete, and their fills are reported to the new prefetcher.
+   */
+  void switch_prefetcher(std::unique_ptr<prefetcher_module_concept> pref);
+
+  /**
+   * Replace the replacement policy of a cache that has already been initialized, keeping the contents of the cache.
+   * The new policy is initialized, then told of every valid block as a fill, in the same way as when a checkpoint is restored.
+   */
+  void switch_replacement(std::unique_ptr<replacement_module_concept> repl);
+
   // NOLINTBEGIN(readability-make-member-function-const): legacy modules use non-const hooks
   void impl_prefetcher_initialize() const;
   [[nodiscard]] uint32_t impl_prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool cache_hit, bool useful_prefetch, access_type type,
@@ -331,6 +366,7 @@ public:
         NUM_WAY(b.get_num_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
         FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
         prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
+        ip_attribution_size(b.m_ip_attribution_size),
         pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)), repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
   {
   }
@@ -57,6 +57,7 @@ struct cache_builder_base {
   bool m_pref_load{};
   bool m_wq_full_addr{};
   bool m_va_pref{};
+  std::size_t m_ip_attribution_size{};
 
   std::vector<access_type> m_pref_act_mask{access_type::LOAD, access_type::PREFETCH};
   std::vector<champsim::channel*> m_uls{};
@@ -212,6 +213,12 @@ public:
    */
   self_type& reset_virtual_prefetch();
 
+  /**
+   * Specify how many instruction addresses to attribute misses and prefetches to.
+   * If this is zero, which is the default, no attribution is done.
+   */
+  self_type& ip_attribution(std::size_t ip_attribution_size_);
+
   /**
    * Specify the ``access_type`` values that should activate the prefetcher.
    */
@@ -485,6 +492,13 @@ auto champsim::cache_builder<P, R>::reset_virtual_prefetch() -> self_type&
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::ip_attribution(std::size_t ip_attribution_size_) -> self_type&
+{
+  m_ip_attribution_size = ip_attribution_size_;
+  return *this;
+}
+
 template <typename P, typename R>
 template <typename... Elems>
 auto champsim::cache_builder<P, R>::prefetch_activate(Elems... pref_act_elems) -> self_type&
@@ -8,6 +8,9 @@
 
 #include "channel.h"
 #include "event_counter.h"
+#include "ip_attribution.h"
+#include "latency_histogram.h"
+#include "util/to_underlying.h"
 
 struct cache_stats {
   std::string name;
@@ -18,12 +21,17 @@ struct cache_stats {
   uint64_t pf_useless = 0;
   uint64_t pf_fill = 0;
 
-  champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> hits = {};
-  champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> misses = {};
-  champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_merge = {};
-  champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_return = {};
+  using counter_type = champsim::stats::dense_event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>,
+                                                            champsim::to_underlying(access_type::NUM_TYPES)>;
+  counter_type hits = {};
+  counter_type misses = {};
+  counter_type mshr_merge = {};
+  counter_type mshr_return = {};
 
   long total_miss_latency_cycles{};
+  champsim::stats::latency_histogram miss_latency{};
+
+  champsim::stats::ip_attribution top_ips{};
 };
 
 cache_stats operator-(cache_stats lhs, cache_stats rhs);
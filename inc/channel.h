@@ -21,7 +21,9 @@
 #include <cstdint>
 #include <deque>
 #include <limits>
+#include <optional>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "access_type.h"
@@ -86,6 +88,25 @@ class channel
   template <typename R>
   bool do_add_queue(R& queue, std::size_t queue_size, const typename R::value_type& packet);
 
+  // The block addresses of the entries that have passed check_collision(), which are always a prefix of their queue.
+  // Entries only leave a queue from the front, so the index is brought up to date by dropping its oldest keys.
+  class collision_index
+  {
+    std::deque<uint64_t> keys{};
+    std::unordered_map<uint64_t, std::vector<uint64_t>> sequences{};
+    uint64_t next_sequence = 0;
+
+  public:
+    void trim(std::size_t count);
+    void push(uint64_t key);
+    [[nodiscard]] std::optional<std::size_t> find(uint64_t key) const;
+  };
+
+  template <typename R>
+  static typename R::iterator sync_collision_index(R& queue, collision_index& index);
+
+  collision_index RQ_index{}, PQ_index{}, WQ_index{};
+
   std::size_t RQ_SIZE = std::numeric_limits<std::size_t>::max();
   std::size_t PQ_SIZE = std::numeric_limits<std::size_t>::max();
   std::size_t WQ_SIZE = std::numeric_limits<std::size_t>::max();
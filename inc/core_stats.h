@@ -6,6 +6,7 @@
 
 #include "event_counter.h"
 #include "instruction.h"
+#include "util/to_underlying.h"
 
 struct cpu_stats {
   std::string name;
@@ -15,8 +16,10 @@ struct cpu_stats {
   long long end_cycles = 0;
   uint64_t total_rob_occupancy_at_branch_mispredict = 0;
 
-  champsim::stats::event_counter<branch_type> total_branch_types = {};
-  champsim::stats::event_counter<branch_type> branch_type_misses = {};
+  // Every branch_type, including NOT_BRANCH, has a count
+  using counter_type = champsim::stats::dense_event_counter<branch_type, champsim::to_underlying(NOT_BRANCH) + 1>;
+  counter_type total_branch_types = {};
+  counter_type branch_type_misses = {};
 
   [[nodiscard]] auto instrs() const { return end_instrs - begin_instrs; }
   [[nodiscard]] auto cycles() const { return end_cycles - begin_cycles; }
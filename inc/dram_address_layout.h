@@ -0,0 +1,223 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DRAM_ADDRESS_LAYOUT_H
+#define DRAM_ADDRESS_LAYOUT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "msl/bits.h"
+
+namespace champsim
+{
+/**
+ * The fields of one decoded DRAM address
+ */
+struct dram_address_fields {
+  unsigned long channel = 0;
+  unsigned long rank = 0;
+  unsigned long bankgroup = 0;
+  unsigned long bank = 0;
+  unsigned long row = 0;
+  unsigned long column = 0;
+};
+
+/**
+ * The positions of the DRAM address fields, reduced to shifts and masks so that an address can be decoded without the extent machinery.
+ *
+ * The fields are laid out contiguously from the least-significant bit, in the same order as DRAM_ADDRESS_MAPPING::address_slicer.
+ * The channel, bankgroup, and bank are permuted with the row bits exactly as DRAM_ADDRESS_MAPPING::swizzle_bits() does.
+ */
+struct dram_address_layout {
+  constexpr static std::size_t OFFSET_IDX = 0;
+  constexpr static std::size_t CHANNEL_IDX = 1;
+  constexpr static std::size_t BANKGROUP_IDX = 2;
+  constexpr static std::size_t BANK_IDX = 3;
+  constexpr static std::size_t COLUMN_IDX = 4;
+  constexpr static std::size_t RANK_IDX = 5;
+  constexpr static std::size_t ROW_IDX = 6;
+  constexpr static std::size_t NUM_FIELDS = 7;
+
+  struct field {
+    unsigned shift = 0;
+    unsigned width = 0;
+    uint64_t mask = 0;
+  };
+
+  // Row bits are taken in windows of `stride` bits, and the `width` bits at `offset` within each window are XOR'd into the field
+  struct swizzle {
+    unsigned stride = 0;
+    unsigned offset = 0;
+    unsigned windows = 0;
+    uint64_t mask = 0;
+  };
+
+  std::array<field, NUM_FIELDS> fields{};
+  swizzle channel_swizzle{};
+  swizzle bankgroup_swizzle{};
+  swizzle bank_swizzle{};
+
+  friend constexpr bool operator==(const field& lhs, const field& rhs) { return lhs.shift == rhs.shift && lhs.width == rhs.width && lhs.mask == rhs.mask; }
+  friend constexpr bool operator==(const swizzle& lhs, const swizzle& rhs)
+  {
+    return lhs.stride == rhs.stride && lhs.offset == rhs.offset && lhs.windows == rhs.windows && lhs.mask == rhs.mask;
+  }
+  friend constexpr bool operator==(const dram_address_layout& lhs, const dram_address_layout& rhs)
+  {
+    for (std::size_t i = 0; i < NUM_FIELDS; ++i) {
+      if (!(lhs.fields.at(i) == rhs.fields.at(i))) {
+        return false;
+      }
+    }
+    return lhs.channel_swizzle == rhs.channel_swizzle && lhs.bankgroup_swizzle == rhs.bankgroup_swizzle && lhs.bank_swizzle == rhs.bank_swizzle;
+  }
+
+  [[nodiscard]] constexpr uint64_t extract(std::size_t idx, uint64_t addr) const
+  {
+    const auto& f = fields.at(idx);
+    return (f.width == 0) ? 0 : ((addr >> f.shift) & f.mask);
+  }
+
+  [[nodiscard]] constexpr uint64_t permute(const swizzle& s, uint64_t field_value, uint64_t row_value) const
+  {
+    for (unsigned i = 0; i < s.windows; ++i) {
+      field_value ^= (row_value >> (i * s.stride + s.offset)) & s.mask;
+    }
+    return field_value;
+  }
+
+  [[nodiscard]] constexpr unsigned long channel(uint64_t addr) const { return permute(channel_swizzle, extract(CHANNEL_IDX, addr), extract(ROW_IDX, addr)); }
+  [[nodiscard]] constexpr unsigned long bankgroup(uint64_t addr) const
+  {
+    return permute(bankgroup_swizzle, extract(BANKGROUP_IDX, addr), extract(ROW_IDX, addr));
+  }
+  [[nodiscard]] constexpr unsigned long bank(uint64_t addr) const { return permute(bank_swizzle, extract(BANK_IDX, addr), extract(ROW_IDX, addr)); }
+  [[nodiscard]] constexpr unsigned long rank(uint64_t addr) const { return extract(RANK_IDX, addr); }
+  [[nodiscard]] constexpr unsigned long row(uint64_t addr) const { return extract(ROW_IDX, addr); }
+  [[nodiscard]] constexpr unsigned long column(uint64_t addr) const { return extract(COLUMN_IDX, addr); }
+
+  [[nodiscard]] constexpr dram_address_fields decode(uint64_t addr) const
+  {
+    return {channel(addr), rank(addr), bankgroup(addr), bank(addr), row(addr), column(addr)};
+  }
+};
+
+/**
+ * Decodes addresses for a DRAM_ADDRESS_MAPPING.
+ *
+ * The function is given the layout, so that the default decode reads its shifts and masks from it at runtime.
+ * A static_dram_address_mapping supplies a function that ignores the layout and decodes with its own constants.
+ */
+struct dram_address_decoder {
+  using function_type = dram_address_fields (*)(const dram_address_layout&, uint64_t);
+
+  dram_address_layout layout{};
+  function_type function = &decode_runtime;
+
+  static dram_address_fields decode_runtime(const dram_address_layout& runtime_layout, uint64_t addr) { return runtime_layout.decode(addr); }
+
+  [[nodiscard]] dram_address_fields operator()(uint64_t addr) const { return function(layout, addr); }
+};
+
+namespace detail
+{
+constexpr uint64_t low_mask(unsigned width) { return (width >= std::numeric_limits<uint64_t>::digits) ? ~uint64_t{0} : ((uint64_t{1} << width) - 1); }
+
+/*
+ * swizzle_bits() visits windows of the row while the end of the window (counted from the bottom of the row) does not pass the upper extent of the row
+ * (counted from bit 0 of the address). Windows past the top of the row contribute nothing, so only those that overlap the row are kept.
+ */
+constexpr dram_address_layout::swizzle make_swizzle(const dram_address_layout::field& row, unsigned stride, unsigned offset, unsigned field_width)
+{
+  dram_address_layout::swizzle result{};
+  if (stride == 0 || offset >= stride) {
+    return result;
+  }
+
+  const unsigned width = std::min(field_width, stride - offset);
+  const unsigned row_upper = row.shift + row.width;
+  unsigned windows = row_upper / stride;
+  while (windows > 0 && ((windows - 1) * stride + offset) >= row.width) {
+    --windows;
+  }
+
+  result.stride = stride;
+  result.offset = offset;
+  result.windows = (width == 0) ? 0 : windows;
+  result.mask = low_mask(width);
+  return result;
+}
+} // namespace detail
+
+/**
+ * Build the layout for a geometry. Each count must be a power of two, and `column_bursts` is the number of columns divided by the prefetch size.
+ */
+constexpr dram_address_layout make_dram_address_layout(std::size_t offset_size, std::size_t channels, std::size_t bankgroups, std::size_t banks,
+                                                       std::size_t column_bursts, std::size_t ranks, std::size_t rows)
+{
+  dram_address_layout result{};
+  const std::array<std::size_t, dram_address_layout::NUM_FIELDS> sizes{offset_size, channels, bankgroups, banks, column_bursts, ranks, rows};
+
+  unsigned shift = 0;
+  for (std::size_t i = 0; i < dram_address_layout::NUM_FIELDS; ++i) {
+    const auto width = static_cast<unsigned>(msl::lg2(sizes.at(i)));
+    result.fields.at(i) = {shift, width, detail::low_mask(width)};
+    shift += width;
+  }
+
+  const auto& row = result.fields.at(dram_address_layout::ROW_IDX);
+  const auto bg_bits = result.fields.at(dram_address_layout::BANKGROUP_IDX).width;
+  const auto bk_bits = result.fields.at(dram_address_layout::BANK_IDX).width;
+  result.channel_swizzle = detail::make_swizzle(row, 1, 0, result.fields.at(dram_address_layout::CHANNEL_IDX).width);
+  result.bankgroup_swizzle = detail::make_swizzle(row, bg_bits + bk_bits, 0, bg_bits);
+  result.bank_swizzle = detail::make_swizzle(row, bg_bits + bk_bits, bg_bits, bk_bits);
+  return result;
+}
+
+/**
+ * A DRAM address mapping whose geometry is known at compile time, with parameters in the same order as the DRAM_ADDRESS_MAPPING constructor.
+ * The shifts, masks, and swizzles are constants, so each decode folds to a few shifts and masks, and the swizzle loops are unrolled.
+ * The generated environment passes this mapping's decoder to its memory controller, which uses it for every request it accepts.
+ */
+template <std::size_t CHANNEL_WIDTH, std::size_t PREFETCH_SIZE, std::size_t CHANNELS, std::size_t BANKGROUPS, std::size_t BANKS, std::size_t COLUMNS,
+          std::size_t RANKS, std::size_t ROWS>
+struct static_dram_address_mapping {
+  static_assert(msl::is_power_of_2(CHANNEL_WIDTH * PREFETCH_SIZE));
+  static_assert(msl::is_power_of_2(CHANNELS) && msl::is_power_of_2(BANKGROUPS) && msl::is_power_of_2(BANKS));
+  static_assert(msl::is_power_of_2(COLUMNS / PREFETCH_SIZE) && msl::is_power_of_2(RANKS) && msl::is_power_of_2(ROWS));
+
+  constexpr static dram_address_layout layout =
+      make_dram_address_layout(CHANNEL_WIDTH * PREFETCH_SIZE, CHANNELS, BANKGROUPS, BANKS, COLUMNS / PREFETCH_SIZE, RANKS, ROWS);
+
+  [[nodiscard]] constexpr static unsigned long channel(uint64_t addr) { return layout.channel(addr); }
+  [[nodiscard]] constexpr static unsigned long rank(uint64_t addr) { return layout.rank(addr); }
+  [[nodiscard]] constexpr static unsigned long bankgroup(uint64_t addr) { return layout.bankgroup(addr); }
+  [[nodiscard]] constexpr static unsigned long bank(uint64_t addr) { return layout.bank(addr); }
+  [[nodiscard]] constexpr static unsigned long row(uint64_t addr) { return layout.row(addr); }
+  [[nodiscard]] constexpr static unsigned long column(uint64_t addr) { return layout.column(addr); }
+
+  // The layout argument is the same as the constant one, and is ignored
+  static dram_address_fields decode(const dram_address_layout& /*unused*/, uint64_t addr) { return layout.decode(addr); }
+
+  constexpr static dram_address_decoder decoder{layout, &decode};
+};
+} // namespace champsim
+
+#endif
@@ -25,11 +25,14 @@
 #include <iterator> // for end
 #include <limits>
 #include <optional>
+#include <ostream>
 #include <string>
+#include <unordered_map>
 
 #include "address.h"
 #include "channel.h"
 #include "chrono.h"
+#include "dram_address_layout.h"
 #include "dram_stats.h"
 #include "extent_set.h"
 #include "operable.h"
@@ -47,12 +50,23 @@ struct DRAM_ADDRESS_MAPPING {
                                            champsim::dynamic_extent, champsim::dynamic_extent, champsim::dynamic_extent>;
   const slicer_type address_slicer;
 
+  // The same fields as shifts and masks, used to decode addresses on the hot path. The slicer remains the reference for the layout.
+  const champsim::dram_address_decoder decoder;
+
   const std::size_t prefetch_size;
 
   DRAM_ADDRESS_MAPPING(champsim::data::bytes channel_width, std::size_t pref_size, std::size_t channels, std::size_t bankgroups, std::size_t banks,
                        std::size_t columns, std::size_t ranks, std::size_t rows);
+  DRAM_ADDRESS_MAPPING(champsim::data::bytes channel_width, std::size_t pref_size, std::size_t channels, std::size_t bankgroups, std::size_t banks,
+                       std::size_t columns, std::size_t ranks, std::size_t rows, const champsim::dram_address_decoder& precomputed_decoder);
   static slicer_type make_slicer(champsim::data::bytes channel_width, std::size_t pref_size, std::size_t channels, std::size_t bankgroups, std::size_t banks,
                                  std::size_t columns, std::size_t ranks, std::size_t rows);
+  static champsim::dram_address_layout make_layout(const slicer_type& slicer);
+
+  /**
+   * Decode every field of the address at once. This is the decode used when a request is accepted.
+   */
+  champsim::dram_address_fields decode(champsim::address address) const { return decoder(address.to<uint64_t>()); }
 
   unsigned long get_channel(champsim::address address) const;
   unsigned long get_rank(champsim::address address) const;
@@ -107,6 +121,13 @@ struct DRAM_CHANNEL final : public champsim::operable {
     champsim::address v_address{};
     champsim::address data{};
     champsim::chrono::clock::time_point ready_time = champsim::chrono::clock::time_point::max();
+    champsim::chrono::clock::time_point time_enqueued{};
+
+    // Decoded when the request is enqueued, so that the scheduler does not slice the address every cycle
+    std::size_t bank_index = 0;
+    std::size_t bankgroup_index = 0;
+    std::size_t row = 0;
+    std::size_t column = 0;
 
     std::vector<uint64_t> instr_depend_on_me{};
     std::vector<std::deque<response_type>*> to_return{};
@@ -118,6 +139,16 @@ struct DRAM_CHANNEL final : public champsim::operable {
   queue_type WQ;
   queue_type RQ;
 
+  // For each bank, the queue indices of the requests that have not been scheduled, ordered by scheduling priority
+  using ready_queue_type = std::vector<std::vector<std::size_t>>;
+  ready_queue_type WQ_ready;
+  ready_queue_type RQ_ready;
+
+  // For each block address, the queue indices of the valid requests to that block, in queue order
+  using block_index_type = std::unordered_map<uint64_t, std::vector<std::size_t>>;
+  block_index_type WQ_blocks;
+  block_index_type RQ_blocks;
+
   /*
    * | row address | rank index | column address | bank index | channel | block
    * offset |
@@ -145,6 +176,7 @@ struct DRAM_CHANNEL final : public champsim::operable {
 
   std::size_t bank_request_index(champsim::address addr) const;
   std::size_t bankgroup_request_index(champsim::address addr) const;
+  std::size_t bankgroup_request_index(const champsim::dram_address_fields& fields) const;
 
   bool write_mode = false;
   champsim::chrono::clock::time_point dbus_cycle_available{};
@@ -153,6 +185,11 @@ struct DRAM_CHANNEL final : public champsim::operable {
   champsim::chrono::clock::time_point last_refresh{};
   std::size_t DRAM_ROWS_PER_REFRESH;
 
+  // The earliest time at which operate() has work to do. Until then, the memory controller does not operate the channel, and the only progress is from the
+  // banks under refresh.
+  champsim::chrono::clock::time_point next_event{};
+  long idle_progress = 0;
+
   using stats_type = dram_stats;
   stats_type roi_stats, sim_stats;
 
@@ -166,6 +203,9 @@ struct DRAM_CHANNEL final : public champsim::operable {
                std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::size_t refreshes_per_period, champsim::data::bytes width,
                std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapping);
 
+  bool add_rq(const request_type& packet);
+  bool add_wq(const request_type& packet);
+
   void check_write_collision();
   void check_read_collision();
   long finish_dbus_request();
@@ -174,6 +214,16 @@ struct DRAM_CHANNEL final : public champsim::operable {
   long populate_dbus();
   DRAM_CHANNEL::queue_type::iterator schedule_packet();
   long service_packet(DRAM_CHANNEL::queue_type::iterator pkt);
+  void schedule_next_event(bool swapped_mode);
+
+  bool enqueue(queue_type& queue, const request_type& packet);
+  ready_queue_type& ready_queue_for(const queue_type& queue);
+  void mark_ready(queue_type& queue, std::size_t index);
+  void unmark_ready(queue_type& queue, std::size_t index);
+  queue_type& queue_containing(queue_type::const_iterator pkt);
+  block_index_type& block_index_for(const queue_type& queue);
+  [[nodiscard]] uint64_t block_key(champsim::address addr) const;
+  void release(queue_type& queue, std::size_t index);
 
   void initialize() final;
   long operate() final;
@@ -184,6 +234,7 @@ struct DRAM_CHANNEL final : public champsim::operable {
   std::size_t bank_request_capacity() const;
   std::size_t bankgroup_request_capacity() const;
   [[nodiscard]] champsim::data::bytes density() const;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const;
 };
 
 class MEMORY_CONTROLLER : public champsim::operable
@@ -195,6 +246,9 @@ class MEMORY_CONTROLLER : public champsim::operable
   const champsim::data::bytes channel_width;
   bool verbose = false;
 
+  // Whether channels are left unoperated until their next event. The results are the same either way.
+  bool skip_idle_cycles = true;
+
   void initiate_requests();
   bool add_rq(const request_type& packet, champsim::channel* ul);
   bool add_wq(const request_type& packet);
@@ -204,6 +258,9 @@ class MEMORY_CONTROLLER : public champsim::operable
   // data bus period
   champsim::chrono::picoseconds data_bus_period{};
 
+  // Receives a record of each request accepted by the controller, if set
+  std::ostream* capture = nullptr;
+
 public:
   std::vector<DRAM_CHANNEL> channels;
 
@@ -212,6 +269,15 @@ public:
                     std::size_t chans, champsim::data::bytes chan_width, std::size_t rows, std::size_t columns, std::size_t ranks, std::size_t bankgroups,
                     std::size_t banks, std::size_t refreshes_per_period);
 
+  /**
+   * Construct a controller whose address decoder was built ahead of time, such as by champsim::static_dram_address_mapping.
+   * The decoder's layout must match the one the geometry would produce.
+   */
+  MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd, std::size_t t_cas,
+                    std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul, std::size_t rq_size, std::size_t wq_size,
+                    std::size_t chans, champsim::data::bytes chan_width, std::size_t rows, std::size_t columns, std::size_t ranks, std::size_t bankgroups,
+                    std::size_t banks, std::size_t refreshes_per_period, const champsim::dram_address_decoder& precomputed_decoder);
+
   void initialize() final;
   long operate() final;
   void begin_phase() final;
@@ -220,6 +286,13 @@ public:
 
   [[nodiscard]] champsim::data::bytes size() const;
   void set_verbose(bool enable) { verbose = enable; }
+  void set_idle_skipping(bool enable) { skip_idle_cycles = enable; }
+
+  /**
+   * Record each request accepted after warmup to the given stream, which begins with a header giving the block size.
+   * A null stream stops the capture.
+   */
+  void set_capture(std::ostream* stream);
   [[nodiscard]] bool is_verbose() const { return verbose; }
 };
 
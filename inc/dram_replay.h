@@ -0,0 +1,120 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DRAM_REPLAY_H
+#define DRAM_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "address.h"
+#include "chrono.h"
+#include "dram_stats.h"
+
+namespace champsim
+{
+/**
+ * A request as it arrived at the memory controller.
+ * Captured streams are written one record per line, as "<arrival in picoseconds> <R|W> <address>".
+ * They begin with a header line, "# block_size <bytes>", giving the block size of the simulator that captured them.
+ */
+struct dram_request_record {
+  champsim::chrono::picoseconds arrival{};
+  bool is_write = false;
+  champsim::address address{};
+};
+
+struct dram_capture {
+  // The block size the stream was captured with, or zero if the stream has no header
+  std::size_t block_size = 0;
+  std::vector<dram_request_record> records{};
+};
+
+void write_dram_capture_header(std::ostream& stream, std::size_t block_size);
+void write_dram_record(std::ostream& stream, const dram_request_record& record);
+
+/**
+ * Read a captured stream. Lines beginning with '#' are header lines, and unrecognized ones are ignored.
+ *
+ * \throws std::invalid_argument if a record is malformed
+ */
+dram_capture read_dram_capture(std::istream& stream);
+std::vector<dram_request_record> read_dram_records(std::istream& stream);
+
+/**
+ * The parameters of a memory controller, with the same names, units, and defaults as the "physical_memory" section of the configuration.
+ */
+struct dram_replay_config {
+  std::string name{"DRAM"};
+  long data_rate = 3200;
+  long frequency = 1600;
+  std::size_t channels = 1;
+  std::size_t ranks = 1;
+  std::size_t bankgroups = 8;
+  std::size_t banks = 4;
+  std::size_t bank_rows = 65536;
+  std::size_t bank_columns = 1024;
+  long long channel_width = 8;
+  std::size_t wq_size = 64;
+  std::size_t rq_size = 64;
+  std::size_t tRP = 24;
+  std::size_t tRCD = 24;
+  std::size_t tCAS = 24;
+  std::size_t tRAS = 52;
+  long refresh_period = 32;
+  std::size_t refreshes_per_period = 8192;
+
+  // The top-level "block_size" of the configuration. It must match the block size the replay is built with.
+  std::size_t block_size = 64;
+};
+
+struct dram_replay_options {
+  // In closed-loop replay, each request keeps its recorded gap to the previous request, but waits while max_outstanding reads are in flight.
+  bool closed_loop = false;
+  std::size_t max_outstanding = 16;
+};
+
+struct dram_replay_result {
+  std::string name{};
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+  champsim::chrono::picoseconds elapsed{};
+
+  // Read latencies, from when the request is offered to the memory controller until its response returns
+  champsim::chrono::picoseconds mean_latency{};
+  champsim::chrono::picoseconds p50_latency{};
+  champsim::chrono::picoseconds p95_latency{};
+  champsim::chrono::picoseconds p99_latency{};
+  champsim::chrono::picoseconds max_latency{};
+
+  std::vector<dram_stats> channel_stats{};
+
+  [[nodiscard]] double bandwidth_gbps() const;
+};
+
+/**
+ * Replay a request stream against a memory controller with the given configuration.
+ *
+ * \throws std::invalid_argument if the configured block size differs from BLOCK_SIZE
+ */
+dram_replay_result replay_dram(const std::vector<dram_request_record>& records, const dram_replay_config& config, const dram_replay_options& options);
+} // namespace champsim
+
+#endif
@@ -4,12 +4,17 @@
 #include <cstdint>
 #include <string>
 
+#include "latency_histogram.h"
+
 struct dram_stats {
   std::string name{};
   long dbus_cycle_congested{};
   uint64_t dbus_count_congested = 0;
   uint64_t refresh_cycles = 0;
   unsigned WQ_ROW_BUFFER_HIT = 0, WQ_ROW_BUFFER_MISS = 0, RQ_ROW_BUFFER_HIT = 0, RQ_ROW_BUFFER_MISS = 0, WQ_FULL = 0;
+
+  // Cycles from when a read enters the read queue until its data returns
+  champsim::stats::latency_histogram read_latency{};
 };
 
 dram_stats operator-(dram_stats lhs, dram_stats rhs);
@@ -17,11 +17,16 @@
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
 
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "cache.h"
 #include "dram_controller.h"
+#include "module_registry.h"
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "ptw.h"
@@ -34,8 +39,37 @@ struct environment {
   virtual std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() = 0;
   virtual MEMORY_CONTROLLER& dram_view() = 0;
   virtual std::vector<std::reference_wrapper<operable>> operable_view() = 0;
+
+  /**
+   * Advance every component to the time of the clock, with the components that are furthest behind operating first.
+   */
+  virtual long operate_on(const champsim::chrono::clock& clock);
+
+  /**
+   * The modules that can be chosen for the caches before the simulation starts. This is empty unless the configuration sets
+   * ``"runtime_modules": true``.
+   */
+  virtual module_registry runtime_modules() { return {}; }
 };
 
+namespace detail
+{
+template <typename It, std::size_t... Is>
+auto tie_front(It first, std::index_sequence<Is...>)
+{
+  return std::tie(*std::next(first, Is)...);
+}
+} // namespace detail
+
+/**
+ * A tuple of references to the first N elements of a range
+ */
+template <std::size_t N, typename R>
+auto tie_front(R& range)
+{
+  return detail::tie_front(std::begin(range), std::make_index_sequence<N>{});
+}
+
 namespace configured
 {
 template <unsigned long long ID>
@@ -2,11 +2,18 @@
 #define EVENT_COUNTER_H
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstdint>
+#include <functional>
 #include <numeric>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "util/to_underlying.h"
+#include "util/type_traits.h"
+
 namespace champsim::stats
 {
 template <typename Key>
@@ -110,6 +117,152 @@ public:
     return lhs;
   }
 };
+
+/**
+ * An event counter for small, dense key spaces: an enumeration with Extent values, or a pair of such an enumeration and an index, such as a CPU.
+ *
+ * The counts are held in a flat array for each index, so that an increment is a single indexed add. An index is allocated when any of its keys
+ * is first counted, and an allocated index holds a count for every value of the enumeration.
+ */
+template <typename Key, std::size_t Extent>
+class dense_event_counter
+{
+public:
+  using key_type = std::remove_cv_t<Key>;
+  using value_type = long;
+
+private:
+  constexpr static bool is_indexed = champsim::is_specialization_v<key_type, std::pair>;
+
+  struct row_type {
+    bool allocated = false;
+    std::array<value_type, Extent> values{};
+  };
+
+  std::vector<row_type> rows{};
+
+  static std::pair<std::size_t, std::size_t> position(key_type key)
+  {
+    if constexpr (is_indexed) {
+      return {static_cast<std::size_t>(key.second), static_cast<std::size_t>(champsim::to_underlying(key.first))};
+    } else {
+      return {0, static_cast<std::size_t>(champsim::to_underlying(key))};
+    }
+  }
+
+  static key_type key_at(std::size_t row, std::size_t column)
+  {
+    if constexpr (is_indexed) {
+      return {static_cast<typename key_type::first_type>(column), static_cast<typename key_type::second_type>(row)};
+    } else {
+      return static_cast<key_type>(column);
+    }
+  }
+
+  const row_type* find_row(std::size_t row) const
+  {
+    if (row < std::size(rows) && rows[row].allocated) {
+      return &rows[row];
+    }
+    return nullptr;
+  }
+
+  row_type& allocate_row(std::size_t row)
+  {
+    if (row >= std::size(rows)) {
+      rows.resize(row + 1);
+    }
+    rows[row].allocated = true;
+    return rows[row];
+  }
+
+public:
+  void allocate(key_type key) { allocate_row(position(key).first); }
+
+  void increment(key_type key)
+  {
+    auto [row, column] = position(key);
+    assert(column < Extent);
+    if (row < std::size(rows) && rows[row].allocated) {
+      ++rows[row].values[column];
+    } else {
+      ++allocate_row(row).values[column];
+    }
+  }
+
+  void set(key_type key, value_type val)
+  {
+    auto [row, column] = position(key);
+    allocate_row(row).values.at(column) = val;
+  }
+
+  auto at(key_type key) const
+  {
+    auto [row, column] = position(key);
+    return rows.at(row).values.at(column);
+  }
+
+  auto value_or(key_type key, value_type val) const
+  {
+    auto [row, column] = position(key);
+    if (const auto* found = find_row(row); found != nullptr && column < Extent) {
+      return found->values[column];
+    }
+    return val;
+  }
+
+  auto total() const
+  {
+    return std::accumulate(std::begin(rows), std::end(rows), value_type{},
+                           [](auto acc, const auto& row) { return std::accumulate(std::begin(row.values), std::end(row.values), acc); });
+  }
+
+  std::vector<key_type> get_keys() const
+  {
+    std::vector<key_type> keys;
+    for (std::size_t row = 0; row < std::size(rows); ++row) {
+      if (rows[row].allocated) {
+        for (std::size_t column = 0; column < Extent; ++column) {
+          keys.push_back(key_at(row, column));
+        }
+      }
+    }
+    std::sort(std::begin(keys), std::end(keys));
+    return keys;
+  }
+
+  dense_event_counter<key_type, Extent>& operator+=(const dense_event_counter<key_type, Extent>& rhs)
+  {
+    for (std::size_t row = 0; row < std::size(rows); ++row) {
+      if (const auto* other = rhs.find_row(row); rows[row].allocated && other != nullptr) {
+        std::transform(std::begin(rows[row].values), std::end(rows[row].values), std::begin(other->values), std::begin(rows[row].values), std::plus<>{});
+      }
+    }
+    return *this;
+  }
+
+  friend auto operator+(dense_event_counter<key_type, Extent> lhs, const dense_event_counter<key_type, Extent>& rhs)
+  {
+    lhs += rhs;
+    return lhs;
+  }
+
+  dense_event_counter<key_type, Extent>& operator-=(const dense_event_counter<key_type, Extent>& rhs)
+  {
+    for (std::size_t row = 0; row < std::size(rows); ++row) {
+      if (const auto* other = rhs.find_row(row); rows[row].allocated && other != nullptr) {
+        std::transform(std::begin(rows[row].values), std::end(rows[row].values), std::begin(other->values), std::begin(rows[row].values), std::minus<>{});
+      }
+    }
+    return *this;
+  }
+
+  friend auto operator-(dense_event_counter<key_type, Extent> lhs, const dense_event_counter<key_type, Extent>& rhs)
+  {
+    lhs -= rhs;
+    return lhs;
+  }
+};
 } // namespace champsim::stats
 
 #endif
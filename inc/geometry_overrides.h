@@ -0,0 +1,103 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GEOMETRY_OVERRIDES_H
+#define GEOMETRY_OVERRIDES_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bandwidth.h"
+#include "cache_builder.h"
+#include "core_builder.h"
+
+namespace champsim
+{
+struct environment;
+
+/**
+ * Parameters of the caches, cores, and memory controller that replace the configured ones when the environment is constructed.
+ *
+ * An override names a component and one of its parameters, for example ``LLC.sets=4096``. A component is named as in
+ * select_modules(): a cache by its name, or by its kind for each core's cache of that kind (``L2C`` matches ``cpu0_L2C``, ``cpu1_L2C``,
+ * and so on). A core is named ``cpu0``, ``cpu1``, and so on, or ``ooo_cpu`` for every core, and the memory controller is named as in
+ * the configuration (``DRAM`` by default).
+ *
+ * The number of cores, the block size, and the page size are constants of the build and cannot be overridden.
+ */
+class geometry_overrides
+{
+  struct assignment {
+    std::string component;
+    std::string parameter;
+    uint64_t value;
+  };
+
+  std::vector<assignment> assignments{};
+
+  void apply_to(const std::string& name, detail::cache_builder_base& builder) const;
+  void apply_to(const std::string& name, detail::core_builder_base& builder) const;
+
+public:
+  /**
+   * Add an override in the form ``COMPONENT.PARAMETER=VALUE``. Later overrides of the same parameter take precedence.
+   *
+   * \throws std::invalid_argument If the override is malformed, or no component has the parameter
+   */
+  void add(const std::string& override_string);
+
+  /**
+   * Add each override in a JSON object keyed by component, in the same form as the sections of a configuration file, for example
+   * ``{"LLC": {"sets": 4096}, "ooo_cpu": {"rob_size": 512}}``.
+   *
+   * \throws std::invalid_argument If the object is malformed, or no component has one of the parameters
+   */
+  void add_json(const std::string& overrides_json);
+
+  [[nodiscard]] bool empty() const { return assignments.empty(); }
+
+  template <typename P, typename R>
+  cache_builder<P, R> apply(const std::string& name, cache_builder<P, R> builder) const
+  {
+    apply_to(name, builder);
+    return builder;
+  }
+
+  template <typename B, typename T>
+  core_builder<B, T> apply(const std::string& name, core_builder<B, T> builder) const
+  {
+    apply_to(name, builder);
+    return builder;
+  }
+
+  /**
+   * The value of a parameter of a component that is not made with a builder.
+   */
+  [[nodiscard]] uint64_t value(const std::string& component, const std::string& parameter, uint64_t configured) const;
+
+  /**
+   * Check that each override names a component of the environment, and a parameter that the component has.
+   * The memory controller is named by dram_name, its name in the configuration.
+   *
+   * \throws std::invalid_argument If an override was not applied
+   */
+  void validate(environment& env, std::string_view dram_name) const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_COUNTERS_H
+#define HOST_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace champsim
+{
+/**
+ * Hardware event counts from the host, as read from a perf_counter_group
+ */
+struct host_counter_values {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;
+  uint64_t branch_misses = 0;
+
+  host_counter_values& operator+=(const host_counter_values& rhs)
+  {
+    cycles += rhs.cycles;
+    instructions += rhs.instructions;
+    llc_misses += rhs.llc_misses;
+    branch_misses += rhs.branch_misses;
+    return *this;
+  }
+
+  host_counter_values& operator-=(const host_counter_values& rhs)
+  {
+    cycles -= rhs.cycles;
+    instructions -= rhs.instructions;
+    llc_misses -= rhs.llc_misses;
+    branch_misses -= rhs.branch_misses;
+    return *this;
+  }
+
+  friend host_counter_values operator+(host_counter_values lhs, const host_counter_values& rhs) { return lhs += rhs; }
+  friend host_counter_values operator-(host_counter_values lhs, const host_counter_values& rhs) { return lhs -= rhs; }
+};
+
+/**
+ * A group of Linux perf events counting the simulator thread in user mode.
+ *
+ * The group starts closed, and reads return zeros. If the host does not permit perf events (for example, if perf_event_paranoid forbids them or the
+ * simulator runs in a container without them), open() fails and the group stays closed. Events that the host does not support are left out of the group
+ * and read as zero.
+ */
+class perf_counter_group
+{
+  constexpr static std::size_t NUM_EVENTS = 4;
+
+  std::array<int, NUM_EVENTS> fds{{-1, -1, -1, -1}};
+  std::array<std::size_t, NUM_EVENTS> positions{}; // position of each event in the group read, if it is open
+  std::size_t num_open = 0;
+
+public:
+  perf_counter_group() = default;
+  perf_counter_group(const perf_counter_group&) = delete;
+  perf_counter_group& operator=(const perf_counter_group&) = delete;
+  ~perf_counter_group();
+
+  /**
+   * The group used by the host_time_sampler
+   */
+  static perf_counter_group& instance();
+
+  /**
+   * Open and start the counters.
+   *
+   * :returns: An empty string on success, or a description of why the counters are unavailable.
+   */
+  std::string open();
+  void close();
+
+  [[nodiscard]] bool is_open() const { return num_open > 0; }
+  [[nodiscard]] host_counter_values read() const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_PROFILE_H
+#define HOST_PROFILE_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "host_counters.h"
+
+namespace champsim
+{
+/**
+ * Estimates the host time spent in a function by timing one call in every `period` and scaling up.
+ *
+ * Unsampled calls cost an increment and a comparison. Two samplers whose calls are made in lockstep take their samples on the same calls.
+ * If the shared perf_counter_group is open, the sampled calls are also counted with the host's hardware counters.
+ */
+class host_time_sampler
+{
+public:
+  using clock_type = std::chrono::steady_clock;
+  constexpr static uint64_t period = 64;
+
+  uint64_t calls = 0;
+  uint64_t samples = 0;
+  clock_type::duration sampled{};
+  host_counter_values counted{};
+
+  template <typename F>
+  auto measure(F&& func)
+  {
+    if ((++calls % period) != 0) {
+      return func();
+    }
+
+    const auto& counters = perf_counter_group::instance();
+    const auto start_counts = counters.read();
+    const auto start = clock_type::now();
+    auto result = func();
+    sampled += clock_type::now() - start;
+    counted += counters.read() - start_counts;
+    ++samples;
+    return result;
+  }
+
+  [[nodiscard]] std::chrono::duration<double> estimate() const
+  {
+    if (samples == 0) {
+      return std::chrono::duration<double>{};
+    }
+    return std::chrono::duration<double>{sampled} * (static_cast<double>(calls) / static_cast<double>(samples));
+  }
+
+  [[nodiscard]] host_counter_values estimate_counts() const
+  {
+    if (samples == 0) {
+      return host_counter_values{};
+    }
+    auto scale = [ratio = static_cast<double>(calls) / static_cast<double>(samples)](uint64_t x) {
+      return static_cast<uint64_t>(static_cast<double>(x) * ratio);
+    };
+    return {scale(counted.cycles), scale(counted.instructions), scale(counted.llc_misses), scale(counted.branch_misses)};
+  }
+
+  friend host_time_sampler operator-(host_time_sampler lhs, const host_time_sampler& rhs)
+  {
+    lhs.calls -= rhs.calls;
+    lhs.samples -= rhs.samples;
+    lhs.sampled -= rhs.sampled;
+    lhs.counted -= rhs.counted;
+    return lhs;
+  }
+};
+
+struct host_profile_component {
+  std::string name{};
+  std::chrono::duration<double> time{};
+  host_counter_values counters{};
+};
+
+/**
+ * Estimate the host time and events of an outer component, less those of the inner components that it calls.
+ *
+ * The inner components need not be called in lockstep with the outer one, so each sampler is scaled to its own calls before they are subtracted.
+ * Sampling noise can make the inner estimates exceed the outer one, so each difference is clamped at zero.
+ */
+template <typename It>
+host_profile_component exclusive_host_profile(std::string name, const host_time_sampler& outer, It inner_begin, It inner_end)
+{
+  auto time = outer.estimate();
+  auto counts = outer.estimate_counts();
+  auto saturating_sub = [](uint64_t x, uint64_t y) { return x - std::min(x, y); };
+  for (auto it = inner_begin; it != inner_end; ++it) {
+    const host_time_sampler& inner = *it;
+    time = std::max(time - inner.estimate(), std::chrono::duration<double>{});
+    auto inner_counts = inner.estimate_counts();
+    counts = {saturating_sub(counts.cycles, inner_counts.cycles), saturating_sub(counts.instructions, inner_counts.instructions),
+              saturating_sub(counts.llc_misses, inner_counts.llc_misses), saturating_sub(counts.branch_misses, inner_counts.branch_misses)};
+  }
+  return host_profile_component{std::move(name), time, counts};
+}
+
+/**
+ * Where the host spent its time during a phase
+ */
+struct host_profile_stats {
+  std::chrono::duration<double> elapsed{};
+  long long instructions = 0;
+  bool counters_available = false;
+  std::vector<host_profile_component> components{};
+
+  [[nodiscard]] double kips() const { return (elapsed.count() > 0) ? static_cast<double>(instructions) / elapsed.count() / 1000.0 : 0.0; }
+};
+} // namespace champsim
+
+#endif
@@ -17,9 +17,12 @@
 #ifndef INF_STREAM_H
 #define INF_STREAM_H
 
+#include <array>
 #include <bzlib.h>
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <lzma.h>
 #include <memory>
 #include <zlib.h>
@@ -52,11 +55,11 @@ struct bzip2_tag_t {
 
   static status_type deflate(deflate_state_type& x, bool flush)
   {
-    auto ret = ::BZ2_bzCompress(x.get(), flush ? BZ_FLUSH : BZ_RUN);
-    if (ret == BZ_RUN_OK) {
+    auto ret = ::BZ2_bzCompress(x.get(), flush ? BZ_FINISH : BZ_RUN);
+    if (ret == BZ_RUN_OK || ret == BZ_FINISH_OK) {
       return status_type::CAN_CONTINUE;
     }
-    if (ret == BZ_FLUSH_OK) {
+    if (ret == BZ_STREAM_END) {
       return status_type::END;
     }
     return status_type::ERROR;
@@ -116,7 +119,7 @@ struct gzip_tag_t {
   {
     deflate_state_type state{new state_type};
     *state = state_type{Z_NULL, 0, 0, Z_NULL, 0, 0, NULL, NULL, Z_NULL, Z_NULL, Z_NULL, 0, 0UL, 0UL};
-    ::deflateInit(state.get(), compression);
+    ::deflateInit2(state.get(), compression, Z_DEFLATED, window, 8, Z_DEFAULT_STRATEGY);
     return state;
   }
 
@@ -140,7 +143,7 @@ struct lzma_tag_t {
 
   static status_type deflate(deflate_state_type& x, bool flush)
   {
-    auto ret = ::lzma_code(x.get(), flush ? LZMA_FULL_FLUSH : LZMA_RUN);
+    auto ret = ::lzma_code(x.get(), flush ? LZMA_FINISH : LZMA_RUN);
     if (ret == LZMA_OK) {
       return status_type::CAN_CONTINUE;
     } else if (ret == LZMA_STREAM_END) {
@@ -283,6 +286,67 @@ auto inf_istream<T, S>::inf_streambuf<I>::underflow() -> int_type
              std::next(this->out_buf.data(), static_cast<std::make_signed_t<decltype(bytes_remaining)>>(bytes_remaining)));
   return base_type::traits_type::to_int_type(this->out_buf.front());
 }
+
+/**
+ * A stream that compresses everything written to it into the underlying stream.
+ * The compressed stream is finished when this stream is closed or destroyed.
+ */
+template <typename Tag, typename StreamType = std::ofstream>
+struct def_ostream {
+  using strm_in_buf_type = typename Tag::in_char_type;
+  using strm_out_buf_type = typename Tag::out_char_type;
+
+  constexpr static std::size_t CHUNK = (1 << 16);
+
+  std::unique_ptr<StreamType> underlying;
+  typename Tag::deflate_state_type strm = Tag::new_deflate_state();
+
+  def_ostream& write(const char* s, std::streamsize count)
+  {
+    assert(count >= 0);
+    // The compression libraries do not modify their input, but only some of them declare it const
+    strm->next_in = reinterpret_cast<strm_in_buf_type*>(const_cast<char*>(s)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-type-const-cast)
+    strm->avail_in = static_cast<decltype(strm->avail_in)>(count);
+    while (strm->avail_in > 0) {
+      [[maybe_unused]] auto result = deflate_chunk(false);
+      assert(result == Tag::status_type::CAN_CONTINUE);
+    }
+    return *this;
+  }
+
+  void close()
+  {
+    if (strm) {
+      while (deflate_chunk(true) == Tag::status_type::CAN_CONTINUE) {
+      }
+      strm.reset();
+      underlying->flush();
+    }
+  }
+
+  [[nodiscard]] bool fail() const { return underlying->fail(); }
+
+  explicit def_ostream(std::string s) : underlying(std::make_unique<StreamType>(s, std::ios::binary)) {}
+  explicit def_ostream(StreamType&& str) : underlying(std::make_unique<StreamType>(std::move(str))) {}
+  def_ostream(def_ostream&&) noexcept = default;
+  def_ostream& operator=(def_ostream&&) noexcept = default;
+  ~def_ostream() { close(); }
+
+private:
+  typename Tag::status_type deflate_chunk(bool flush)
+  {
+    std::array<strm_out_buf_type, CHUNK> out_buf;
+    strm->next_out = out_buf.data();
+    strm->avail_out = static_cast<decltype(strm->avail_out)>(out_buf.size());
+    auto result = Tag::deflate(strm, flush);
+    assert(result != Tag::status_type::ERROR);
+
+    auto bytes_written = out_buf.size() - strm->avail_out;
+    assert(bytes_written <= std::numeric_limits<std::streamsize>::max());
+    underlying->write(reinterpret_cast<const char*>(out_buf.data()), static_cast<std::streamsize>(bytes_written)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    return result;
+  }
+};
 } // namespace champsim
 
 #endif
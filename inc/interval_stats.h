@@ -0,0 +1,86 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERVAL_STATS_H
+#define INTERVAL_STATS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cache_stats.h"
+#include "core_stats.h"
+#include "dram_stats.h"
+
+namespace champsim
+{
+class environment;
+
+/**
+ * A snapshot of the statistics of each core, cache, and DRAM channel, taken partway through a phase.
+ * Subtracting consecutive snapshots of the same phase gives the statistics of the interval between them.
+ */
+struct interval_stats {
+  std::string phase;
+  bool is_warmup = false;
+  uint64_t index = 0; // the number of the snapshot within its phase
+  std::vector<cpu_stats> cpus;
+  std::vector<cache_stats> caches;
+  std::vector<dram_stats> dram_channels;
+};
+
+interval_stats operator-(interval_stats lhs, const interval_stats& rhs);
+
+interval_stats take_interval_snapshot(environment& env, const std::string& phase, bool is_warmup, uint64_t index);
+
+/**
+ * Writes interval statistics to a stream as newline-delimited JSON, one line per interval.
+ *
+ * Snapshots are pushed from the simulation loop, and a background thread subtracts each from the previous snapshot of the same phase and
+ * formats the result, so that the simulation pays only for the copy.
+ */
+class interval_writer
+{
+  std::ostream& stream;
+  std::mutex mutex;
+  std::condition_variable pending_cv;
+  std::deque<interval_stats> pending;
+  bool closed = false;
+  std::thread worker;
+
+  void run();
+
+public:
+  explicit interval_writer(std::ostream& str);
+  ~interval_writer();
+
+  interval_writer(const interval_writer&) = delete;
+  interval_writer& operator=(const interval_writer&) = delete;
+
+  void push(interval_stats snapshot);
+
+  // Write every pushed snapshot and stop the background thread
+  void close();
+};
+} // namespace champsim
+
+#endif
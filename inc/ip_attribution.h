@@ -0,0 +1,103 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IP_ATTRIBUTION_H
+#define IP_ATTRIBUTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "address.h"
+
+namespace champsim::stats
+{
+/**
+ * Attributes misses, late prefetches, and useless prefetches to the instruction addresses that cause them.
+ *
+ * A miss is attributed to the instruction that missed. A prefetch, whether late or useless, is attributed to the instruction that triggered it,
+ * not to the demand access that found it in flight or the access that evicted it.
+ *
+ * The table holds at most a fixed number of addresses, chosen by the space-saving algorithm: when an untracked address has an event and the
+ * table is full, it replaces the address with the fewest events and inherits that count as its error. Any address with more events than
+ * the total divided by the capacity is guaranteed to be tracked, and no count is overestimated by more than its error.
+ */
+class ip_attribution
+{
+public:
+  struct record {
+    champsim::address ip{};
+    long events = 0; // misses, late prefetches, and useless prefetches together
+    long error = 0;  // the most by which events may be overestimated
+
+    long misses = 0;
+    long late_prefetches = 0;
+    long useless_prefetches = 0;
+    long miss_latency_cycles = 0;
+    long miss_latency_samples = 0;
+
+    // Zero if no miss latency was recorded, such as for an address with only prefetch events
+    [[nodiscard]] double average_miss_latency() const;
+  };
+
+private:
+  std::size_t m_capacity = 0;
+  std::vector<record> entries{};
+  std::unordered_map<uint64_t, std::size_t> index{};
+
+  // Prefetches that no instruction issued, such as those from a prefetcher's cycle or fill hooks. They are not attributed to any address.
+  long m_untriggered_late_prefetches = 0;
+  long m_untriggered_useless_prefetches = 0;
+
+  // A min-heap of (events, entry). Events only grow between rebuilds, so a key may be lower than its entry's count, but never higher.
+  std::vector<std::pair<long, std::size_t>> fewest_events{};
+
+  record& admit(champsim::address ip);
+  void rebuild_heap();
+  [[nodiscard]] const record* find(champsim::address ip) const;
+
+public:
+  ip_attribution() = default;
+  explicit ip_attribution(std::size_t capacity);
+
+  [[nodiscard]] std::size_t capacity() const { return m_capacity; }
+  [[nodiscard]] bool enabled() const { return m_capacity > 0; }
+
+  void record_miss(champsim::address ip);
+  void record_late_prefetch(champsim::address ip);
+  void record_useless_prefetch(champsim::address ip);
+  void record_untriggered_late_prefetch();
+  void record_untriggered_useless_prefetch();
+
+  // Latencies are only recorded for addresses that are already tracked, since the miss that began the latency was counted as an event
+  void record_miss_latency(champsim::address ip, long cycles);
+
+  /**
+   * The tracked addresses with at least one event, the most events first.
+   */
+  [[nodiscard]] std::vector<record> top() const;
+  [[nodiscard]] long untriggered_late_prefetches() const { return m_untriggered_late_prefetches; }
+  [[nodiscard]] long untriggered_useless_prefetches() const { return m_untriggered_useless_prefetches; }
+
+  ip_attribution& operator-=(const ip_attribution& rhs);
+};
+
+ip_attribution operator-(ip_attribution lhs, const ip_attribution& rhs);
+} // namespace champsim::stats
+
+#endif
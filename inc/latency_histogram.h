@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace champsim::stats
+{
+/**
+ * A histogram of latencies with logarithmically sized buckets.
+ *
+ * Each power of two is split into 2^precision_bits buckets of equal width, so that any recorded value can be recovered to within
+ * 1/2^precision_bits of itself, and the histogram of even very long latencies needs only a few hundred buckets. Values below
+ * 2^precision_bits have buckets of their own.
+ */
+class latency_histogram
+{
+public:
+  constexpr static unsigned precision_bits = 3;
+
+  using value_type = long;
+
+private:
+  std::vector<value_type> buckets{};
+  value_type m_count = 0;
+  value_type m_sum = 0;
+
+public:
+  [[nodiscard]] static std::size_t bucket_index(uint64_t value);
+  [[nodiscard]] static uint64_t bucket_lower_bound(std::size_t index);
+  [[nodiscard]] static uint64_t bucket_upper_bound(std::size_t index); // the highest value in the bucket
+
+  // Negative values are recorded as zero
+  void record(long value);
+
+  [[nodiscard]] value_type count() const { return m_count; }
+  [[nodiscard]] value_type sum() const { return m_sum; }
+  [[nodiscard]] double mean() const;
+
+  /**
+   * The highest value in the bucket that holds the given percentile, or zero if nothing has been recorded.
+   */
+  [[nodiscard]] uint64_t percentile(double pct) const;
+  [[nodiscard]] uint64_t max() const { return percentile(100); }
+
+  // The number of values recorded in the bucket with the given index
+  [[nodiscard]] value_type value_or(std::size_t index, value_type default_value) const;
+
+  /**
+   * The same counts in coarse buckets, as pairs of the lower bound of each bucket and its count, with empty buckets left out.
+   * Zero has a bucket of its own, and each bucket after it covers one power of two.
+   */
+  [[nodiscard]] std::vector<std::pair<uint64_t, value_type>> power_of_two_buckets() const;
+
+  latency_histogram& operator+=(const latency_histogram& rhs);
+  latency_histogram& operator-=(const latency_histogram& rhs);
+};
+
+latency_histogram operator+(latency_histogram lhs, const latency_histogram& rhs);
+latency_histogram operator-(latency_histogram lhs, const latency_histogram& rhs);
+} // namespace champsim::stats
+
+#endif
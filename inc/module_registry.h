@@ -0,0 +1,126 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MODULE_REGISTRY_H
+#define MODULE_REGISTRY_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cache.h"
+
+namespace champsim
+{
+/**
+ * The prefetchers and replacement policies that can be chosen for a cache when the simulator starts, by name.
+ *
+ * A configuration built with ``"runtime_modules": true`` registers every prefetcher and replacement policy it finds. Caches dispatch to
+ * their modules through CACHE::prefetcher_module_concept and CACHE::replacement_module_concept either way, so a module chosen at runtime
+ * costs no more per call than one chosen in the configuration.
+ */
+class module_registry
+{
+public:
+  using prefetcher_factory = std::function<std::unique_ptr<CACHE::prefetcher_module_concept>(CACHE*)>;
+  using replacement_factory = std::function<std::unique_ptr<CACHE::replacement_module_concept>(CACHE*)>;
+
+private:
+  std::map<std::string, prefetcher_factory> prefetchers{};
+  std::map<std::string, replacement_factory> replacements{};
+
+public:
+  template <typename P>
+  void add_prefetcher(std::string name)
+  {
+    prefetchers.insert_or_assign(std::move(name), [](CACHE* cache) { return std::make_unique<CACHE::prefetcher_module_model<P>>(cache); });
+  }
+
+  template <typename R>
+  void add_replacement(std::string name)
+  {
+    replacements.insert_or_assign(std::move(name), [](CACHE* cache) { return std::make_unique<CACHE::replacement_module_model<R>>(cache); });
+  }
+
+  [[nodiscard]] bool empty() const { return prefetchers.empty() && replacements.empty(); }
+  [[nodiscard]] std::vector<std::string> prefetcher_names() const;
+  [[nodiscard]] std::vector<std::string> replacement_names() const;
+
+  /**
+   * Replace the prefetcher of the cache with the named one.
+   * This must be done before the cache is initialized.
+   *
+   * \throws std::invalid_argument If no prefetcher has the name
+   */
+  void set_prefetcher(CACHE& cache, const std::string& name) const;
+
+  /**
+   * Replace the replacement policy of the cache with the named one.
+   * This must be done before the cache is initialized.
+   *
+   * \throws std::invalid_argument If no replacement policy has the name
+   */
+  void set_replacement(CACHE& cache, const std::string& name) const;
+
+  /**
+   * Replace the prefetcher of a cache that is already running with the named one.
+   *
+   * \throws std::invalid_argument If no prefetcher has the name
+   */
+  void switch_prefetcher(CACHE& cache, const std::string& name) const;
+
+  /**
+   * Replace the replacement policy of a cache that is already running with the named one, keeping the contents of the cache.
+   *
+   * \throws std::invalid_argument If no replacement policy has the name
+   */
+  void switch_replacement(CACHE& cache, const std::string& name) const;
+
+  /**
+   * \throws std::invalid_argument If no module of the kind has the name
+   */
+  [[nodiscard]] const prefetcher_factory& find_prefetcher(const std::string& name) const;
+  [[nodiscard]] const replacement_factory& find_replacement(const std::string& name) const;
+};
+
+/**
+ * Whether a key of a selection names the cache: either the name of the cache, or its kind (``L2C`` names ``cpu0_L2C``).
+ */
+[[nodiscard]] bool names_cache(const std::string& key, const std::string& cache_name);
+
+/**
+ * Apply a module selection to the caches of an environment.
+ *
+ * The selection is a JSON object in the same form as the cache sections of a configuration file, with only the ``prefetcher`` and
+ * ``replacement`` keys, for example ``{"L2C": {"prefetcher": "next_line"}, "LLC": {"replacement": "srrip"}}``.
+ * A key names a cache, or names each core's cache of that kind (``L2C`` matches ``cpu0_L2C``, ``cpu1_L2C``, and so on).
+ *
+ * \throws std::invalid_argument If the selection is malformed, names no cache, or names a module that is not registered
+ */
+void select_modules(const module_registry& registry, const std::vector<std::reference_wrapper<CACHE>>& caches, const std::string& selection_json);
+
+/**
+ * Apply a module selection, in the form taken by select_modules(), to caches that are already running.
+ * This is meant to be done between phases.
+ *
+ * \throws std::invalid_argument If the selection is malformed, names no cache, or names a module that is not registered
+ */
+void switch_modules(const module_registry& registry, const std::vector<std::reference_wrapper<CACHE>>& caches, const std::string& selection_json);
+} // namespace champsim
+
+#endif
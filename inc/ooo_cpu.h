@@ -24,6 +24,7 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <deque>
 #include <limits>
 #include <memory>
@@ -93,6 +94,7 @@ public:
   long long finish_phase_instr = 0;
   champsim::chrono::clock::time_point last_heartbeat_time{};
   long long last_heartbeat_instr = 0;
+  std::chrono::steady_clock::time_point last_heartbeat_host_time = std::chrono::steady_clock::now();
 
   // instruction
   long long num_retired = 0;
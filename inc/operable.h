@@ -17,7 +17,15 @@
 #ifndef OPERABLE_H
 #define OPERABLE_H
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
 #include "chrono.h"
+#include "host_profile.h"
 
 namespace champsim
 {
@@ -27,6 +35,7 @@ public:
   champsim::chrono::picoseconds clock_period{};
   champsim::chrono::clock::time_point current_time{};
   bool warmup = true;
+  champsim::host_time_sampler host_time{};
 
   operable();
   virtual ~operable() = default;
@@ -44,6 +53,73 @@ public:
   [[deprecated]] uint64_t current_cycle() const;
 };
 
+/**
+ * Advance a component whose type is known to the time of the clock.
+ * This behaves like operable::operate_on(), but the call to operate() is resolved at compile time rather than through the vtable.
+ */
+template <typename T>
+long operate_on(T& op, const champsim::chrono::clock& clock)
+{
+  long progress{0};
+  while (op.current_time < clock.now()) {
+    op.current_time += op.clock_period;
+    progress += op.host_time.measure([&op] { return op.T::operate(); });
+  }
+
+  return progress;
+}
+
+namespace detail
+{
+template <std::size_t I, typename Tup>
+long operate_element(Tup& components, const champsim::chrono::clock& clock)
+{
+  return champsim::operate_on(std::get<I>(components), clock);
+}
+
+/**
+ * A table of functions that advance each element of the tuple, indexed by its position
+ */
+template <typename Tup, std::size_t... Is>
+constexpr auto operate_table(std::index_sequence<Is...>)
+{
+  return std::array<long (*)(Tup&, const champsim::chrono::clock&), sizeof...(Is)>{&operate_element<Is, Tup>...};
+}
+} // namespace detail
+
+/**
+ * A fixed set of components whose types are known, advanced together.
+ * Components that are furthest behind operate first. The order is found the same way environment::operate_on() sorts the operable view, so that
+ * the two agree even where std::sort is not stable.
+ */
+template <typename... Ts>
+class operable_tuple
+{
+  constexpr static std::size_t size = sizeof...(Ts);
+
+  std::tuple<Ts&...> components;
+  constexpr static auto operate_at = detail::operate_table<std::tuple<Ts&...>>(std::index_sequence_for<Ts...>{});
+
+public:
+  explicit operable_tuple(std::tuple<Ts&...> components_) : components(components_) {}
+
+  long operate_on(const champsim::chrono::clock& clock)
+  {
+    const auto times = std::apply([](const auto&... op) { return std::array<champsim::chrono::clock::time_point, size>{op.current_time...}; }, components);
+
+    std::array<std::size_t, size> order{};
+    std::iota(std::begin(order), std::end(order), std::size_t{0});
+    std::sort(std::begin(order), std::end(order), [&times](std::size_t lhs, std::size_t rhs) { return times[lhs] < times[rhs]; });
+
+    long progress{0};
+    for (auto idx : order) {
+      progress += operate_at[idx](components, clock);
+    }
+
+    return progress;
+  }
+};
+
 } // namespace champsim
 
 #endif
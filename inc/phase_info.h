@@ -27,9 +27,13 @@
 #include "cache_stats.h"
 #include "core_stats.h"
 #include "dram_stats.h"
+#include "host_profile.h"
+#include "interval_stats.h"
+#include "ptw_stats.h"
 
 namespace champsim
 {
+class policy_controller;
 
 struct phase_info {
   std::string name;
@@ -40,6 +44,9 @@ struct phase_info {
   std::optional<std::string> cache_checkpoint_in;
   std::optional<std::string> cache_checkpoint_out;
   bool verbose = false;
+  long long stats_interval = 0; // if nonzero, push a snapshot to interval_sink every this many instructions retired across all CPUs
+  std::shared_ptr<interval_writer> interval_sink{};
+  std::shared_ptr<policy_controller> controller{}; // if set, consulted when the phase ends
 };
 
 struct phase_stats {
@@ -48,6 +55,8 @@ struct phase_stats {
   std::vector<O3_CPU::stats_type> roi_cpu_stats, sim_cpu_stats;
   std::vector<CACHE::stats_type> roi_cache_stats, sim_cache_stats;
   std::vector<DRAM_CHANNEL::stats_type> roi_dram_stats, sim_dram_stats;
+  std::vector<PageTableWalker::stats_type> roi_ptw_stats, sim_ptw_stats;
+  host_profile_stats host_profile;
 };
 
 } // namespace champsim
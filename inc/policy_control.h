@@ -0,0 +1,56 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef POLICY_CONTROL_H
+#define POLICY_CONTROL_H
+
+#include <istream>
+#include <ostream>
+
+#include "module_registry.h"
+
+namespace champsim
+{
+struct environment;
+struct phase_stats;
+
+/**
+ * A line protocol through which another process can steer a simulation between its phases, so that an episode of many decisions runs
+ * in a single process.
+ *
+ * When a phase ends, the controller writes the statistics of the phase as one line of JSON, in the same layout as a phase of --json,
+ * then reads commands one line at a time:
+ *   - a JSON object switches the modules of running caches, in the form taken by select_modules(), and is answered with ``{"ok": true}``
+ *     or ``{"error": "..."}``
+ *   - ``continue``, or an empty line, starts the next phase
+ *   - ``stop``, or the end of the input, ends the simulation
+ */
+class policy_controller
+{
+  std::istream& in;
+  std::ostream& out;
+  module_registry registry;
+
+public:
+  policy_controller(std::istream& in_stream, std::ostream& out_stream, module_registry modules);
+
+  // Returns whether the simulation should go on to the next phase
+  bool phase_complete(environment& env, const phase_stats& stats);
+};
+} // namespace champsim
+
+#endif
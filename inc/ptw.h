@@ -28,6 +28,7 @@
 #include "channel.h"
 #include "operable.h"
 #include "ptw_builder.h"
+#include "ptw_stats.h"
 #include "util/lru_table.h"
 #include "waitable.h"
 
@@ -63,6 +64,8 @@ class PageTableWalker : public champsim::operable
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     std::size_t translation_level = 0;
+    std::size_t walk_start_level = 0;
+    champsim::chrono::clock::time_point walk_start{};
 
     mshr_type(const request_type& req, std::size_t level);
   };
@@ -79,14 +82,21 @@ class PageTableWalker : public champsim::operable
   std::optional<mshr_type> step_translation(const mshr_type& source);
 
   void finish_packet(const response_type& packet);
+  void record_walk(const mshr_type& mshr_entry);
 
 public:
+  using stats_type = ptw_stats;
+
+  stats_type roi_stats{}, sim_stats{};
+
   const std::string NAME;
   const uint32_t MSHR_SIZE;
   champsim::bandwidth::maximum_type MAX_READ, MAX_FILL;
   const champsim::chrono::clock::duration HIT_LATENCY;
+  const bool occupancy_stats;
 
   std::vector<pscl_type> pscl;
+  std::vector<std::size_t> pscl_levels;
   VirtualMemory* vmem;
 
   const champsim::address CR3_addr;
@@ -96,6 +106,7 @@ public:
   long operate() final;
 
   void begin_phase() final;
+  void end_phase(unsigned cpu) final;
   void print_deadlock() final;
 };
 
@@ -46,6 +46,7 @@ class ptw_builder
   std::vector<champsim::channel*> m_uls{};
   champsim::channel* m_ll{};
   VirtualMemory* m_vmem{};
+  bool m_occupancy_stats{false};
 
   friend class ::PageTableWalker;
 
@@ -65,6 +66,16 @@ public:
   ptw_builder& upper_levels(std::vector<champsim::channel*>&& uls_);
   ptw_builder& lower_level(champsim::channel* ll_);
   ptw_builder& virtual_memory(VirtualMemory* vmem_);
+
+  /**
+   * Count the walks in flight as each walk begins, and the MSHR occupancy in every cycle.
+   */
+  ptw_builder& set_occupancy_stats();
+
+  /**
+   * Do not count the walks in flight or the MSHR occupancy. This is the default.
+   */
+  ptw_builder& reset_occupancy_stats();
 };
 } // namespace champsim
 
@@ -0,0 +1,34 @@
+#ifndef PTW_STATS_H
+#define PTW_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "event_counter.h"
+#include "latency_histogram.h"
+
+struct ptw_stats {
+  std::string name{};
+
+  // Keyed by the page table level that the PSCL caches
+  champsim::stats::event_counter<std::size_t> pscl_hits{};
+  champsim::stats::event_counter<std::size_t> pscl_misses{};
+
+  uint64_t walks = 0;
+  long total_walk_latency_cycles{};
+
+  // Histograms
+  champsim::stats::event_counter<std::size_t> walk_depth{};
+  champsim::stats::latency_histogram walk_latency{};
+  champsim::stats::event_counter<std::size_t> concurrent_walks{};
+
+  // The walks in flight and the MSHR occupancy are only counted when this is set
+  bool occupancy_stats = false;
+  uint64_t total_mshr_occupancy = 0;
+  uint64_t cycles = 0;
+};
+
+ptw_stats operator-(ptw_stats lhs, ptw_stats rhs);
+
+#endif
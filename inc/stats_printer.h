@@ -20,7 +20,9 @@
 
 #include "cache.h"
 #include "dram_controller.h"
+#include "interval_stats.h"
 #include "ooo_cpu.h"
+#include "ptw.h"
 #include "phase_info.h"
 
 namespace champsim
@@ -37,6 +39,8 @@ public:
   static std::vector<std::string> format(O3_CPU::stats_type stats);
   static std::vector<std::string> format(CACHE::stats_type stats);
   static std::vector<std::string> format(DRAM_CHANNEL::stats_type stats);
+  static std::vector<std::string> format(PageTableWalker::stats_type stats);
+  static std::vector<std::string> format(const host_profile_stats& stats);
   static std::vector<std::string> format(phase_stats& stats);
 };
 
@@ -47,5 +51,11 @@ class json_printer
 public:
   json_printer(std::ostream& str) : stream(str) {}
   void print(std::vector<phase_stats>& stats);
+
+  // Write one phase as a single line of JSON, with the same layout as an element of the array written for many phases
+  void print(const phase_stats& stats);
+
+  // Write one interval as a single line of JSON, with the same layout as the "sim" section of a phase
+  void print(const interval_stats& stats);
 };
 } // namespace champsim
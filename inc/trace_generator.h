@@ -0,0 +1,127 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACE_GENERATOR_H
+#define TRACE_GENERATOR_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "trace_instruction.h"
+
+namespace champsim
+{
+/**
+ * The properties of a synthetic instruction stream.
+ *
+ * The generator lays out a static program of code_footprint bytes, in which each instruction slot has a fixed kind, so that the same IP always
+ * performs the same kind of operation. Loads and stores are each assigned to one of the data streams. Running the program follows taken branches
+ * to their targets and otherwise falls through to the next slot.
+ */
+struct trace_generator_spec {
+  enum class stream_kind { stride, pointer_chase, random };
+
+  struct data_stream {
+    stream_kind kind = stream_kind::stride;
+    uint64_t base = 0x10000000;
+    uint64_t footprint = 1 << 20;
+    int64_t stride = 64; // only for stride streams; each instruction walks the footprint separately
+    double weight = 1;   // relative share of the memory instructions
+  };
+
+  uint64_t length = 0; // the number of instructions in this phase, or 0 if the phase does not end
+  uint64_t seed = 0;
+
+  uint64_t code_base = 0x400000;
+  uint64_t code_footprint = 16 << 10;
+
+  // Fractions of the instruction slots. The remainder are ALU instructions.
+  double load_fraction = 0.25;
+  double store_fraction = 0.1;
+  double branch_fraction = 0.15;
+
+  // Relative shares of the branch slots
+  double conditional_weight = 0.7;
+  double direct_jump_weight = 0.1;
+  double indirect_weight = 0.05;
+  double call_weight = 0.075;
+  double return_weight = 0.075;
+
+  // Each conditional branch is taken with this probability, or its complement. 1 is fully predictable; 0.5 is random.
+  double branch_predictability = 0.95;
+  std::size_t indirect_targets = 4;
+
+  // Instructions are dealt round-robin into this many independent chains, each of which restarts after chain_length instructions
+  std::size_t dependency_chains = 4;
+  std::size_t chain_length = 8;
+
+  std::vector<data_stream> streams{data_stream{}};
+};
+
+/**
+ * An infinite stream of instructions that follows a sequence of phases, returning to the first after the last.
+ */
+class trace_generator
+{
+public:
+  explicit trace_generator(std::vector<trace_generator_spec> phases);
+  explicit trace_generator(trace_generator_spec spec) : trace_generator(std::vector<trace_generator_spec>{spec}) {}
+
+  input_instr operator()();
+
+  enum class slot_kind { alu, load, store, conditional, direct_jump, indirect, call, ret };
+
+  struct slot {
+    slot_kind kind = slot_kind::alu;
+    std::size_t stream = 0;
+    uint64_t cursor = 0; // the next block offset of a stride stream
+    double taken_probability = 0;
+    std::vector<uint64_t> targets{};
+  };
+
+  struct stream_state {
+    trace_generator_spec::data_stream params;
+    std::vector<uint32_t> next_element{}; // the cycle through a pointer-chase stream
+    uint32_t current = 0;
+  };
+
+  struct phase {
+    trace_generator_spec spec;
+    std::vector<slot> program{};
+    std::vector<stream_state> streams{};
+    std::vector<uint64_t> call_stack{};
+    std::vector<std::size_t> chain_position{};
+    std::size_t next_chain = 0;
+    uint64_t pc = 0;
+    std::mt19937_64 rng;
+
+    explicit phase(trace_generator_spec spec);
+    input_instr next();
+
+  private:
+    uint64_t address_for(slot& s);
+    void set_registers(input_instr& instr, slot_kind kind);
+  };
+
+private:
+  std::vector<phase> phases;
+  std::size_t current_phase = 0;
+  uint64_t phase_count = 0;
+};
+} // namespace champsim
+
+#endif
@@ -24,6 +24,7 @@
 #include <string>
 #include <type_traits>
 
+#include "host_profile.h"
 #include "instruction.h"
 #include "util/detect.h"
 
@@ -59,6 +60,8 @@ class tracereader
   std::unique_ptr<reader_concept> pimpl_;
 
 public:
+  champsim::host_time_sampler host_time{};
+
   template <typename T, std::enable_if_t<!std::is_same_v<tracereader, T>, bool> = true>
   tracereader(T&& val) : pimpl_(std::make_unique<reader_model<T>>(std::forward<T>(val)))
   {
@@ -0,0 +1,133 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_OPEN_ADDRESSING_MAP_H
+#define UTIL_OPEN_ADDRESSING_MAP_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A map from 64-bit keys to 64-bit values, stored in one flat array with linear probing.
+ *
+ * All entries live in a single allocation, so a lookup touches one or two cache lines rather than walking a tree of nodes.
+ * Entries cannot be erased. The largest key is reserved to mark empty slots.
+ */
+class open_addressing_map
+{
+public:
+  using key_type = uint64_t;
+  using mapped_type = uint64_t;
+
+  constexpr static key_type empty_key = std::numeric_limits<key_type>::max();
+
+private:
+  struct slot_type {
+    key_type key = empty_key;
+    mapped_type value{};
+  };
+
+  std::vector<slot_type> slots;
+  std::size_t occupied = 0;
+
+  static constexpr std::size_t hash(key_type key)
+  {
+    // The SplitMix64 finalizer, so that keys differing only in their upper bits spread across the table
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+    return static_cast<std::size_t>(key ^ (key >> 31));
+  }
+
+  [[nodiscard]] std::size_t find_slot(key_type key) const
+  {
+    const auto mask = std::size(slots) - 1;
+    auto idx = hash(key) & mask;
+    while (slots[idx].key != key && slots[idx].key != empty_key) {
+      idx = (idx + 1) & mask;
+    }
+    return idx;
+  }
+
+  void grow()
+  {
+    std::vector<slot_type> old_slots(std::size(slots) * 2);
+    std::swap(slots, old_slots);
+    for (const auto& slot : old_slots) {
+      if (slot.key != empty_key) {
+        slots[find_slot(slot.key)] = slot;
+      }
+    }
+  }
+
+public:
+  explicit open_addressing_map(std::size_t initial_capacity = 64) : slots(initial_capacity)
+  {
+    assert(initial_capacity > 0 && (initial_capacity & (initial_capacity - 1)) == 0);
+  }
+
+  /**
+   * Insert the value if the key is not present.
+   *
+   * :returns: A pair of a reference to the mapped value and whether an insertion took place. The reference is invalidated by the next insertion.
+   */
+  std::pair<mapped_type&, bool> try_emplace(key_type key, mapped_type value)
+  {
+    return try_emplace_with(key, [value] { return value; });
+  }
+
+  /**
+   * Insert the value returned by ``make_value()`` if the key is not present. The function is called only if an insertion takes place.
+   *
+   * :returns: A pair of a reference to the mapped value and whether an insertion took place. The reference is invalidated by the next insertion.
+   */
+  template <typename F>
+  std::pair<mapped_type&, bool> try_emplace_with(key_type key, F&& make_value)
+  {
+    assert(key != empty_key);
+
+    // Keep the load factor at or below one half, so that probe sequences stay short
+    if (2 * (occupied + 1) > std::size(slots)) {
+      grow();
+    }
+
+    auto& slot = slots[find_slot(key)];
+    if (slot.key == key) {
+      return {slot.value, false};
+    }
+
+    slot = slot_type{key, std::forward<F>(make_value)()};
+    ++occupied;
+    return {slot.value, true};
+  }
+
+  [[nodiscard]] const mapped_type* find(key_type key) const
+  {
+    const auto& slot = slots[find_slot(key)];
+    return (slot.key == key) ? &slot.value : nullptr;
+  }
+
+  [[nodiscard]] std::size_t size() const { return occupied; }
+  [[nodiscard]] std::size_t capacity() const { return std::size(slots); }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_PERMUTATION_H
+#define UTIL_PERMUTATION_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace champsim
+{
+/**
+ * A seeded bijection on the integers ``[0, size)``, evaluated one element at a time.
+ *
+ * This gives the same result as shuffling the sequence ``0, 1, ..., size-1`` and reading it in order, without storing the sequence.
+ * The permutation is a balanced Feistel network over the smallest even number of bits that covers the range.
+ * Values that fall outside the range are passed through the network again until they land inside it (cycle walking).
+ * Since the covering range is less than four times the size, this takes fewer than four passes on average.
+ */
+class keyed_permutation
+{
+  constexpr static std::size_t ROUNDS = 4;
+
+  uint64_t domain_size;
+  unsigned half_bits = 1;
+  std::array<uint64_t, ROUNDS> round_keys{};
+
+  static constexpr uint64_t mix(uint64_t x)
+  {
+    // The SplitMix64 finalizer
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  }
+
+  [[nodiscard]] constexpr uint64_t half_mask() const { return (uint64_t{1} << half_bits) - 1; }
+
+  [[nodiscard]] constexpr uint64_t encrypt(uint64_t x) const
+  {
+    uint64_t left = x >> half_bits;
+    uint64_t right = x & half_mask();
+    for (auto key : round_keys) {
+      auto next_right = left ^ (mix(right ^ key) & half_mask());
+      left = right;
+      right = next_right;
+    }
+    return (left << half_bits) | right;
+  }
+
+public:
+  constexpr keyed_permutation(uint64_t size, uint64_t seed) : domain_size(size)
+  {
+    assert(size > 0);
+    while (half_bits < 32 && (uint64_t{1} << (2 * half_bits)) < size) {
+      ++half_bits;
+    }
+
+    for (auto& key : round_keys) {
+      seed = mix(seed);
+      key = seed;
+    }
+  }
+
+  [[nodiscard]] constexpr uint64_t size() const { return domain_size; }
+
+  /**
+   * Find the element at the given position of the permuted sequence.
+   */
+  [[nodiscard]] constexpr uint64_t operator()(uint64_t idx) const
+  {
+    assert(idx < domain_size);
+    do {
+      idx = encrypt(idx);
+    } while (idx >= domain_size);
+    return idx;
+  }
+};
+} // namespace champsim
+
+#endif
@@ -18,24 +18,52 @@
 #define VMEM_H
 
 #include <cstdint>
-#include <deque>
-#include <map>
 #include <optional>
-#include <random>
+#include <utility>
+#include <vector>
 
 #include "address.h"
 #include "champsim.h"
 #include "chrono.h"
+#include "util/open_addressing_map.h"
+#include "util/permutation.h"
 
 class MEMORY_CONTROLLER;
 
 using pte_entry = champsim::data::size<long long, std::ratio<8>>;
 
+namespace champsim
+{
+/**
+ * Which parts of the virtual address space are backed by large pages.
+ */
+struct large_page_policy {
+  // The size of a large page, which must be the span of one entry at some level of the page table (2 MiB or 1 GiB with the default tables).
+  // A size of zero disables large pages.
+  champsim::data::bytes page_size{0};
+
+  // The address spaces that may use large pages. If empty, all may.
+  std::vector<uint32_t> asids{};
+
+  // The virtual address ranges, as [begin, end), that may use large pages. If empty, the whole space may.
+  std::vector<std::pair<champsim::address, champsim::address>> ranges{};
+
+  // The number of base pages that must be touched in a region before it is promoted to a large page, as with transparent huge pages.
+  // With a threshold of 1, eligible regions are backed by large pages from their first touch.
+  std::size_t promotion_threshold = 1;
+
+  // The physical memory set aside for large frames, at the top of memory. Base pages and page table pages are never allocated there.
+  // A reservation of zero sets aside half of physical memory.
+  champsim::data::bytes reserved{0};
+};
+} // namespace champsim
+
 class VirtualMemory
 {
 private:
-  std::map<std::pair<uint32_t, champsim::page_number>, champsim::page_number> vpage_to_ppage_map;
-  std::map<std::tuple<uint32_t, uint32_t, champsim::address_slice<champsim::dynamic_extent>>, champsim::address> page_table;
+  // Translations are kept per address space and per level of the page table.
+  // Level 0 maps virtual pages to physical pages, and level N maps the virtual address bits above shamt(N) to the page table entry for that level.
+  std::vector<std::vector<champsim::open_addressing_map>> translation_tables;
   std::optional<uint64_t> randomization_seed;
   MEMORY_CONTROLLER& dram;
 
@@ -45,19 +73,39 @@ public:
   const pte_entry pte_page_size; // Size of a PTE page
 
 private:
-  std::deque<champsim::page_number> ppage_free_list;
+  // Physical pages are handed out in the order of a seeded permutation of the page indices, so the free list is never stored
+  champsim::page_number ppage_base{};
+  uint64_t ppage_count = 0;
+  uint64_t ppage_next = 0;
+  std::optional<champsim::keyed_permutation> ppage_order;
+
   champsim::page_number active_pte_page{};
   champsim::address_slice<champsim::dynamic_extent> next_pte_page;
 
-  // champsim::page_number next_ppage;
-  // champsim::page_number last_ppage;
+  // Large frames are carved downward from the top of physical memory, between large_frame_floor and large_frame_top.
+  // Base pages are only allocated below large_frame_floor.
+  champsim::large_page_policy large_pages;
+  std::size_t large_page_level = 0;
+  uint64_t large_frame_floor = 0;
+  uint64_t large_frame_top = 0;
+  std::vector<champsim::open_addressing_map> large_page_frames; // per address space, region to first page of the frame
+  std::vector<champsim::open_addressing_map> region_touches;    // per address space, region to the number of base pages touched
 
   [[nodiscard]] champsim::page_number ppage_front() const;
+  [[nodiscard]] uint64_t ppage_index(uint64_t position) const;
   void ppage_pop();
 
-  void shuffle_pages();
   void populate_pages();
 
+  champsim::open_addressing_map& table_for(uint32_t cpu_num, std::size_t level);
+
+  [[nodiscard]] uint64_t pages_per_large_page() const;
+  [[nodiscard]] uint64_t large_page_region(champsim::page_number vaddr) const;
+  [[nodiscard]] bool large_page_eligible(uint32_t cpu_num, champsim::page_number vaddr) const;
+  [[nodiscard]] const uint64_t* find_base_page(uint32_t cpu_num, champsim::page_number vaddr) const;
+  [[nodiscard]] const uint64_t* find_large_frame(uint32_t cpu_num, champsim::page_number vaddr) const;
+  std::optional<uint64_t> map_large_page(uint32_t cpu_num, champsim::page_number vaddr);
+
 public:
   /**
    * Initialize the virtual memory.
@@ -74,6 +122,8 @@ public:
                 MEMORY_CONTROLLER& dram_);
   VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
                 MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_);
+  VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
+                MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_, champsim::large_page_policy large_page_policy_);
 
   /**
    * Find the bit location of the lowest bit for the given page table level.
@@ -96,6 +146,14 @@ public:
    */
   [[nodiscard]] std::size_t available_ppages() const;
 
+  /**
+   * The level of the page table that holds the final translation for the given page.
+   * This is 0 for base pages, and the level of a large page entry if the page is, or on its next translation will be, backed by a large page.
+   * Pages that were mapped before their region was promoted keep their base pages, so their physical addresses do not change.
+   * Page table walks end after reading the entry at this level.
+   */
+  [[nodiscard]] std::size_t leaf_level(uint32_t cpu_num, champsim::page_number vaddr) const;
+
   /**
    * Translate the given address from the virtual space to the physical space.
    * If a page translation does not already exist, one will be created and the minor fault penalty will be applied.
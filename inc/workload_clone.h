@@ -0,0 +1,141 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WORKLOAD_CLONE_H
+#define WORKLOAD_CLONE_H
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "instruction.h"
+#include "trace_instruction.h"
+
+namespace champsim
+{
+/**
+ * A statistical model of a workload, with one entry per static instruction.
+ * The profile holds no data values and no addresses other than IPs and the strides between accesses.
+ */
+struct workload_profile {
+  // Reuse distances are counted in memory accesses since the same block was last accessed, and bucketed by log2. The last bucket is for first touches.
+  constexpr static std::size_t reuse_buckets = 22;
+  // Dependency distances are counted in instructions since the producer of a source register, and bucketed by log2. The last bucket is for
+  // instructions with no recent producer.
+  constexpr static std::size_t dependency_buckets = 7;
+
+  struct ip_model {
+    uint64_t ip = 0;
+    uint64_t count = 0;
+    branch_type branch = NOT_BRANCH;
+
+    uint64_t loads = 0;  // executions with at least one load
+    uint64_t stores = 0; // executions with at least one store
+
+    std::vector<std::pair<int64_t, uint64_t>> strides{}; // the most common strides between consecutive accesses, in bytes
+    uint64_t other_strides = 0;                          // accesses that followed none of the recorded strides
+    std::array<uint64_t, reuse_buckets> reuse{};
+    std::array<uint64_t, dependency_buckets> dependency{};
+
+    uint64_t taken = 0;
+    uint64_t after_taken = 0; // executions that followed a taken execution of the same branch
+    uint64_t taken_after_taken = 0;
+    uint64_t taken_after_not_taken = 0;
+
+    std::vector<std::pair<uint64_t, uint64_t>> targets{}; // the most common successors when taken
+    std::optional<uint64_t> fallthrough{};                // the most common successor when not taken
+  };
+
+  uint64_t instructions = 0;
+  uint64_t first_ip = 0;
+  std::vector<ip_model> ips{};
+};
+
+void write_workload_profile(std::ostream& stream, const workload_profile& profile);
+workload_profile read_workload_profile(std::istream& stream);
+
+/**
+ * Accumulates a workload_profile from a stream of instructions
+ */
+class workload_profiler
+{
+public:
+  constexpr static std::size_t max_strides = 8;
+  constexpr static std::size_t max_targets = 16;
+
+  void operator()(const ooo_model_instr& instr);
+  [[nodiscard]] workload_profile profile() const;
+
+private:
+  struct ip_state {
+    workload_profile::ip_model model{};
+    std::map<int64_t, uint64_t> strides{};
+    std::map<uint64_t, uint64_t> targets{};
+    std::map<uint64_t, uint64_t> fallthroughs{};
+    std::optional<uint64_t> last_address{};
+    std::optional<bool> last_taken{};
+  };
+
+  std::unordered_map<uint64_t, ip_state> ips{};
+  std::unordered_map<uint64_t, uint64_t> block_last_access{};
+  std::array<std::optional<uint64_t>, 256> register_producer{};
+  std::optional<std::pair<uint64_t, bool>> previous{}; // the IP of the previous instruction, and whether it was a taken branch
+  uint64_t instr_count = 0;
+  uint64_t access_count = 0;
+  uint64_t first_ip = 0;
+};
+
+/**
+ * Synthesizes an infinite instruction stream from a workload_profile.
+ *
+ * The stream walks the profiled control flow, drawing branch outcomes from each branch's transition rates, memory addresses from each
+ * instruction's strides or, failing those, its reuse distances, and register dependences from its dependency distances.
+ */
+class clone_generator
+{
+public:
+  explicit clone_generator(workload_profile profile, uint64_t seed = 0);
+
+  input_instr operator()();
+
+private:
+  constexpr static std::size_t history_size = 1 << 16;
+  constexpr static std::size_t dependency_window = 32;
+
+  workload_profile profile;
+  std::unordered_map<uint64_t, std::size_t> index_of{};
+  std::vector<std::optional<uint64_t>> last_address{};
+  std::vector<bool> last_taken{};
+  std::vector<uint64_t> block_history = std::vector<uint64_t>(history_size);
+  std::vector<unsigned char> register_history = std::vector<unsigned char>(dependency_window);
+  uint64_t access_count = 0;
+  uint64_t instr_count = 0;
+  uint64_t next_cold_block = 0;
+  std::size_t current = 0;
+  std::mt19937_64 rng;
+
+  uint64_t address_for(std::size_t index);
+};
+} // namespace champsim
+
+#endif
@@ -2,40 +2,86 @@ from __future__ import annotations
 
 import json
 import subprocess
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from pathlib import Path
 from typing import Dict, Mapping
 
+RUNTIME_MODULE_KINDS = ("prefetcher", "replacement")
+
 
 @dataclass
 class BuildResult:
   binary_path: Path
   config_path: Path
+  extra_args: list[str] = field(default_factory=list)
+
+
+def is_module_choice(dotted_path: str) -> bool:
+  """Whether an update chooses a cache's prefetcher or replacement policy, which a runtime-modules binary can select."""
+  path = dotted_path.split(".")
+  return len(path) == 2 and path[-1] in RUNTIME_MODULE_KINDS
+
+
+def module_selection(module_updates: Mapping[str, str]) -> Dict[str, Dict[str, str]]:
+  """Convert {"L2C.prefetcher": name} updates to the JSON object taken by --module-config."""
+  selection: Dict[str, Dict[str, str]] = {}
+  for dotted_path, value in module_updates.items():
+    cache, kind = dotted_path.split(".")
+    selection.setdefault(cache, {})[kind] = value
+  return selection
 
 
 class ChampSimBuildManager:
-  """Generate policy-specific ChampSim binaries on demand."""
+  """Generate policy-specific ChampSim binaries on demand.
 
-  def __init__(self, repo_root: Path, template_config: Path, build_root: Path | None = None):
+  With ``runtime_modules``, prefetcher and replacement choices are passed to one
+  shared binary through ``--module-config`` instead of each being built into a
+  binary of its own. Any other action still selects a binary.
+  """
+
+  def __init__(
+      self, repo_root: Path, template_config: Path, build_root: Path | None = None, runtime_modules: bool = False
+  ):
     self.repo_root = repo_root
     self.template_config = template_config
     self.build_root = build_root or repo_root / "rl_controller" / "build_configs"
     self.build_root.mkdir(parents=True, exist_ok=True)
     self.bin_root = repo_root / "bin"
+    self.runtime_modules = runtime_modules
 
   def _binary_name(self, action_updates: Mapping[str, str]) -> str:
     suffix = "_".join(f"{key.replace('.', '-')}-{value}" for key, value in sorted(action_updates.items()))
+    if self.runtime_modules:
+      return f"champsim_rl_runtime_{suffix}" if suffix else "champsim_rl_runtime"
     return f"champsim_rl_{suffix}"
 
   def ensure_binary(self, action_updates: Mapping[str, str]) -> BuildResult:
-    name = self._binary_name(action_updates)
+    module_updates: Dict[str, str] = {}
+    build_updates = dict(action_updates)
+    if self.runtime_modules:
+      module_updates = {k: v for k, v in action_updates.items() if is_module_choice(k)}
+      build_updates = {k: v for k, v in action_updates.items() if k not in module_updates}
+
+    name = self._binary_name(build_updates)
     binary_path = self.bin_root / name
     config_path = self.build_root / f"{name}.json"
 
     if not binary_path.exists():
-      self._build_binary(name, binary_path, config_path, action_updates)
+      self._build_binary(name, binary_path, config_path, build_updates)
+
+    extra_args = []
+    if module_updates:
+      extra_args = ["--module-config", str(self._write_module_config(module_updates))]
+
+    return BuildResult(binary_path=binary_path, config_path=config_path, extra_args=extra_args)
 
-    return BuildResult(binary_path=binary_path, config_path=config_path)
+  def _write_module_config(self, module_updates: Mapping[str, str]) -> Path:
+    selection = module_selection(module_updates)
+    suffix = "_".join(f"{key.replace('.', '-')}-{value}" for key, value in sorted(module_updates.items()))
+    selection_path = self.build_root / f"modules_{suffix}.json"
+    with selection_path.open("w", encoding="utf-8") as handle:
+      json.dump(selection, handle, indent=2)
+    return selection_path
 
   def _build_binary(
       self, name: str, binary_path: Path, config_path: Path, action_updates: Mapping[str, str]
@@ -44,6 +90,8 @@ class ChampSimBuildManager:
       config = json.load(handle)
 
     config["executable_name"] = name
+    if self.runtime_modules:
+      config["runtime_modules"] = True
     for dotted_path, value in action_updates.items():
       self._set_config_value(config, dotted_path.split("."), value)
 
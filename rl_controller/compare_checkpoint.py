@@ -8,8 +8,9 @@ from typing import Dict, Iterable, List, Tuple
 import subprocess
 
 from .action_space import Action, ActionSpace, load_action_space
-from .builder import ChampSimBuildManager
+from .builder import BuildResult, ChampSimBuildManager
 from .runner import ChampSimRunner
+from .scheduler import add_scheduler_arguments, scheduler_from_args
 from .state import WindowMetrics, parse_stats_json
 
 
@@ -45,7 +46,7 @@ def _metrics_to_dict(metrics: WindowMetrics) -> Dict[str, float]:
 
 def _run_direct_window(
     repo_root: Path,
-    binary_path: Path,
+    build: BuildResult,
     trace_path: Path,
     warmup_instructions: int,
     window_instructions: int,
@@ -53,7 +54,7 @@ def _run_direct_window(
 ) -> WindowMetrics:
   stats_path.parent.mkdir(parents=True, exist_ok=True)
   cmd = (
-      f"{binary_path} "
+      f"{build.binary_path} {' '.join(build.extra_args)} "
       f"--warmup-instructions {warmup_instructions} "
       f"--simulation-instructions {window_instructions} "
       f"--subtrace-count 1 "
@@ -115,6 +116,7 @@ def main() -> None:
       default=None,
       help="Optional resume warmup for standalone runs. Defaults to full warmup (same as --warmup).",
   )
+  add_scheduler_arguments(parser)
   args = parser.parse_args()
 
   repo_root = Path(__file__).resolve().parents[1]
@@ -146,6 +148,7 @@ def main() -> None:
       output_dir=checkpoint_dir,
       shared_base=args.shared_base,
       resume_warmup=args.resume_warmup,
+      scheduler=scheduler_from_args(args),
   )
 
   base_checkpoint = runner.initialise_checkpoint(base_action, action_space)
@@ -160,25 +163,34 @@ def main() -> None:
   }
 
   print(f"Loaded {len(actions)} action(s) to compare.")
-  for idx, action in enumerate(actions):
-    print(f"\n[{idx}] Comparing action {_format_action(action)}")
-
-    checkpoint_result = runner.run_window(action, action_space, base_checkpoint, step=idx)
-    checkpoint_metrics = _metrics_to_dict(checkpoint_result.metrics)
+  standalone_warmup = args.resume_solo if args.resume_solo is not None else args.warmup + args.resume_warmup
 
+  # Queue every window and baseline first, so they run side by side
+  pending = []
+  for idx, action in enumerate(actions):
     direct_stats_path = direct_dir / f"iter_{idx:04d}_standalone.json"
-    standalone_warmup = args.resume_solo if args.resume_solo is not None else args.warmup + args.resume_warmup
-    build = build_manager.ensure_binary(action.as_config_updates(action_space.heads))
-    direct_metrics = _run_direct_window(
-        repo_root=repo_root,
-        binary_path=build.binary_path,
-        trace_path=trace_path,
-        warmup_instructions=standalone_warmup,
-        window_instructions=args.window,
-        stats_path=direct_stats_path,
+    build = runner.submit_build(action, action_space)
+    checkpoint_run = runner.submit_window(action, action_space, base_checkpoint, step=idx)
+    direct_run = runner.scheduler.submit(
+        None,
+        lambda build_result, path=direct_stats_path: _run_direct_window(
+            repo_root=repo_root,
+            build=build_result,
+            trace_path=trace_path,
+            warmup_instructions=standalone_warmup,
+            window_instructions=args.window,
+            stats_path=path,
+        ),
+        after=[build],
     )
+    pending.append((action, build, checkpoint_run, direct_run, direct_stats_path))
 
-    direct_metrics_dict = _metrics_to_dict(direct_metrics)
+  for idx, (action, build, checkpoint_run, direct_run, direct_stats_path) in enumerate(pending):
+    print(f"\n[{idx}] Comparing action {_format_action(action)}")
+
+    checkpoint_result = checkpoint_run.result()
+    checkpoint_metrics = _metrics_to_dict(checkpoint_result.metrics)
+    direct_metrics_dict = _metrics_to_dict(direct_run.result())
     delta = {key: direct_metrics_dict[key] - checkpoint_metrics[key] for key in checkpoint_metrics}
 
     print(
@@ -196,10 +208,12 @@ def main() -> None:
             "checkpoint_stats": str(checkpoint_result.stats_path),
             "standalone_stats": str(direct_stats_path),
             "checkpoint_cache": str(checkpoint_result.cache_path),
-            "binary": str(build.binary_path),
+            "binary": str(build.result().binary_path),
         }
     )
 
+  runner.scheduler.shutdown()
+
   output_dir.mkdir(parents=True, exist_ok=True)
   summary_path = output_dir / "comparison_summary.json"
   with summary_path.open("w", encoding="utf-8") as handle:
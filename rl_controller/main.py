@@ -9,6 +9,8 @@ from .action_space import Action, ActionSpace, load_action_space
 from .agent import RandomAgent
 from .builder import ChampSimBuildManager
 from .runner import ChampSimRunner
+from .scheduler import add_scheduler_arguments, scheduler_from_args
+from .session import ChampSimSession
 
 
 def parse_args() -> argparse.Namespace:
@@ -21,7 +23,12 @@ def parse_args() -> argparse.Namespace:
   parser.add_argument("--seed", type=int, default=0, help="Random seed")
   parser.add_argument("--output", type=Path, default=Path("rl_runs"), help="Directory to store checkpoints and stats")
   parser.add_argument("--shared-base", action="store_true", help="Reuse the same warm checkpoint for every action")
+  parser.add_argument("--runtime-modules", action="store_true", help="Select prefetchers and replacement policies in one binary at startup")
+  parser.add_argument(
+      "--continuous", action="store_true", help="Run the whole episode in one process, switching modules between windows (implies --runtime-modules)"
+  )
   parser.add_argument("--resume-warmup", type=int, default=1, help="Warmup instructions to run before each measurement window")
+  add_scheduler_arguments(parser)
   return parser.parse_args()
 
 
@@ -30,20 +37,38 @@ def main() -> None:
   repo_root = Path(__file__).resolve().parents[1]
 
   action_space, base_action, template_config = load_action_space(args.config.resolve())
-  build_manager = ChampSimBuildManager(repo_root=repo_root, template_config=template_config.resolve())
-
-  runner = ChampSimRunner(
+  build_manager = ChampSimBuildManager(
       repo_root=repo_root,
-      build_manager=build_manager,
-      trace_path=args.trace.resolve(),
-      warmup_instructions=args.warmup,
-      window_instructions=args.window,
-      output_dir=args.output.resolve(),
-      shared_base=args.shared_base,
-      resume_warmup=args.resume_warmup,
+      template_config=template_config.resolve(),
+      runtime_modules=args.runtime_modules or args.continuous,
   )
 
-  base_checkpoint = runner.initialise_checkpoint(base_action, action_space)
+  if args.continuous:
+    session = ChampSimSession(
+        repo_root=repo_root,
+        build_manager=build_manager,
+        trace_path=args.trace.resolve(),
+        warmup_instructions=args.warmup,
+        window_instructions=args.window,
+        steps=args.steps,
+        output_dir=args.output.resolve(),
+    )
+    session.start(base_action, action_space)
+    run_window = lambda action, step: session.run_window(action, action_space, step)
+  else:
+    runner = ChampSimRunner(
+        repo_root=repo_root,
+        build_manager=build_manager,
+        trace_path=args.trace.resolve(),
+        warmup_instructions=args.warmup,
+        window_instructions=args.window,
+        output_dir=args.output.resolve(),
+        shared_base=args.shared_base,
+        resume_warmup=args.resume_warmup,
+        scheduler=scheduler_from_args(args),
+    )
+    base_checkpoint = runner.initialise_checkpoint(base_action, action_space)
+    run_window = lambda action, step: runner.run_window(action, action_space, base_checkpoint, step)
 
   agent = RandomAgent(action_space, seed=args.seed)
   episode_log: List[dict] = []
@@ -51,7 +76,7 @@ def main() -> None:
   state = None
   for step in range(args.steps):
     action = agent.select_action(state=state)
-    result = runner.run_window(action, action_space, base_checkpoint, step)
+    result = run_window(action, step)
     metrics = result.metrics
     state = metrics.feature_vector
 
@@ -67,11 +92,16 @@ def main() -> None:
             "prefetch_accuracy": metrics.prefetch_accuracy,
             "branch_miss_rate": metrics.branch_miss_rate,
             "stats_path": str(result.stats_path),
-            "cache_path": str(result.cache_path),
+            "cache_path": str(result.cache_path) if result.cache_path else None,
         }
     )
     print(f"[step {step}] action={action.values} IPC={metrics.ipc:.6f}")
 
+  if args.continuous:
+    session.close()
+  else:
+    runner.scheduler.shutdown()
+
   summary_path = args.output / "episode_summary.json"
   with summary_path.open("w", encoding="utf-8") as handle:
     json.dump(episode_log, handle, indent=2)
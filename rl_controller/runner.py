@@ -1,13 +1,19 @@
 from __future__ import annotations
 
+import hashlib
+import json
+import os
 import shutil
 import subprocess
+import threading
+from concurrent.futures import Future
 from dataclasses import dataclass
 from pathlib import Path
-from typing import Mapping, Optional
+from typing import Optional, Tuple
 
 from .action_space import Action, ActionSpace
-from .builder import ChampSimBuildManager
+from .builder import BuildResult, ChampSimBuildManager
+from .scheduler import JobScheduler, binary_identity, file_digest
 from .state import WindowMetrics, parse_stats_json
 
 
@@ -16,11 +22,18 @@ class RunResult:
   action: Action
   metrics: WindowMetrics
   stats_path: Path
-  cache_path: Path
+  cache_path: Optional[Path] = None  # windows of a continuous session have no checkpoint
 
 
 class ChampSimRunner:
-  """Execute ChampSim windows under RL control."""
+  """Execute ChampSim windows under RL control.
+
+  Windows are queued on a JobScheduler, so ``submit_window`` returns at once
+  and many windows, builds, and warmups can be in flight together.  The stats
+  and final cache contents of each window are kept in ``output_dir/memo``
+  under a hash of the binary, the starting checkpoint's contents, and the
+  window, so an identical window is never simulated twice.
+  """
 
   def __init__(
       self,
@@ -32,6 +45,7 @@ class ChampSimRunner:
       output_dir: Path,
       shared_base: bool,
       resume_warmup: int,
+      scheduler: Optional[JobScheduler] = None,
   ):
     self.repo_root = repo_root
     self.build_manager = build_manager
@@ -40,23 +54,28 @@ class ChampSimRunner:
     self.window_instructions = window_instructions
     self.output_dir = output_dir
     self.output_dir.mkdir(parents=True, exist_ok=True)
+    self.memo_dir = output_dir / "memo"
+    self.memo_dir.mkdir(parents=True, exist_ok=True)
     self.shared_base = shared_base
     self.resume_warmup = resume_warmup
-    self._shared_checkpoint: Path | None = None
-    self._action_checkpoints: dict[str, Path] = {}
+    self.scheduler = scheduler or JobScheduler()
+    self._shared_checkpoint: Optional[Future] = None
+    self._action_checkpoints: dict[str, Future] = {}
 
   def initialise_checkpoint(self, base_action: Action, action_space: ActionSpace) -> Path:
     """Generate (or reuse) the baseline cache checkpoint."""
     if self.shared_base:
       if self._shared_checkpoint is None:
-        self._shared_checkpoint = self._create_checkpoint(base_action, action_space, suffix="base")
-      return self._shared_checkpoint
+        self._shared_checkpoint = self._submit_checkpoint(base_action, action_space, suffix="base")
+      return self._shared_checkpoint.result()
 
     # Per-action warmup still benefits from caching the base policy
-    key = self._action_key(base_action)
-    if key not in self._action_checkpoints:
-      self._action_checkpoints[key] = self._create_checkpoint(base_action, action_space, suffix=f"warm_{key}")
-    return self._action_checkpoints[key]
+    return self._action_checkpoint(base_action, action_space).result()
+
+  def submit_build(self, action: Action, action_space: ActionSpace) -> Future:
+    """Queue the build of the binary for an action, resolving to a BuildResult."""
+    updates = action.as_config_updates(action_space.heads)
+    return self.scheduler.submit_build(tuple(sorted(updates.items())), lambda: self.build_manager.ensure_binary(updates))
 
   def run_window(
       self,
@@ -65,54 +84,107 @@ class ChampSimRunner:
       base_checkpoint: Path,
       step: int,
   ) -> RunResult:
-    updates = action.as_config_updates(action_space.heads)
-    build = self.build_manager.ensure_binary(updates)
+    return self.submit_window(action, action_space, base_checkpoint, step).result()
 
+  def submit_window(
+      self,
+      action: Action,
+      action_space: ActionSpace,
+      base_checkpoint: Path,
+      step: int,
+  ) -> Future:
+    """Queue a measurement window, resolving to a RunResult."""
     if self.shared_base:
-      source_checkpoint = self._shared_checkpoint or base_checkpoint
+      source = self._shared_checkpoint or _completed(base_checkpoint)
+      source_key = "shared"
     else:
-      action_key = self._action_key(action)
-      source_checkpoint = self._action_checkpoints.get(action_key)
-      if source_checkpoint is None:
-        source_checkpoint = self._create_checkpoint(action, action_space, suffix=f"warm_{action_key}")
-        self._action_checkpoints[action_key] = source_checkpoint
+      source = self._action_checkpoint(action, action_space)
+      source_key = self._action_key(action)
 
-    cache_path = self.output_dir / f"iter_{step:04d}_cache.log"
-    shutil.copy2(source_checkpoint, cache_path)
-
-    stats_path = self.output_dir / f"iter_{step:04d}_stats.json"
-    cmd = (
-        f"{build.binary_path} "
-        f"--warmup-instructions {self.resume_warmup} "
-        f"--simulation-instructions {self.window_instructions} "
-        f"--subtrace-count 1 "
-        f"--cache-checkpoint {cache_path} "
-        f"--json {stats_path} "
-        f"{self.trace_path}"
+    updates = action.as_config_updates(action_space.heads)
+    window = self.scheduler.submit(
+        ("window", tuple(sorted(updates.items())), source_key, self.resume_warmup, self.window_instructions),
+        self._simulate_window,
+        after=[self.submit_build(action, action_space), source],
     )
-    subprocess.run(["bash", "-lc", cmd], cwd=self.repo_root, check=True)
+    return self.scheduler.submit(None, lambda memo: self._copy_window(action, memo, step), after=[window], memory_mb=0)
 
-    metrics = parse_stats_json(stats_path)
-    return RunResult(action=action, metrics=metrics, stats_path=stats_path, cache_path=cache_path)
+  def _action_checkpoint(self, action: Action, action_space: ActionSpace) -> Future:
+    key = self._action_key(action)
+    if key not in self._action_checkpoints:
+      self._action_checkpoints[key] = self._submit_checkpoint(action, action_space, suffix=f"warm_{key}")
+    return self._action_checkpoints[key]
 
-  def _create_checkpoint(self, action: Action, action_space: ActionSpace, suffix: str) -> Path:
+  def _submit_checkpoint(self, action: Action, action_space: ActionSpace, suffix: str) -> Future:
     updates = action.as_config_updates(action_space.heads)
-    build = self.build_manager.ensure_binary(updates)
+    return self.scheduler.submit(
+        ("checkpoint", tuple(sorted(updates.items())), self.warmup_instructions),
+        lambda build: self._create_checkpoint(build, suffix),
+        after=[self.submit_build(action, action_space)],
+    )
+
+  def _simulate_window(self, build: BuildResult, source_checkpoint: Path) -> Tuple[Path, Path]:
+    """Run a window from a checkpoint, unless an identical one has already run, and return its memoized stats and cache contents."""
+    identity = json.dumps([
+        binary_identity(build.binary_path),
+        build.extra_args,
+        file_digest(source_checkpoint),
+        self.resume_warmup,
+        self.window_instructions,
+        str(self.trace_path),
+    ])
+    digest = hashlib.sha256(identity.encode("utf-8")).hexdigest()[:32]
+    stats_path = self.memo_dir / f"{digest}_stats.json"
+    cache_path = self.memo_dir / f"{digest}_cache.log"
+    if stats_path.exists() and cache_path.exists():
+      return stats_path, cache_path
+
+    # Identical windows reached through different keys may run at once, so each writes its own files and the last rename wins
+    scratch = f"{digest}_{threading.get_ident()}"
+    scratch_stats = self.memo_dir / f"{scratch}_stats.json"
+    scratch_cache = self.memo_dir / f"{scratch}_cache.log"
+    shutil.copy2(source_checkpoint, scratch_cache)
+    self._simulate(
+        build,
+        f"--warmup-instructions {self.resume_warmup}",
+        f"--simulation-instructions {self.window_instructions}",
+        f"--cache-checkpoint {scratch_cache}",
+        f"--json {scratch_stats}",
+    )
+    os.replace(scratch_cache, cache_path)
+    os.replace(scratch_stats, stats_path)
+    return stats_path, cache_path
+
+  def _copy_window(self, action: Action, memo: Tuple[Path, Path], step: int) -> RunResult:
+    memo_stats, memo_cache = memo
+    stats_path = self.output_dir / f"iter_{step:04d}_stats.json"
+    cache_path = self.output_dir / f"iter_{step:04d}_cache.log"
+    shutil.copy2(memo_stats, stats_path)
+    shutil.copy2(memo_cache, cache_path)
+    return RunResult(action=action, metrics=parse_stats_json(stats_path), stats_path=stats_path, cache_path=cache_path)
 
+  def _create_checkpoint(self, build: BuildResult, suffix: str) -> Path:
     checkpoint_path = self.output_dir / f"{suffix}_cache.log"
     json_path = self.output_dir / f"{suffix}_warmup.json"
-    cmd = (
-        f"{build.binary_path} "
-        f"--warmup-instructions {self.warmup_instructions} "
-        f"--simulation-instructions 0 "
-        f"--subtrace-count 1 "
-        f"--cache-checkpoint {checkpoint_path} "
-        f"--json {json_path} "
-        f"{self.trace_path}"
+    self._simulate(
+        build,
+        f"--warmup-instructions {self.warmup_instructions}",
+        "--simulation-instructions 0",
+        f"--cache-checkpoint {checkpoint_path}",
+        f"--json {json_path}",
     )
-    subprocess.run(["bash", "-lc", cmd], cwd=self.repo_root, check=True)
     return checkpoint_path
 
+  def _simulate(self, build: BuildResult, *options: str) -> None:
+    cmd = " ".join([str(build.binary_path), *build.extra_args, *options, "--subtrace-count 1", str(self.trace_path)])
+    subprocess.run(["bash", "-lc", cmd], cwd=self.repo_root, check=True)
+
   @staticmethod
   def _action_key(action: Action) -> str:
     return "_".join(f"{k}-{v}" for k, v in sorted(action.values.items()))
+
+
+def _completed(value) -> Future:
+  future: Future = Future()
+  future.set_result(value)
+  return future
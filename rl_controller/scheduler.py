@@ -0,0 +1,166 @@
+from __future__ import annotations
+
+import hashlib
+import os
+import threading
+from concurrent.futures import Future, ThreadPoolExecutor
+from pathlib import Path
+from typing import Callable, Dict, Hashable, Iterable, Optional, Sequence, TypeVar
+
+T = TypeVar("T")
+
+
+def physical_memory_mb() -> int:
+  try:
+    return os.sysconf("SC_PAGE_SIZE") * os.sysconf("SC_PHYS_PAGES") // (1024 * 1024)
+  except (ValueError, OSError, AttributeError):  # pragma: no cover - platforms without sysconf
+    return 0
+
+
+def file_digest(path: Path) -> str:
+  """Hash the contents of a file, so that identical checkpoints at different paths match."""
+  digest = hashlib.sha256()
+  with path.open("rb") as handle:
+    for chunk in iter(lambda: handle.read(1 << 20), b""):
+      digest.update(chunk)
+  return digest.hexdigest()
+
+
+def binary_identity(path: Path) -> str:
+  """Identify a binary by path and modification, so that a rebuilt binary does not match its old results."""
+  stat = path.stat()
+  return f"{path.resolve()}:{stat.st_size}:{stat.st_mtime_ns}"
+
+
+class JobScheduler:
+  """Run ChampSim jobs concurrently across the host's cores.
+
+  * Jobs start once the futures they depend on have finished, so a window can
+    be queued before its binary is built or its checkpoint is warmed.
+  * Jobs declare how much memory they need, and no job starts while the sum
+    for running jobs would exceed the budget.  A job larger than the whole
+    budget runs alone.
+  * Jobs with the same key share one future, so identical work runs once.
+  * Builds run one at a time, since each reconfigures the shared tree, but
+    overlap with simulations.
+  """
+
+  def __init__(
+      self,
+      max_jobs: Optional[int] = None,
+      memory_budget_mb: Optional[int] = None,
+      job_memory_mb: int = 1024,
+  ):
+    self.max_jobs = max_jobs or os.cpu_count() or 1
+    self.memory_budget_mb = memory_budget_mb if memory_budget_mb is not None else int(physical_memory_mb() * 0.8)
+    self.job_memory_mb = job_memory_mb
+    self._jobs = ThreadPoolExecutor(max_workers=self.max_jobs, thread_name_prefix="champsim-job")
+    self._builds = ThreadPoolExecutor(max_workers=1, thread_name_prefix="champsim-build")
+    self._memory = threading.Condition()
+    self._memory_in_use = 0
+    self._memo_lock = threading.Lock()
+    self._memo: Dict[Hashable, Future] = {}
+
+  def submit_build(self, key: Hashable, fn: Callable[[], T]) -> Future:
+    """Queue a build.  Builds with the same key are done once."""
+    return self._memoize(("build", key), lambda: self._builds.submit(fn))
+
+  def submit(
+      self,
+      key: Optional[Hashable],
+      fn: Callable[..., T],
+      after: Sequence[Future] = (),
+      memory_mb: Optional[int] = None,
+  ) -> Future:
+    """Queue a job, which is called with the results of ``after`` once they finish.
+
+    A job whose key matches an earlier job is not run again; the earlier
+    job's future is returned instead.  A key of None is never matched.
+    """
+    memory = self.job_memory_mb if memory_mb is None else memory_mb
+
+    def start() -> Future:
+      result: Future = Future()
+      self._when_done(list(after), lambda values: self._launch(result, fn, values, memory), result)
+      return result
+
+    if key is None:
+      return start()
+    return self._memoize(("job", key), start)
+
+  def shutdown(self) -> None:
+    self._builds.shutdown(wait=True)
+    self._jobs.shutdown(wait=True)
+
+  def __enter__(self) -> "JobScheduler":
+    return self
+
+  def __exit__(self, *exc_info) -> None:
+    self.shutdown()
+
+  def _memoize(self, key: Hashable, start: Callable[[], Future]) -> Future:
+    with self._memo_lock:
+      if key not in self._memo:
+        self._memo[key] = start()
+      return self._memo[key]
+
+  @staticmethod
+  def _when_done(dependencies: Iterable[Future], then: Callable[[list], None], result: Future) -> None:
+    # Chain on callbacks instead of waiting in a worker, so queued jobs never hold a worker that their dependencies need
+    pending = list(dependencies)
+    if not pending:
+      then([])
+      return
+
+    remaining = [len(pending)]
+    lock = threading.Lock()
+
+    def on_done(_: Future) -> None:
+      with lock:
+        remaining[0] -= 1
+        if remaining[0] > 0:
+          return
+      failure = next((dep.exception() for dep in pending if dep.exception() is not None), None)
+      if failure is not None:
+        result.set_exception(failure)
+      else:
+        then([dep.result() for dep in pending])
+
+    for dep in pending:
+      dep.add_done_callback(on_done)
+
+  def _launch(self, result: Future, fn: Callable[..., T], values: list, memory_mb: int) -> None:
+    def run() -> None:
+      self._reserve(memory_mb)
+      try:
+        result.set_result(fn(*values))
+      except BaseException as exc:  # pylint: disable=broad-except
+        result.set_exception(exc)
+      finally:
+        self._release(memory_mb)
+
+    self._jobs.submit(run)
+
+  def _reserve(self, memory_mb: int) -> None:
+    needed = min(memory_mb, self.memory_budget_mb) if self.memory_budget_mb > 0 else 0
+    with self._memory:
+      self._memory.wait_for(lambda: self._memory_in_use + needed <= self.memory_budget_mb or self._memory_in_use == 0)
+      self._memory_in_use += needed
+
+  def _release(self, memory_mb: int) -> None:
+    needed = min(memory_mb, self.memory_budget_mb) if self.memory_budget_mb > 0 else 0
+    with self._memory:
+      self._memory_in_use -= needed
+      self._memory.notify_all()
+
+
+def add_scheduler_arguments(parser) -> None:
+  parser.add_argument("--jobs", type=int, default=None, help="Simulations to run at once (default: one per core)")
+  parser.add_argument(
+      "--memory-budget", type=int, default=None, help="Memory in MiB that running simulations may use together (default: 80%% of RAM)"
+  )
+  parser.add_argument("--job-memory", type=int, default=1024, help="Memory in MiB to set aside for each simulation")
+
+
+def scheduler_from_args(args) -> JobScheduler:
+  return JobScheduler(max_jobs=args.jobs, memory_budget_mb=args.memory_budget, job_memory_mb=args.job_memory)
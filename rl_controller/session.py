@@ -0,0 +1,135 @@
+from __future__ import annotations
+
+import json
+import os
+import subprocess
+from pathlib import Path
+from typing import IO, Mapping, Optional
+
+from .action_space import Action, ActionSpace
+from .builder import ChampSimBuildManager, is_module_choice, module_selection
+from .runner import RunResult
+from .state import _phase_metrics
+
+
+class ChampSimSession:
+  """Run a whole episode in one ChampSim process.
+
+  The simulator warms up once, then runs one phase per step.  Between phases it
+  writes the statistics of the phase to a named pipe and waits on another for
+  the next action (see ``--control-in`` and ``--control-out``), so no step
+  restores a checkpoint or replays the trace prefix.  Only prefetcher and
+  replacement actions can change during an episode.
+  """
+
+  def __init__(
+      self,
+      repo_root: Path,
+      build_manager: ChampSimBuildManager,
+      trace_path: Path,
+      warmup_instructions: int,
+      window_instructions: int,
+      steps: int,
+      output_dir: Path,
+  ):
+    if not build_manager.runtime_modules:
+      raise ValueError("A continuous session needs a build manager with runtime_modules enabled")
+    self.repo_root = repo_root
+    self.build_manager = build_manager
+    self.trace_path = trace_path
+    self.warmup_instructions = warmup_instructions
+    self.window_instructions = window_instructions
+    self.steps = steps
+    self.output_dir = output_dir
+    self.output_dir.mkdir(parents=True, exist_ok=True)
+    self._process: Optional[subprocess.Popen] = None
+    self._commands: Optional[IO[str]] = None
+    self._replies: Optional[IO[str]] = None
+    self._binary: Optional[Path] = None
+
+  def start(self, base_action: Action, action_space: ActionSpace) -> None:
+    """Launch the simulator with the base action and wait for the warmup to finish."""
+    build = self.build_manager.ensure_binary(base_action.as_config_updates(action_space.heads))
+    self._binary = build.binary_path
+
+    command_pipe = self.output_dir / "control_in"
+    reply_pipe = self.output_dir / "control_out"
+    for pipe in (command_pipe, reply_pipe):
+      if pipe.exists():
+        pipe.unlink()
+      os.mkfifo(pipe)
+
+    log_path = self.output_dir / "session.log"
+    with log_path.open("w", encoding="utf-8") as log:
+      self._process = subprocess.Popen(
+          [
+              str(build.binary_path),
+              *build.extra_args,
+              "--warmup-instructions", str(self.warmup_instructions),
+              "--simulation-instructions", str(self.window_instructions),
+              "--subtrace-count", str(self.steps),
+              "--control-in", str(command_pipe),
+              "--control-out", str(reply_pipe),
+              str(self.trace_path),
+          ],
+          cwd=self.repo_root,
+          stdout=log,
+          stderr=subprocess.STDOUT,
+      )
+
+    # Open the pipes in the same order as the simulator, or both sides wait forever
+    self._commands = command_pipe.open("w", encoding="utf-8")
+    self._replies = reply_pipe.open("r", encoding="utf-8")
+    self._read_line()  # the warmup phase
+
+  def run_window(self, action: Action, action_space: ActionSpace, step: int) -> RunResult:
+    updates = action.as_config_updates(action_space.heads)
+    fixed = {k: v for k, v in updates.items() if not is_module_choice(k)}
+    if self.build_manager.ensure_binary(fixed).binary_path != self._binary:
+      raise ValueError(f"Action {action.values} needs a different binary, which a continuous session cannot switch to")
+
+    self._send(json.dumps(module_selection({k: v for k, v in updates.items() if is_module_choice(k)})))
+    reply = self._read_line()
+    if "error" in reply:
+      raise ValueError(f"ChampSim rejected action {action.values}: {reply['error']}")
+
+    self._send("continue")
+    phase = self._read_line()
+
+    stats_path = self.output_dir / f"iter_{step:04d}_stats.json"
+    with stats_path.open("w", encoding="utf-8") as handle:
+      json.dump([phase], handle, indent=2)
+
+    return RunResult(action=action, metrics=_phase_metrics(phase["sim"]), stats_path=stats_path)
+
+  def close(self) -> None:
+    if self._process is None:
+      return
+    if self._commands is not None:
+      try:
+        self._send("stop")
+      except BrokenPipeError:
+        pass
+      self._commands.close()
+    if self._replies is not None:
+      self._replies.close()
+    self._process.wait()
+    self._process = None
+
+  def __enter__(self) -> "ChampSimSession":
+    return self
+
+  def __exit__(self, *exc_info) -> None:
+    self.close()
+
+  def _send(self, line: str) -> None:
+    assert self._commands is not None
+    self._commands.write(line + "\n")
+    self._commands.flush()
+
+  def _read_line(self) -> Mapping:
+    assert self._replies is not None
+    line = self._replies.readline()
+    if not line:
+      raise RuntimeError(f"ChampSim ended the session early; see {self.output_dir / 'session.log'}")
+    return json.loads(line)
@@ -45,7 +45,24 @@ def parse_stats_json(stats_path: Path) -> WindowMetrics:
   if not data:
     raise ValueError(f"Stats file {stats_path} is empty")
 
-  phase = data[0]["sim"]
+  return _phase_metrics(data[0]["sim"])
+
+
+def parse_interval_stats(stats_path: Path) -> List[WindowMetrics]:
+  """Read a --interval-stats stream, one WindowMetrics per interval outside warmup."""
+  windows = []
+  with stats_path.open("r", encoding="utf-8") as handle:
+    for line in handle:
+      if not line.strip():
+        continue
+      interval = json.loads(line)
+      if interval.get("warmup", False):
+        continue
+      windows.append(_phase_metrics(interval["sim"]))
+  return windows
+
+
+def _phase_metrics(phase: Mapping) -> WindowMetrics:
   core = phase["cores"][0]
   instructions = float(core.get("instructions", 0))
   cycles = float(core.get("cycles", 0))
@@ -41,7 +41,7 @@ CACHE::CACHE(CACHE&& other)
       cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
       HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
       MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
-      pref_activate_mask(std::move(other.pref_activate_mask)),
+      pref_activate_mask(std::move(other.pref_activate_mask)), ip_attribution_size(other.ip_attribution_size),
 
       sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
 
@@ -80,6 +80,7 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   this->match_offset_bits = other.match_offset_bits;
   this->virtual_prefetch = other.virtual_prefetch;
   this->pref_activate_mask = std::move(other.pref_activate_mask);
+  this->ip_attribution_size = other.ip_attribution_size;
 
   this->sim_stats = std::move(other.sim_stats);
   this->roi_stats = std::move(other.roi_stats);
@@ -101,7 +102,7 @@ CACHE::tag_lookup_type::tag_lookup_type(const request_type& req, bool local_pref
 
 CACHE::mshr_type::mshr_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued)
     : address(req.address), v_address(req.v_address), ip(req.ip), instr_id(req.instr_id), cpu(req.cpu), type(req.type),
-      prefetch_from_this(req.prefetch_from_this), time_enqueued(_time_enqueued), instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
+      prefetch_from_this(req.prefetch_from_this), prefetch_ip(req.prefetch_ip), time_enqueued(_time_enqueued), instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
 {
 }
 
@@ -149,6 +150,7 @@ auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
   to_fill.v_address = mshr.v_address;
   to_fill.data = mshr.data_promise->data;
   to_fill.pf_metadata = metadata;
+  to_fill.prefetch_ip = mshr.prefetch_ip;
 
   return to_fill;
 }
@@ -226,6 +228,12 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
   if (way != set_end) {
     if (way->valid && way->prefetch) {
       ++sim_stats.pf_useless;
+      // Prefetches issued outside of an access have no triggering instruction
+      if (way->prefetch_ip == champsim::address{}) {
+        sim_stats.top_ips.record_untriggered_useless_prefetch();
+      } else {
+        sim_stats.top_ips.record_useless_prefetch(way->prefetch_ip);
+      }
     }
 
     if (fill_mshr.type == access_type::PREFETCH) {
@@ -236,8 +244,12 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
   }
 
   // COLLECT STATS
-  if (fill_mshr.type != access_type::PREFETCH)
-    sim_stats.total_miss_latency_cycles += (current_time - (fill_mshr.time_enqueued + clock_period)) / clock_period;
+  if (fill_mshr.type != access_type::PREFETCH) {
+    const auto miss_latency = (current_time - (fill_mshr.time_enqueued + clock_period)) / clock_period;
+    sim_stats.total_miss_latency_cycles += miss_latency;
+    sim_stats.miss_latency.record(miss_latency);
+    sim_stats.top_ips.record_miss_latency(fill_mshr.ip, miss_latency);
+  }
   sim_stats.mshr_return.increment(std::pair{fill_mshr.type, fill_mshr.cpu});
 
   response_type response{fill_mshr.address, fill_mshr.v_address, fill_mshr.data_promise->data, metadata_thru, fill_mshr.instr_depend_on_me};
@@ -266,7 +278,9 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
   auto metadata_thru = handle_pkt.pf_metadata;
   if (should_activate_prefetcher(handle_pkt)) {
+    prefetch_trigger_ip = handle_pkt.ip;
     metadata_thru = impl_prefetcher_cache_operate(module_address(handle_pkt), handle_pkt.ip, hit, useful_prefetch, handle_pkt.type, metadata_thru);
+    prefetch_trigger_ip = champsim::address{};
   }
 
   // update replacement policy
@@ -342,6 +356,11 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
       // Mark the prefetch as useful
       if (mshr_entry->prefetch_from_this) {
         ++sim_stats.pf_useful;
+        if (mshr_entry->prefetch_ip == champsim::address{}) {
+          sim_stats.top_ips.record_untriggered_late_prefetch();
+        } else {
+          sim_stats.top_ips.record_late_prefetch(mshr_entry->prefetch_ip);
+        }
       }
     }
 
@@ -368,6 +387,9 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
   }
 
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  if (handle_pkt.type != access_type::PREFETCH) {
+    sim_stats.top_ips.record_miss(handle_pkt.ip);
+  }
 
   return true;
 }
@@ -591,6 +613,7 @@ bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint3
   pf_packet.is_translated = !virtual_prefetch;
 
   internal_PQ.emplace_back(pf_packet, true, !fill_this_level);
+  internal_PQ.back().prefetch_ip = prefetch_trigger_ip;
   ++sim_stats.pf_issued;
 
   return true;
@@ -807,13 +830,20 @@ uint32_t CACHE::impl_prefetcher_cache_fill(champsim::address addr, long set, lon
   return pref_module_pimpl->impl_prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in);
 }
 
-void CACHE::impl_prefetcher_cycle_operate() const { pref_module_pimpl->impl_prefetcher_cycle_operate(); }
+void CACHE::impl_prefetcher_cycle_operate() const
+{
+  if (pref_module_pimpl->calls_cycle_operate) {
+    pref_module_pimpl->impl_prefetcher_cycle_operate();
+  }
+}
 
 void CACHE::impl_prefetcher_final_stats() const { pref_module_pimpl->impl_prefetcher_final_stats(); }
 
 void CACHE::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) const
 {
-  pref_module_pimpl->impl_prefetcher_branch_operate(ip, branch_type, branch_target);
+  if (pref_module_pimpl->calls_branch_operate) {
+    pref_module_pimpl->impl_prefetcher_branch_operate(ip, branch_type, branch_target);
+  }
 }
 
 void CACHE::impl_initialize_replacement() const { repl_module_pimpl->impl_initialize_replacement(); }
@@ -851,6 +881,7 @@ void CACHE::begin_phase()
 
   new_roi_stats.name = NAME;
   new_sim_stats.name = NAME;
+  new_sim_stats.top_ips = champsim::stats::ip_attribution{ip_attribution_size};
 
   roi_stats = new_roi_stats;
   sim_stats = new_sim_stats;
@@ -867,6 +898,7 @@ void CACHE::end_phase(unsigned finished_cpu)
 {
   finished_cpu = finished_cpu;
   roi_stats.total_miss_latency_cycles = sim_stats.total_miss_latency_cycles;
+  roi_stats.miss_latency = sim_stats.miss_latency;
 
   roi_stats.hits = sim_stats.hits;
   roi_stats.misses = sim_stats.misses;
@@ -879,6 +911,8 @@ void CACHE::end_phase(unsigned finished_cpu)
   roi_stats.pf_useless = sim_stats.pf_useless;
   roi_stats.pf_fill = sim_stats.pf_fill;
 
+  roi_stats.top_ips = sim_stats.top_ips;
+
   for (auto* ul : upper_levels) {
     ul->roi_stats.RQ_ACCESS = ul->sim_stats.RQ_ACCESS;
     ul->roi_stats.RQ_MERGED = ul->sim_stats.RQ_MERGED;
@@ -962,16 +996,35 @@ void CACHE::restore_checkpoint(const std::vector<checkpoint_entry>& entries)
     const auto block_index = static_cast<std::size_t>(entry.set) * static_cast<std::size_t>(NUM_WAY) + static_cast<std::size_t>(entry.way);
     block.at(block_index) = entry.block;
 
-    if (!entry.block.valid) {
-      continue;
+    if (entry.block.valid) {
+      replay_fill(entry.set, entry.way, entry.block);
     }
+  }
+}
 
-    auto module_addr = virtual_prefetch ? entry.block.v_address : entry.block.address;
-    auto trimmed_addr = module_addr.slice_upper(match_offset_bits ? champsim::data::bits{} : OFFSET_BITS);
-    champsim::address cache_addr{trimmed_addr};
+void CACHE::replay_fill(long set, long way, const BLOCK& blk) const
+{
+  auto module_addr = virtual_prefetch ? blk.v_address : blk.address;
+  auto trimmed_addr = module_addr.slice_upper(match_offset_bits ? champsim::data::bits{} : OFFSET_BITS);
+  champsim::address cache_addr{trimmed_addr};
+
+  auto type = blk.prefetch ? access_type::PREFETCH : (blk.dirty ? access_type::WRITE : access_type::LOAD);
+  impl_replacement_cache_fill(cpu, set, way, cache_addr, champsim::address{}, champsim::address{}, type);
+}
+
+void CACHE::switch_prefetcher(std::unique_ptr<prefetcher_module_concept> pref)
+{
+  pref_module_pimpl = std::move(pref);
+  impl_prefetcher_initialize();
+}
+
+void CACHE::switch_replacement(std::unique_ptr<replacement_module_concept> repl)
+{
+  repl_module_pimpl = std::move(repl);
+  impl_initialize_replacement();
 
-    auto type = entry.block.prefetch ? access_type::PREFETCH : (entry.block.dirty ? access_type::WRITE : access_type::LOAD);
-    impl_replacement_cache_fill(cpu, entry.set, entry.way, cache_addr, champsim::address{}, champsim::address{}, type);
+  for (const auto& entry : checkpoint_contents()) {
+    replay_fill(entry.set, entry.way, entry.block);
   }
 }
 
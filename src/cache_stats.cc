@@ -3,6 +3,7 @@
 cache_stats operator-(cache_stats lhs, cache_stats rhs)
 {
   cache_stats result;
+  result.name = lhs.name;
   result.pf_requested = lhs.pf_requested - rhs.pf_requested;
   result.pf_issued = lhs.pf_issued - rhs.pf_issued;
   result.pf_useful = lhs.pf_useful - rhs.pf_useful;
@@ -11,7 +12,11 @@ cache_stats operator-(cache_stats lhs, cache_stats rhs)
 
   result.hits = lhs.hits - rhs.hits;
   result.misses = lhs.misses - rhs.misses;
+  result.mshr_merge = lhs.mshr_merge - rhs.mshr_merge;
+  result.mshr_return = lhs.mshr_return - rhs.mshr_return;
 
   result.total_miss_latency_cycles = lhs.total_miss_latency_cycles - rhs.total_miss_latency_cycles;
+  result.miss_latency = lhs.miss_latency - rhs.miss_latency;
+  result.top_ips = lhs.top_ips - rhs.top_ips;
   return result;
 }
@@ -18,17 +18,22 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <numeric>
+#include <string>
 #include <vector>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
 #include "cache_checkpoint.h"
 #include "environment.h"
+#include "interval_stats.h"
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "phase_info.h"
+#include "policy_control.h"
 #include "tracereader.h"
+#include "util/to_underlying.h"
 
 constexpr int DEADLOCK_CYCLE{500};
 
@@ -38,31 +43,88 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 
 namespace champsim
 {
-long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index, champsim::chrono::clock& global_clock)
+long environment::operate_on(const champsim::chrono::clock& clock)
 {
-  auto operables = env.operable_view();
+  auto operables = operable_view();
   std::sort(std::begin(operables), std::end(operables),
             [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
 
-  // Operate
   long progress{0};
   for (champsim::operable& op : operables) {
-    progress += op.operate_on(global_clock);
+    progress += op.operate_on(clock);
   }
 
+  return progress;
+}
+
+long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index, champsim::chrono::clock& global_clock)
+{
+  // Operate
+  long progress = env.operate_on(global_clock);
+
   // Read from trace
   for (O3_CPU& cpu : env.cpu_view()) {
     auto& trace = traces.at(trace_index.at(cpu.cpu));
-    for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0; --pkt_count) {
-      cpu.input_queue.push_back(trace());
-    }
+    trace.host_time.measure([&cpu, &trace] {
+      auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue));
+      for (; !trace.eof() && pkt_count > 0; --pkt_count) {
+        cpu.input_queue.push_back(trace());
+      }
+      return pkt_count;
+    });
   }
 
   return progress;
 }
 
+namespace
+{
+struct host_time_source {
+  std::string name;
+  host_time_sampler sampler;
+  std::size_t num_inner = 0; // the number of sources listed just before this one that operate from within it
+};
+
+std::vector<host_time_source> host_time_samplers(environment& env, const std::vector<tracereader>& traces)
+{
+  std::vector<host_time_source> retval{};
+  for (const O3_CPU& cpu : env.cpu_view()) {
+    retval.push_back({"cpu" + std::to_string(cpu.cpu), cpu.host_time});
+  }
+  for (const CACHE& cache : env.cache_view()) {
+    retval.push_back({cache.NAME, cache.host_time});
+  }
+  for (const PageTableWalker& ptw : env.ptw_view()) {
+    retval.push_back({ptw.NAME, ptw.host_time});
+  }
+
+  // The channels operate from within the controller, but the controller skips idle channels, so their samples are not taken within the controller's
+  // samples. The controller's own time is found from the scaled estimates instead.
+  auto& dram = env.dram_view();
+  std::size_t chan_idx = 0;
+  for (const auto& chan : dram.channels) {
+    retval.push_back({"DRAM Channel " + std::to_string(chan_idx++), chan.host_time});
+  }
+  retval.push_back({"DRAM", dram.host_time, std::size(dram.channels)});
+
+  host_time_sampler trace_time{};
+  for (const auto& trace : traces) {
+    trace_time.calls += trace.host_time.calls;
+    trace_time.samples += trace.host_time.samples;
+    trace_time.sampled += trace.host_time.sampled;
+    trace_time.counted += trace.host_time.counted;
+  }
+  retval.push_back({"tracereader", trace_time});
+
+  return retval;
+}
+} // namespace
+
 phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock)
 {
+  const auto phase_start_time = std::chrono::steady_clock::now();
+  const auto phase_start_samplers = host_time_samplers(env, traces);
+
   auto operables = env.operable_view();
   const auto& phase_name = phase.name;
   const auto is_warmup = phase.is_warmup;
@@ -86,6 +148,24 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   std::vector<double> livelock_threshold{0.01, 0.02, 0.05};
   std::vector<uint64_t> livelock_instr(std::size(env.cpu_view()), 0);
 
+  const bool intervals_enabled = (phase.stats_interval > 0 && phase.interval_sink != nullptr);
+  auto interval_cpus = env.cpu_view();
+  auto phase_instructions = [&interval_cpus] {
+    return std::accumulate(std::begin(interval_cpus), std::end(interval_cpus), 0LL,
+                           [](auto acc, const O3_CPU& cpu) { return acc + static_cast<long long>(cpu.sim_instr()); });
+  };
+  // Each CPU retires at most its retire width in a cycle, so the retire counts need not be summed until enough cycles have passed to reach the
+  // end of the interval
+  const auto retire_width = std::accumulate(std::begin(interval_cpus), std::end(interval_cpus), 0LL, [](auto acc, const O3_CPU& cpu) {
+    return acc + static_cast<long long>(champsim::to_underlying(cpu.RETIRE_WIDTH));
+  });
+  const auto max_retire_per_cycle = std::max(1LL, retire_width);
+  auto cycles_until = [max_retire_per_cycle](long long instructions) { return (instructions + max_retire_per_cycle - 1) / max_retire_per_cycle; };
+  uint64_t interval_index{0};
+  long long interval_begin{0};
+  long long interval_end{phase.stats_interval};
+  long long interval_countdown{cycles_until(interval_end)};
+
   // Perform phase
   int stalled_cycle{0};
   std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
@@ -95,6 +175,16 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
 
     auto progress = do_cycle(env, traces, trace_index, global_clock);
 
+    if (intervals_enabled && --interval_countdown <= 0) {
+      auto retired = phase_instructions();
+      if (retired >= interval_end) {
+        phase.interval_sink->push(take_interval_snapshot(env, phase_name, is_warmup, interval_index++));
+        interval_begin = retired;
+        interval_end = interval_begin + phase.stats_interval;
+      }
+      interval_countdown = cycles_until(interval_end - retired);
+    }
+
     if (progress == 0) {
       ++stalled_cycle;
     } else {
@@ -165,6 +255,11 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     }
   }
 
+  // The last interval of the phase may be short
+  if (intervals_enabled && phase_instructions() > interval_begin) {
+    phase.interval_sink->push(take_interval_snapshot(env, phase_name, is_warmup, interval_index++));
+  }
+
   phase_stats stats;
   stats.name = phase.name;
 
@@ -180,12 +275,30 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
   std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
 
+  auto ptws = env.ptw_view();
+  std::transform(std::begin(ptws), std::end(ptws), std::back_inserter(stats.sim_ptw_stats), [](const PageTableWalker& ptw) { return ptw.sim_stats; });
+  std::transform(std::begin(ptws), std::end(ptws), std::back_inserter(stats.roi_ptw_stats), [](const PageTableWalker& ptw) { return ptw.roi_stats; });
+
   auto dram = env.dram_view();
   std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
                  [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
   std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
                  [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
 
+  stats.host_profile.elapsed = std::chrono::steady_clock::now() - phase_start_time;
+  stats.host_profile.instructions =
+      std::accumulate(std::begin(stats.sim_cpu_stats), std::end(stats.sim_cpu_stats), 0LL, [](auto acc, const auto& x) { return acc + x.instrs(); });
+  auto phase_end_samplers = host_time_samplers(env, traces);
+  std::vector<host_time_sampler> phase_samples{};
+  std::transform(std::begin(phase_end_samplers), std::end(phase_end_samplers), std::begin(phase_start_samplers), std::back_inserter(phase_samples),
+                 [](const auto& end, const auto& begin) { return end.sampler - begin.sampler; });
+  for (std::size_t i = 0; i < std::size(phase_samples); ++i) {
+    auto inner_end = std::next(std::cbegin(phase_samples), static_cast<long>(i));
+    auto inner_begin = std::prev(inner_end, static_cast<long>(phase_end_samplers.at(i).num_inner));
+    stats.host_profile.components.push_back(exclusive_host_profile(phase_end_samplers.at(i).name, phase_samples.at(i), inner_begin, inner_end));
+  }
+  stats.host_profile.counters_available = perf_counter_group::instance().is_open();
+
   return stats;
 }
 
@@ -205,22 +318,33 @@ std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases,
         warm_phase_executed_this_run && checkpoint_written_this_run && phase.cache_checkpoint_in && phase.cache_checkpoint_out
         && (*phase.cache_checkpoint_in == *phase.cache_checkpoint_out);
 
+    const auto load_start_time = std::chrono::steady_clock::now();
     if (phase.cache_checkpoint_in && !should_skip_load) {
       load_cache_checkpoint(env, *phase.cache_checkpoint_in);
     }
+    std::chrono::duration<double> checkpoint_time = std::chrono::steady_clock::now() - load_start_time;
 
     auto stats = do_phase(phase, env, traces, global_clock);
 
+    const auto save_start_time = std::chrono::steady_clock::now();
     if (phase.cache_checkpoint_out) {
       save_cache_checkpoint(env, *phase.cache_checkpoint_out);
       checkpoint_written_this_run = true;
     }
+    checkpoint_time += std::chrono::steady_clock::now() - save_start_time;
+
+    stats.host_profile.elapsed += checkpoint_time;
+    stats.host_profile.components.push_back({"checkpoint", checkpoint_time, {}});
 
     warm_phase_executed_this_run = warm_phase_executed_this_run || phase.is_warmup;
 
     if (!phase.is_warmup) {
       results.push_back(stats);
     }
+
+    if (phase.controller && !phase.controller->phase_complete(env, stats)) {
+      break;
+    }
   }
 
   return results;
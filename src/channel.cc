@@ -29,44 +29,72 @@ champsim::channel::channel(std::size_t rq_size, std::size_t pq_size, std::size_t
 {
 }
 
-template <typename Iter, typename F>
-bool do_collision_for(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt, F&& func)
+void merge_collision(champsim::channel::request_type& source, champsim::channel::request_type& destination)
+{
+  destination.response_requested |= source.response_requested;
+  auto instr_copy = std::move(destination.instr_depend_on_me);
+
+  std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(source.instr_depend_on_me), std::end(source.instr_depend_on_me),
+                 std::back_inserter(destination.instr_depend_on_me));
+}
+
+void return_collision(champsim::channel::request_type& source, champsim::channel::request_type& destination,
+                      std::deque<champsim::channel::response_type>& returned)
+{
+  if (source.response_requested) {
+    returned.emplace_back(source.address, source.v_address, destination.data, destination.pf_metadata, source.instr_depend_on_me);
+  }
+}
+
+template <typename R, typename I, typename F>
+bool do_collision_for(R& queue, const I& index, champsim::channel::request_type& packet, champsim::data::bits shamt, F&& func)
 {
   // We make sure that both merge packet address have been translated. If
   // not this can happen: package with address virtual and physical X
   // (not translated) is inserted, package with physical address
   // (already translated) X.
-  if (auto found =
-          std::find_if(begin, end, [match = packet.address.slice_upper(shamt), shamt](const auto& x) { return x.address.slice_upper(shamt) == match; });
-      found != end && packet.is_translated == found->is_translated) {
-    func(packet, *found);
+  if (auto found = index.find(packet.address.slice_upper(shamt).template to<uint64_t>());
+      found.has_value() && packet.is_translated == queue.at(found.value()).is_translated) {
+    func(packet, queue.at(found.value()));
     return true;
   }
 
   return false;
 }
 
-template <typename Iter>
-bool do_collision_for_merge(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt)
+void champsim::channel::collision_index::trim(std::size_t count)
 {
-  return do_collision_for(begin, end, packet, shamt, [](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
-    destination.response_requested |= source.response_requested;
-    auto instr_copy = std::move(destination.instr_depend_on_me);
+  for (; std::size(keys) > count; keys.pop_front()) {
+    auto seq = sequences.find(keys.front());
+    seq->second.erase(std::begin(seq->second));
+    if (std::empty(seq->second)) {
+      sequences.erase(seq);
+    }
+  }
+}
 
-    std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(source.instr_depend_on_me), std::end(source.instr_depend_on_me),
-                   std::back_inserter(destination.instr_depend_on_me));
-  });
+void champsim::channel::collision_index::push(uint64_t key)
+{
+  keys.push_back(key);
+  sequences[key].push_back(next_sequence++);
 }
 
-template <typename Iter>
-bool do_collision_for_return(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt,
-                             std::deque<champsim::channel::response_type>& returned)
+std::optional<std::size_t> champsim::channel::collision_index::find(uint64_t key) const
 {
-  return do_collision_for(begin, end, packet, shamt, [&](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
-    if (source.response_requested) {
-      returned.emplace_back(source.address, source.v_address, destination.data, destination.pf_metadata, source.instr_depend_on_me);
-    }
-  });
+  // The oldest entry for this key has the lowest position in the queue
+  if (auto seq = sequences.find(key); seq != std::end(sequences)) {
+    return static_cast<std::size_t>(seq->second.front() - (next_sequence - std::size(keys)));
+  }
+  return std::nullopt;
+}
+
+template <typename R>
+typename R::iterator champsim::channel::sync_collision_index(R& queue, collision_index& index)
+{
+  // Checked packets are a prefix of the queue, and any that are missing were removed from the front
+  auto first_unchecked = std::find_if(std::begin(queue), std::end(queue), std::not_fn(&request_type::forward_checked));
+  index.trim(static_cast<std::size_t>(std::distance(std::begin(queue), first_unchecked)));
+  return first_unchecked;
 }
 
 void champsim::channel::check_collision()
@@ -75,40 +103,47 @@ void champsim::channel::check_collision()
   auto read_shamt = OFFSET_BITS;
 
   // Check WQ for duplicates, merging if they are found
-  for (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), std::not_fn(&request_type::forward_checked)); wq_it != std::end(WQ);) {
-    if (do_collision_for_merge(std::begin(WQ), wq_it, *wq_it, write_shamt)) {
+  for (auto wq_it = sync_collision_index(WQ, WQ_index); wq_it != std::end(WQ);) {
+    if (do_collision_for(WQ, WQ_index, *wq_it, write_shamt, merge_collision)) {
       sim_stats.WQ_MERGED++;
       wq_it = WQ.erase(wq_it);
     } else {
       wq_it->forward_checked = true;
+      WQ_index.push(wq_it->address.slice_upper(write_shamt).to<uint64_t>());
       ++wq_it;
     }
   }
 
+  auto return_from_wq = [this](request_type& source, request_type& destination) {
+    return_collision(source, destination, returned);
+  };
+
   // Check RQ for forwarding from WQ (return if found), then for duplicates (merge if found)
-  for (auto rq_it = std::find_if(std::begin(RQ), std::end(RQ), std::not_fn(&request_type::forward_checked)); rq_it != std::end(RQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *rq_it, write_shamt, returned)) {
+  for (auto rq_it = sync_collision_index(RQ, RQ_index); rq_it != std::end(RQ);) {
+    if (do_collision_for(WQ, WQ_index, *rq_it, write_shamt, return_from_wq)) {
       sim_stats.WQ_FORWARD++;
       rq_it = RQ.erase(rq_it);
-    } else if (do_collision_for_merge(std::begin(RQ), rq_it, *rq_it, read_shamt)) {
+    } else if (do_collision_for(RQ, RQ_index, *rq_it, read_shamt, merge_collision)) {
       sim_stats.RQ_MERGED++;
       rq_it = RQ.erase(rq_it);
     } else {
       rq_it->forward_checked = true;
+      RQ_index.push(rq_it->address.slice_upper(read_shamt).to<uint64_t>());
       ++rq_it;
     }
   }
 
   // Check PQ for forwarding from WQ (return if found), then for duplicates (merge if found)
-  for (auto pq_it = std::find_if(std::begin(PQ), std::end(PQ), std::not_fn(&request_type::forward_checked)); pq_it != std::end(PQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *pq_it, write_shamt, returned)) {
+  for (auto pq_it = sync_collision_index(PQ, PQ_index); pq_it != std::end(PQ);) {
+    if (do_collision_for(WQ, WQ_index, *pq_it, write_shamt, return_from_wq)) {
       sim_stats.WQ_FORWARD++;
       pq_it = PQ.erase(pq_it);
-    } else if (do_collision_for_merge(std::begin(PQ), pq_it, *pq_it, read_shamt)) {
+    } else if (do_collision_for(PQ, PQ_index, *pq_it, read_shamt, merge_collision)) {
       sim_stats.PQ_MERGED++;
       pq_it = PQ.erase(pq_it);
     } else {
       pq_it->forward_checked = true;
+      PQ_index.push(pq_it->address.slice_upper(read_shamt).to<uint64_t>());
       ++pq_it;
     }
   }
@@ -19,9 +19,11 @@
 #include <algorithm>
 #include <cfenv>
 #include <cmath>
+#include <functional>
 #include <fmt/core.h>
 
 #include "deadlock.h"
+#include "dram_replay.h"
 #include "instruction.h"
 #include "util/bits.h" // for lg2, bitmask
 #include "util/span.h"
@@ -31,8 +33,21 @@ MEMORY_CONTROLLER::MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period,
                                      std::size_t t_cas, std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul,
                                      std::size_t rq_size, std::size_t wq_size, std::size_t chans, champsim::data::bytes chan_width, std::size_t rows,
                                      std::size_t columns, std::size_t ranks, std::size_t bankgroups, std::size_t banks, std::size_t refreshes_per_period)
+    : MEMORY_CONTROLLER(dbus_period, mc_period, t_rp, t_rcd, t_cas, t_ras, refresh_period, std::move(ul), rq_size, wq_size, chans, chan_width, rows, columns,
+                        ranks, bankgroups, banks, refreshes_per_period,
+                        champsim::dram_address_decoder{DRAM_ADDRESS_MAPPING::make_layout(DRAM_ADDRESS_MAPPING::make_slicer(
+                            chan_width, BLOCK_SIZE / chan_width.count(), chans, bankgroups, banks, columns, ranks, rows))})
+{
+}
+
+MEMORY_CONTROLLER::MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd,
+                                     std::size_t t_cas, std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul,
+                                     std::size_t rq_size, std::size_t wq_size, std::size_t chans, champsim::data::bytes chan_width, std::size_t rows,
+                                     std::size_t columns, std::size_t ranks, std::size_t bankgroups, std::size_t banks, std::size_t refreshes_per_period,
+                                     const champsim::dram_address_decoder& precomputed_decoder)
     : champsim::operable(mc_period), queues(std::move(ul)), channel_width(chan_width),
-      address_mapping(chan_width, BLOCK_SIZE / chan_width.count(), chans, bankgroups, banks, columns, ranks, rows), data_bus_period(dbus_period)
+      address_mapping(chan_width, BLOCK_SIZE / chan_width.count(), chans, bankgroups, banks, columns, ranks, rows, precomputed_decoder),
+      data_bus_period(dbus_period)
 {
   for (std::size_t i{0}; i < chans; ++i) {
     channels.emplace_back(dbus_period, mc_period, t_rp, t_rcd, t_cas, t_ras, refresh_period, refreshes_per_period, chan_width, rq_size, wq_size,
@@ -57,12 +72,27 @@ DRAM_CHANNEL::DRAM_CHANNEL(champsim::chrono::picoseconds dbus_period, champsim::
   request_array_type br(address_mapping.ranks() * address_mapping.banks() * address_mapping.bankgroups());
   bank_request = br;
   active_request = std::end(bank_request);
+
+  WQ_ready.resize(std::size(bank_request));
+  RQ_ready.resize(std::size(bank_request));
 }
 
 DRAM_ADDRESS_MAPPING::DRAM_ADDRESS_MAPPING(champsim::data::bytes channel_width_, std::size_t pref_size_, std::size_t channels_, std::size_t bankgroups_,
                                            std::size_t banks_, std::size_t columns_, std::size_t ranks_, std::size_t rows_)
-    : address_slicer(make_slicer(channel_width_, pref_size_, channels_, bankgroups_, banks_, columns_, ranks_, rows_)), prefetch_size(pref_size_)
+    : DRAM_ADDRESS_MAPPING(channel_width_, pref_size_, channels_, bankgroups_, banks_, columns_, ranks_, rows_,
+                           champsim::dram_address_decoder{make_layout(make_slicer(channel_width_, pref_size_, channels_, bankgroups_, banks_, columns_, ranks_, rows_))})
+{
+}
+
+DRAM_ADDRESS_MAPPING::DRAM_ADDRESS_MAPPING(champsim::data::bytes channel_width_, std::size_t pref_size_, std::size_t channels_, std::size_t bankgroups_,
+                                           std::size_t banks_, std::size_t columns_, std::size_t ranks_, std::size_t rows_,
+                                           const champsim::dram_address_decoder& precomputed_decoder)
+    : address_slicer(make_slicer(channel_width_, pref_size_, channels_, bankgroups_, banks_, columns_, ranks_, rows_)), decoder(precomputed_decoder),
+      prefetch_size(pref_size_)
 {
+  // assert the precomputed layout agrees with the slicer
+  assert(decoder.layout == make_layout(address_slicer));
+
   // assert prefetch size is not zero
   assert(prefetch_size != 0);
   // assert prefetch size is multiple of block size
@@ -91,6 +121,15 @@ auto DRAM_ADDRESS_MAPPING::make_slicer(champsim::data::bytes channel_width, std:
   return std::apply([](auto... p) { return champsim::make_contiguous_extent_set(0, champsim::lg2(p)...); }, params);
 }
 
+champsim::dram_address_layout DRAM_ADDRESS_MAPPING::make_layout(const slicer_type& slicer)
+{
+  auto field_size = [](const auto& extent) { return std::size_t{1} << champsim::size(extent); };
+  return champsim::make_dram_address_layout(field_size(get<SLICER_OFFSET_IDX>(slicer)), field_size(get<SLICER_CHANNEL_IDX>(slicer)),
+                                            field_size(get<SLICER_BANKGROUP_IDX>(slicer)), field_size(get<SLICER_BANK_IDX>(slicer)),
+                                            field_size(get<SLICER_COLUMN_IDX>(slicer)), field_size(get<SLICER_RANK_IDX>(slicer)),
+                                            field_size(get<SLICER_ROW_IDX>(slicer)));
+}
+
 long MEMORY_CONTROLLER::operate()
 {
   long progress{0};
@@ -98,7 +137,13 @@ long MEMORY_CONTROLLER::operate()
   initiate_requests();
 
   for (auto& channel : channels) {
-    progress += channel._operate();
+    if (skip_idle_cycles && channel.current_time + channel.clock_period < channel.next_event_time()) {
+      // Nothing in the channel can change this cycle, so advance its clock without operating it
+      channel.current_time += channel.clock_period;
+      progress += channel.idle_progress;
+    } else {
+      progress += channel._operate();
+    }
   }
 
   return progress;
@@ -127,19 +172,61 @@ long DRAM_CHANNEL::operate()
       }
       entry.reset();
     }
+
+    for (auto* ready : {&RQ_ready, &WQ_ready}) {
+      for (auto& bank : *ready) {
+        bank.clear();
+      }
+    }
+    RQ_blocks.clear();
+    WQ_blocks.clear();
   }
 
   check_write_collision();
   check_read_collision();
   progress += finish_dbus_request();
+  auto previous_mode = write_mode;
   swap_write_mode();
   progress += schedule_refresh();
   progress += populate_dbus();
   progress += service_packet(schedule_packet());
 
+  schedule_next_event(write_mode != previous_mode);
+
   return progress;
 }
 
+void DRAM_CHANNEL::schedule_next_event(bool swapped_mode)
+{
+  idle_progress = std::count_if(std::begin(bank_request), std::end(bank_request), [](const auto& b_req) { return b_req.under_refresh; });
+
+  // The queue occupancy is re-examined on the cycle after a mode change
+  if (swapped_mode) {
+    next_event = current_time;
+    return;
+  }
+
+  // Refreshes are due periodically
+  next_event = last_refresh + tREF;
+
+  // Busy banks are ready to use the data bus, or finish using it, or finish refreshing
+  for (const auto& b_req : bank_request) {
+    if (b_req.valid || b_req.under_refresh) {
+      next_event = std::min(next_event, b_req.ready_time);
+    }
+  }
+
+  // The next packet is serviced when it is ready, if its bank is free. Otherwise, it waits for one of the events above.
+  if (auto pkt = schedule_packet(); pkt != std::end(write_mode ? WQ : RQ)) {
+    const auto& b_req = bank_request[pkt->value().bank_index];
+    if (!b_req.valid && !b_req.under_refresh) {
+      next_event = std::min(next_event, pkt->value().ready_time);
+    }
+  }
+}
+
+champsim::chrono::clock::time_point DRAM_CHANNEL::next_event_time() const { return next_event; }
+
 long DRAM_CHANNEL::finish_dbus_request()
 {
   long progress{0};
@@ -153,7 +240,11 @@ long DRAM_CHANNEL::finish_dbus_request()
 
     active_request->valid = false;
 
-    active_request->pkt->reset();
+    auto& queue = queue_containing(active_request->pkt);
+    if (&queue == &RQ) {
+      sim_stats.read_latency.record((current_time - active_request->pkt->value().time_enqueued) / clock_period);
+    }
+    release(queue, static_cast<std::size_t>(std::distance(std::begin(queue), active_request->pkt)));
     active_request = std::end(bank_request);
     ++progress;
   }
@@ -228,6 +319,10 @@ void DRAM_CHANNEL::swap_write_mode()
         it->valid = false;
         it->pkt->value().scheduled = false;
         it->pkt->value().ready_time = current_time;
+
+        // Every bank request other than the active one was scheduled from the queue of the current mode
+        auto& queue = write_mode ? WQ : RQ;
+        mark_ready(queue, static_cast<std::size_t>(std::distance(std::begin(queue), it->pkt)));
       }
     }
 
@@ -256,7 +351,7 @@ long DRAM_CHANNEL::populate_dbus()
       // Put this request on the data bus
 
       // get which bankgroup we are in
-      auto op_bankgroup = bankgroup_request_index(iter_next_process->pkt->value().address);
+      auto op_bankgroup = iter_next_process->pkt->value().bankgroup_index;
       auto bankgroup_ready_time = bankgroup_readytime[op_bankgroup];
 
       active_request = iter_next_process;
@@ -299,43 +394,94 @@ long DRAM_CHANNEL::populate_dbus()
 
 std::size_t DRAM_CHANNEL::bank_request_index(champsim::address addr) const
 {
-  auto op_bank = address_mapping.get_bank(addr);
+  auto fields = address_mapping.decode(addr);
+  return bankgroup_request_index(fields) * address_mapping.banks() + fields.bank;
+}
+
+std::size_t DRAM_CHANNEL::bankgroup_request_index(champsim::address addr) const { return bankgroup_request_index(address_mapping.decode(addr)); }
+
+std::size_t DRAM_CHANNEL::bankgroup_request_index(const champsim::dram_address_fields& fields) const
+{
+  return (fields.rank * address_mapping.bankgroups() + fields.bankgroup);
+}
+
+auto DRAM_CHANNEL::ready_queue_for(const queue_type& queue) -> ready_queue_type& { return (&queue == &WQ) ? WQ_ready : RQ_ready; }
+
+void DRAM_CHANNEL::mark_ready(queue_type& queue, std::size_t index)
+{
+  // Earlier ready times come first. Among equal ready times, the later queue entry comes first.
+  auto schedules_before = [&queue](std::size_t lhs, std::size_t rhs) {
+    const auto& lhs_pkt = queue[lhs].value();
+    const auto& rhs_pkt = queue[rhs].value();
+    return (lhs_pkt.ready_time == rhs_pkt.ready_time) ? lhs > rhs : lhs_pkt.ready_time < rhs_pkt.ready_time;
+  };
+
+  auto& bank = ready_queue_for(queue).at(queue[index].value().bank_index);
+  bank.insert(std::upper_bound(std::begin(bank), std::end(bank), index, schedules_before), index);
+}
+
+void DRAM_CHANNEL::unmark_ready(queue_type& queue, std::size_t index)
+{
+  auto& bank = ready_queue_for(queue).at(queue[index].value().bank_index);
+  if (auto found = std::find(std::begin(bank), std::end(bank), index); found != std::end(bank)) {
+    bank.erase(found);
+  }
+}
+
+auto DRAM_CHANNEL::queue_containing(queue_type::const_iterator pkt) -> queue_type&
+{
+  // std::less is a total order, even over pointers into different queues
+  const auto* entry = &*pkt;
+  auto in_wq = !std::less<>{}(entry, std::data(WQ)) && std::less<>{}(entry, std::data(WQ) + std::size(WQ));
+  return in_wq ? WQ : RQ;
+}
 
-  return (bankgroup_request_index(addr) * address_mapping.banks() + op_bank);
+auto DRAM_CHANNEL::block_index_for(const queue_type& queue) -> block_index_type& { return (&queue == &WQ) ? WQ_blocks : RQ_blocks; }
+
+uint64_t DRAM_CHANNEL::block_key(champsim::address addr) const
+{
+  champsim::data::bits offset_bits{champsim::size(get<DRAM_ADDRESS_MAPPING::SLICER_OFFSET_IDX>(address_mapping.address_slicer))};
+  return addr.slice_upper(offset_bits).to<uint64_t>();
 }
 
-std::size_t DRAM_CHANNEL::bankgroup_request_index(champsim::address addr) const
+void DRAM_CHANNEL::release(queue_type& queue, std::size_t index)
 {
-  auto op_rank = address_mapping.get_rank(addr);
-  auto op_bankgroup = address_mapping.get_bankgroup(addr);
+  unmark_ready(queue, index);
 
-  return (op_rank * address_mapping.bankgroups() + op_bankgroup);
+  auto& blocks = block_index_for(queue);
+  auto block = blocks.find(block_key(queue[index].value().address));
+  block->second.erase(std::find(std::begin(block->second), std::end(block->second), index));
+  if (std::empty(block->second)) {
+    blocks.erase(block);
+  }
+
+  queue[index].reset();
 }
 
 // Look for queued packets that have not been scheduled
 DRAM_CHANNEL::queue_type::iterator DRAM_CHANNEL::schedule_packet()
 {
-  // Look for queued packets that have not been scheduled
+  // Each bank keeps its unscheduled packets in priority order, so only the head of each bank is a candidate.
   // prioritize packets that are ready to execute, bank is free
-  auto next_schedule = [this](const auto& lhs, const auto& rhs) {
-    if (!(rhs.has_value() && !rhs.value().scheduled)) {
-      return true;
-    }
-    if (!(lhs.has_value() && !lhs.value().scheduled)) {
-      return false;
+  auto& queue = write_mode ? WQ : RQ;
+  const auto& ready = ready_queue_for(queue);
+
+  auto iter_next_schedule = std::end(queue);
+  bool next_bank_ready = false;
+  for (std::size_t bank_idx = 0; bank_idx < std::size(ready); ++bank_idx) {
+    if (std::empty(ready[bank_idx])) {
+      continue;
     }
 
-    auto lop_idx = this->bank_request_index(lhs.value().address);
-    auto rop_idx = this->bank_request_index(rhs.value().address);
-    auto rready = !this->bank_request[rop_idx].valid;
-    auto lready = !this->bank_request[lop_idx].valid;
-    return (rready == lready) ? lhs.value().ready_time <= rhs.value().ready_time : lready;
-  };
-  queue_type::iterator iter_next_schedule;
-  if (write_mode) {
-    iter_next_schedule = std::min_element(std::begin(WQ), std::end(WQ), next_schedule);
-  } else {
-    iter_next_schedule = std::min_element(std::begin(RQ), std::end(RQ), next_schedule);
+    auto candidate = std::next(std::begin(queue), static_cast<long>(ready[bank_idx].front()));
+    auto bank_ready = !bank_request[bank_idx].valid;
+    if (iter_next_schedule == std::end(queue) || (bank_ready && !next_bank_ready)
+        || (bank_ready == next_bank_ready
+            && (candidate->value().ready_time < iter_next_schedule->value().ready_time
+                || (candidate->value().ready_time == iter_next_schedule->value().ready_time && candidate > iter_next_schedule)))) {
+      iter_next_schedule = candidate;
+      next_bank_ready = bank_ready;
+    }
   }
   return (iter_next_schedule);
 }
@@ -343,9 +489,10 @@ DRAM_CHANNEL::queue_type::iterator DRAM_CHANNEL::schedule_packet()
 long DRAM_CHANNEL::service_packet(DRAM_CHANNEL::queue_type::iterator pkt)
 {
   long progress{0};
-  if (pkt->has_value() && pkt->value().ready_time <= current_time) {
-    auto op_row = address_mapping.get_row(pkt->value().address);
-    auto op_idx = bank_request_index(pkt->value().address);
+  auto& queue = write_mode ? WQ : RQ;
+  if (pkt != std::end(queue) && pkt->has_value() && pkt->value().ready_time <= current_time) {
+    auto op_row = pkt->value().row;
+    auto op_idx = pkt->value().bank_index;
 
     if (!bank_request[op_idx].valid && !bank_request[op_idx].under_refresh) {
       bool row_buffer_hit = (bank_request[op_idx].open_row.has_value() && *(bank_request[op_idx].open_row) == op_row);
@@ -355,6 +502,7 @@ long DRAM_CHANNEL::service_packet(DRAM_CHANNEL::queue_type::iterator pkt)
       bank_request[op_idx] = {true,  row_buffer_hit,        false,
                               false, std::optional{op_row}, current_time + tCAS + (row_buffer_hit ? champsim::chrono::clock::duration{} : row_charge_delay),
                               pkt};
+      unmark_ready(queue, static_cast<std::size_t>(std::distance(std::begin(queue), pkt)));
       pkt->value().scheduled = true;
       pkt->value().ready_time = champsim::chrono::clock::time_point::max();
 
@@ -427,17 +575,9 @@ void DRAM_CHANNEL::check_write_collision()
 {
   for (auto wq_it = std::begin(WQ); wq_it != std::end(WQ); ++wq_it) {
     if (wq_it->has_value() && !wq_it->value().forward_checked) {
-      auto checker = [addr_map = address_mapping, check_val = wq_it->value().address](const auto& pkt) {
-        return pkt.has_value() && addr_map.is_collision(pkt.value().address, check_val);
-      };
-
-      auto found = std::find_if(std::begin(WQ), wq_it, checker); // Forward check
-      if (found == wq_it) {
-        found = std::find_if(std::next(wq_it), std::end(WQ), checker); // Backward check
-      }
-
-      if (found != std::end(WQ)) {
-        wq_it->reset();
+      // The block index holds this packet, so any other entry is a collision
+      if (std::size(WQ_blocks.at(block_key(wq_it->value().address))) > 1) {
+        release(WQ, static_cast<std::size_t>(std::distance(std::begin(WQ), wq_it)));
       } else {
         wq_it->value().forward_checked = true;
       }
@@ -449,44 +589,37 @@ void DRAM_CHANNEL::check_read_collision()
 {
   for (auto rq_it = std::begin(RQ); rq_it != std::end(RQ); ++rq_it) {
     if (rq_it->has_value() && !rq_it->value().forward_checked) {
-      auto checker = [addr_map = address_mapping, check_val = rq_it->value().address](const auto& x) {
-        return x.has_value() && addr_map.is_collision(x.value().address, check_val);
-      };
+      const auto rq_index = static_cast<std::size_t>(std::distance(std::begin(RQ), rq_it));
+      const auto key = block_key(rq_it->value().address);
+
       // write forward
-      if (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), checker); wq_it != std::end(WQ)) {
-        response_type response{rq_it->value().address, rq_it->value().v_address, wq_it->value().data, rq_it->value().pf_metadata,
+      if (auto wq_block = WQ_blocks.find(key); wq_block != std::end(WQ_blocks)) {
+        const auto& wq_entry = WQ[wq_block->second.front()];
+        response_type response{rq_it->value().address, rq_it->value().v_address, wq_entry->data, rq_it->value().pf_metadata,
                                rq_it->value().instr_depend_on_me};
         for (auto* ret : rq_it->value().to_return) {
           ret->push_back(response);
         }
 
-        rq_it->reset();
-
+        release(RQ, rq_index);
+        continue;
       }
-      // backwards check
-      else if (auto found = std::find_if(std::begin(RQ), rq_it, checker); found != rq_it) {
-        auto instr_copy = std::move(found->value().instr_depend_on_me);
-        auto ret_copy = std::move(found->value().to_return);
 
-        std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(rq_it->value().instr_depend_on_me), std::end(rq_it->value().instr_depend_on_me),
-                       std::back_inserter(found->value().instr_depend_on_me));
-        std::set_union(std::begin(ret_copy), std::end(ret_copy), std::begin(rq_it->value().to_return), std::end(rq_it->value().to_return),
-                       std::back_inserter(found->value().to_return));
-
-        rq_it->reset();
-
-      }
-      // forwards check
-      else if (found = std::find_if(std::next(rq_it), std::end(RQ), checker); found != std::end(RQ)) {
-        auto instr_copy = std::move(found->value().instr_depend_on_me);
-        auto ret_copy = std::move(found->value().to_return);
+      // Merge with the earliest other entry to this block, looking backwards first and then forwards.
+      // The entries are held in queue order, so this is the first entry that is not this packet.
+      const auto& rq_block = RQ_blocks.at(key);
+      if (auto found_index = std::find_if(std::begin(rq_block), std::end(rq_block), [rq_index](auto idx) { return idx != rq_index; });
+          found_index != std::end(rq_block)) {
+        auto& found = RQ[*found_index];
+        auto instr_copy = std::move(found->instr_depend_on_me);
+        auto ret_copy = std::move(found->to_return);
 
         std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(rq_it->value().instr_depend_on_me), std::end(rq_it->value().instr_depend_on_me),
-                       std::back_inserter(found->value().instr_depend_on_me));
+                       std::back_inserter(found->instr_depend_on_me));
         std::set_union(std::begin(ret_copy), std::end(ret_copy), std::begin(rq_it->value().to_return), std::end(rq_it->value().to_return),
-                       std::back_inserter(found->value().to_return));
+                       std::back_inserter(found->to_return));
 
-        rq_it->reset();
+        release(RQ, rq_index);
       } else {
         rq_it->value().forward_checked = true;
       }
@@ -516,42 +649,85 @@ DRAM_CHANNEL::request_type::request_type(const typename champsim::channel::reque
   asid[1] = req.asid[1];
 }
 
+void MEMORY_CONTROLLER::set_capture(std::ostream* stream)
+{
+  capture = stream;
+  if (capture != nullptr) {
+    champsim::write_dram_capture_header(*capture, BLOCK_SIZE);
+  }
+}
+
 bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul)
 {
-  auto& channel = channels[address_mapping.get_channel(packet.address)];
+  auto& channel = channels[address_mapping.decode(packet.address).channel];
 
-  if (auto rq_it = std::find_if_not(std::begin(channel.RQ), std::end(channel.RQ), [this](const auto& pkt) { return pkt.has_value(); });
-      rq_it != std::end(channel.RQ)) {
-    *rq_it = DRAM_CHANNEL::request_type{packet};
-    rq_it->value().forward_checked = false;
-    rq_it->value().scheduled = false;
-    rq_it->value().ready_time = current_time;
-    if (packet.response_requested)
-      rq_it->value().to_return = {&ul->returned};
+  DRAM_CHANNEL::request_type dram_packet{packet};
+  dram_packet.ready_time = current_time;
+  if (packet.response_requested)
+    dram_packet.to_return = {&ul->returned};
 
-    return true;
+  auto result = channel.add_rq(dram_packet);
+  if (result && capture != nullptr && !warmup) {
+    champsim::write_dram_record(*capture, {current_time.time_since_epoch(), false, packet.address});
   }
 
-  return false;
+  return result;
 }
 
 bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
 {
-  auto& channel = channels[address_mapping.get_channel(packet.address)];
+  auto& channel = channels[address_mapping.decode(packet.address).channel];
+
+  DRAM_CHANNEL::request_type dram_packet{packet};
+  dram_packet.ready_time = current_time;
 
+  auto result = channel.add_wq(dram_packet);
+  if (result && capture != nullptr && !warmup) {
+    champsim::write_dram_record(*capture, {current_time.time_since_epoch(), true, packet.address});
+  }
+
+  return result;
+}
+
+bool DRAM_CHANNEL::add_rq(const request_type& packet) { return enqueue(RQ, packet); }
+
+bool DRAM_CHANNEL::add_wq(const request_type& packet)
+{
+  auto result = enqueue(WQ, packet);
+  if (!result) {
+    ++sim_stats.WQ_FULL;
+  }
+
+  return result;
+}
+
+bool DRAM_CHANNEL::enqueue(queue_type& queue, const request_type& packet)
+{
   // search for the empty index
-  if (auto wq_it = std::find_if_not(std::begin(channel.WQ), std::end(channel.WQ), [](const auto& pkt) { return pkt.has_value(); });
-      wq_it != std::end(channel.WQ)) {
-    *wq_it = DRAM_CHANNEL::request_type{packet};
-    wq_it->value().forward_checked = false;
-    wq_it->value().scheduled = false;
-    wq_it->value().ready_time = current_time;
-
-    return true;
+  auto slot = std::find_if_not(std::begin(queue), std::end(queue), [](const auto& pkt) { return pkt.has_value(); });
+  if (slot == std::end(queue)) {
+    return false;
   }
 
-  ++channel.sim_stats.WQ_FULL;
-  return false;
+  *slot = packet;
+  slot->value().forward_checked = false;
+  slot->value().scheduled = false;
+  slot->value().time_enqueued = current_time;
+  const auto fields = address_mapping.decode(packet.address);
+  slot->value().bankgroup_index = bankgroup_request_index(fields);
+  slot->value().bank_index = slot->value().bankgroup_index * address_mapping.banks() + fields.bank;
+  slot->value().row = fields.row;
+  slot->value().column = fields.column;
+
+  // New packets must be checked for collisions and considered for scheduling on the next cycle
+  next_event = champsim::chrono::clock::time_point{};
+
+  auto index = static_cast<std::size_t>(std::distance(std::begin(queue), slot));
+  auto& block = block_index_for(queue)[block_key(packet.address)];
+  block.insert(std::upper_bound(std::begin(block), std::end(block), index), index);
+
+  mark_ready(queue, index);
+  return true;
 }
 
 unsigned long DRAM_ADDRESS_MAPPING::swizzle_bits(champsim::address address, unsigned long segment_size, champsim::data::bits segment_offset,
@@ -567,37 +743,12 @@ unsigned long DRAM_ADDRESS_MAPPING::swizzle_bits(champsim::address address, unsi
   return permute_field;
 }
 
-unsigned long DRAM_ADDRESS_MAPPING::get_channel(champsim::address address) const
-{
-  unsigned long channel = std::get<SLICER_CHANNEL_IDX>(address_slicer(address)).to<unsigned long>();
-  // channel bits should be xor'd with each row bit
-  unsigned long c_bits = champsim::size(get<SLICER_CHANNEL_IDX>(address_slicer));
-  return (swizzle_bits(address, 1, champsim::data::bits{0}, channel, c_bits));
-}
-unsigned long DRAM_ADDRESS_MAPPING::get_rank(champsim::address address) const { return std::get<SLICER_RANK_IDX>(address_slicer(address)).to<unsigned long>(); }
-unsigned long DRAM_ADDRESS_MAPPING::get_bankgroup(champsim::address address) const
-{
-  unsigned long bankgroup = std::get<SLICER_BANKGROUP_IDX>(address_slicer(address)).to<unsigned long>();
-
-  unsigned long bg_bits = champsim::size(get<SLICER_BANKGROUP_IDX>(address_slicer));
-  unsigned long bk_bits = champsim::size(get<SLICER_BANK_IDX>(address_slicer));
-  return (swizzle_bits(address, bg_bits + bk_bits, champsim::data::bits{0}, bankgroup, bg_bits));
-}
-unsigned long DRAM_ADDRESS_MAPPING::get_bank(champsim::address address) const
-{
-  unsigned long bank = std::get<SLICER_BANK_IDX>(address_slicer(address)).to<unsigned long>();
-
-  unsigned long bg_bits = champsim::size(get<SLICER_BANKGROUP_IDX>(address_slicer));
-  unsigned long bk_bits = champsim::size(get<SLICER_BANK_IDX>(address_slicer));
-  // bank bits should be xor'd with select row bits
-
-  return (swizzle_bits(address, bg_bits + bk_bits, champsim::data::bits{bg_bits}, bank, bk_bits));
-}
-unsigned long DRAM_ADDRESS_MAPPING::get_row(champsim::address address) const { return std::get<SLICER_ROW_IDX>(address_slicer(address)).to<unsigned long>(); }
-unsigned long DRAM_ADDRESS_MAPPING::get_column(champsim::address address) const
-{
-  return std::get<SLICER_COLUMN_IDX>(address_slicer(address)).to<unsigned long>();
-}
+unsigned long DRAM_ADDRESS_MAPPING::get_channel(champsim::address address) const { return decode(address).channel; }
+unsigned long DRAM_ADDRESS_MAPPING::get_rank(champsim::address address) const { return decode(address).rank; }
+unsigned long DRAM_ADDRESS_MAPPING::get_bankgroup(champsim::address address) const { return decode(address).bankgroup; }
+unsigned long DRAM_ADDRESS_MAPPING::get_bank(champsim::address address) const { return decode(address).bank; }
+unsigned long DRAM_ADDRESS_MAPPING::get_row(champsim::address address) const { return decode(address).row; }
+unsigned long DRAM_ADDRESS_MAPPING::get_column(champsim::address address) const { return decode(address).column; }
 
 champsim::data::bytes MEMORY_CONTROLLER::size() const { return champsim::data::bytes{(1ll << address_mapping.address_slicer.bit_size())}; }
 champsim::data::bytes DRAM_CHANNEL::density() const
@@ -0,0 +1,214 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dram_replay.h"
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <fmt/core.h>
+
+#include "channel.h"
+#include "champsim.h"
+#include "dram_controller.h"
+
+void champsim::write_dram_capture_header(std::ostream& stream, std::size_t block_size) { stream << fmt::format("# block_size {}\n", block_size); }
+
+void champsim::write_dram_record(std::ostream& stream, const dram_request_record& record)
+{
+  stream << fmt::format("{} {} {}\n", record.arrival.count(), record.is_write ? 'W' : 'R', record.address);
+}
+
+champsim::dram_capture champsim::read_dram_capture(std::istream& stream)
+{
+  dram_capture capture;
+  auto& records = capture.records;
+  std::string line;
+  for (std::size_t line_num = 1; std::getline(stream, line); ++line_num) {
+    if (line.empty()) {
+      continue;
+    }
+
+    if (line.front() == '#') {
+      std::istringstream fields{line.substr(1)};
+      std::string key;
+      if (fields >> key; key == "block_size" && !(fields >> capture.block_size)) {
+        throw std::invalid_argument{fmt::format("Malformed DRAM capture header on line {}: '{}'", line_num, line)};
+      }
+      continue;
+    }
+
+    std::istringstream fields{line};
+    champsim::chrono::picoseconds::rep arrival{};
+    char type{};
+    uint64_t address{};
+    if (!(fields >> arrival >> type >> std::hex >> address) || (type != 'R' && type != 'W')) {
+      throw std::invalid_argument{fmt::format("Malformed DRAM request record on line {}: '{}'", line_num, line)};
+    }
+
+    records.push_back({champsim::chrono::picoseconds{arrival}, type == 'W', champsim::address{address}});
+  }
+
+  return capture;
+}
+
+std::vector<champsim::dram_request_record> champsim::read_dram_records(std::istream& stream) { return read_dram_capture(stream).records; }
+
+double champsim::dram_replay_result::bandwidth_gbps() const
+{
+  if (elapsed.count() == 0) {
+    return 0;
+  }
+
+  // bytes per picosecond, scaled to gigabytes per second
+  return static_cast<double>((reads + writes) * BLOCK_SIZE) / static_cast<double>(elapsed.count()) * 1000;
+}
+
+champsim::dram_replay_result champsim::replay_dram(const std::vector<dram_request_record>& records, const dram_replay_config& config,
+                                                   const dram_replay_options& options)
+{
+  if (config.block_size != BLOCK_SIZE) {
+    throw std::invalid_argument{
+        fmt::format("{} is configured with {} byte blocks, but the replay uses {} byte blocks", config.name, config.block_size, BLOCK_SIZE)};
+  }
+
+  champsim::channel upper_level{std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max(),
+                                champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+
+  MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{1000000 / config.data_rate},
+                         champsim::chrono::picoseconds{1000000 / config.frequency},
+                         config.tRP,
+                         config.tRCD,
+                         config.tCAS,
+                         config.tRAS,
+                         champsim::chrono::microseconds{1000 * config.refresh_period},
+                         {&upper_level},
+                         config.rq_size,
+                         config.wq_size,
+                         config.channels,
+                         champsim::data::bytes{config.channel_width},
+                         config.bank_rows,
+                         config.bank_columns,
+                         config.ranks,
+                         config.bankgroups,
+                         config.banks,
+                         config.refreshes_per_period};
+
+  dram.warmup = false;
+  for (auto& chan : dram.channels) {
+    chan.warmup = false;
+  }
+  dram.initialize();
+
+  dram_replay_result result;
+  result.name = config.name;
+
+  // Reads that have been offered to the memory controller, in the order they wait in its read queue
+  std::deque<std::pair<uint64_t, champsim::chrono::clock::time_point>> waiting;
+  // Reads the memory controller has accepted, by block. It merges accepted reads to the same block, so one response completes all of them.
+  std::unordered_map<uint64_t, std::vector<champsim::chrono::clock::time_point>> accepted;
+  std::size_t num_outstanding = 0;
+  std::vector<champsim::chrono::picoseconds> latencies;
+
+  auto drained = [&]() {
+    auto queues_empty = std::empty(upper_level.RQ) && std::empty(upper_level.WQ);
+    auto dram_empty = std::all_of(std::begin(dram.channels), std::end(dram.channels), [](const DRAM_CHANNEL& chan) {
+      auto is_empty = [](const auto& entry) { return !entry.has_value(); };
+      return std::all_of(std::begin(chan.RQ), std::end(chan.RQ), is_empty) && std::all_of(std::begin(chan.WQ), std::end(chan.WQ), is_empty);
+    });
+    return queues_empty && dram_empty && num_outstanding == 0;
+  };
+
+  champsim::chrono::clock global_clock;
+  const auto origin = std::empty(records) ? champsim::chrono::picoseconds{} : records.front().arrival;
+  auto next_issue = global_clock.now();
+  auto record = std::begin(records);
+  while (record != std::end(records) || !drained()) {
+    global_clock.tick(dram.clock_period);
+
+    for (; record != std::end(records); ++record) {
+      if (options.closed_loop) {
+        if (next_issue > global_clock.now() || num_outstanding >= options.max_outstanding) {
+          break;
+        }
+      } else if (champsim::chrono::clock::time_point{record->arrival - origin} > global_clock.now()) {
+        break;
+      }
+
+      champsim::channel::request_type pkt;
+      pkt.address = record->address;
+      pkt.v_address = record->address;
+      pkt.response_requested = !record->is_write;
+      pkt.type = record->is_write ? access_type::WRITE : access_type::LOAD;
+
+      if (record->is_write) {
+        upper_level.add_wq(pkt);
+        ++result.writes;
+      } else {
+        upper_level.add_rq(pkt);
+        waiting.emplace_back(pkt.address.slice_upper(champsim::data::bits{LOG2_BLOCK_SIZE}).to<uint64_t>(), global_clock.now());
+        ++num_outstanding;
+        ++result.reads;
+      }
+
+      if (auto next = std::next(record); next != std::end(records)) {
+        next_issue = global_clock.now() + (next->arrival - record->arrival);
+      }
+    }
+
+    dram.operate_on(global_clock);
+
+    // The memory controller accepts reads from the front of its read queue
+    for (auto newly_accepted = std::size(waiting) - std::size(upper_level.RQ); newly_accepted > 0; --newly_accepted) {
+      accepted[waiting.front().first].push_back(waiting.front().second);
+      waiting.pop_front();
+    }
+
+    for (const auto& response : upper_level.returned) {
+      if (auto found = accepted.find(response.address.slice_upper(champsim::data::bits{LOG2_BLOCK_SIZE}).to<uint64_t>()); found != std::end(accepted)) {
+        for (auto issued : found->second) {
+          latencies.push_back(global_clock.now() - issued);
+        }
+        num_outstanding -= std::size(found->second);
+        accepted.erase(found);
+      }
+    }
+    upper_level.returned.clear();
+  }
+
+  result.elapsed = global_clock.now().time_since_epoch();
+
+  if (!std::empty(latencies)) {
+    std::sort(std::begin(latencies), std::end(latencies));
+    auto percentile = [&latencies](std::size_t pct) { return latencies.at((std::size(latencies) - 1) * pct / 100); };
+
+    auto total_latency = std::accumulate(std::begin(latencies), std::end(latencies), champsim::chrono::picoseconds{});
+    result.mean_latency = total_latency / static_cast<long>(std::size(latencies));
+    result.p50_latency = percentile(50);
+    result.p95_latency = percentile(95);
+    result.p99_latency = percentile(99);
+    result.max_latency = latencies.back();
+  }
+
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(result.channel_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+
+  return result;
+}
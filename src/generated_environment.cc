@@ -2,7 +2,9 @@
 
 #include <forward_list>
 
+#if __has_include("core_inst.inc")
 #include "core_inst.inc"
+#endif
 #include "environment.h"
 
 #if __has_include("legacy_bridge.h")
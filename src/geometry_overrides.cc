@@ -0,0 +1,242 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geometry_overrides.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <nlohmann/json.hpp>
+
+#include "environment.h"
+#include "module_registry.h"
+#include "util/bits.h"
+
+namespace
+{
+using cache_base = champsim::detail::cache_builder_base;
+using core_base = champsim::detail::core_builder_base;
+
+template <typename Builder>
+using setter = void (*)(Builder&, uint64_t);
+
+auto as_bandwidth(uint64_t value) { return static_cast<champsim::bandwidth::maximum_type>(value); }
+
+const std::map<std::string_view, setter<cache_base>>& cache_parameters()
+{
+  static const std::map<std::string_view, setter<cache_base>> parameters{
+      {"sets", [](cache_base& b, uint64_t v) { b.m_sets = static_cast<uint32_t>(v); }},
+      {"ways", [](cache_base& b, uint64_t v) { b.m_ways = static_cast<uint32_t>(v); }},
+      {"mshr_size", [](cache_base& b, uint64_t v) { b.m_mshr_size = static_cast<uint32_t>(v); }},
+      // The total latency is divided between hit and fill, unless they are given
+      {"latency",
+       [](cache_base& b, uint64_t v) {
+         b.m_latency = v;
+         b.m_hit_lat.reset();
+         b.m_fill_lat.reset();
+       }},
+      {"hit_latency", [](cache_base& b, uint64_t v) { b.m_hit_lat = v; }},
+      {"fill_latency", [](cache_base& b, uint64_t v) { b.m_fill_lat = v; }},
+      {"max_tag_check", [](cache_base& b, uint64_t v) { b.m_max_tag = as_bandwidth(v); }},
+      {"max_fill", [](cache_base& b, uint64_t v) { b.m_max_fill = as_bandwidth(v); }}};
+  return parameters;
+}
+
+const std::map<std::string_view, setter<core_base>>& core_parameters()
+{
+  static const std::map<std::string_view, setter<core_base>> parameters{
+      {"ifetch_buffer_size", [](core_base& b, uint64_t v) { b.m_ifetch_buffer_size = v; }},
+      {"decode_buffer_size", [](core_base& b, uint64_t v) { b.m_decode_buffer_size = v; }},
+      {"dispatch_buffer_size", [](core_base& b, uint64_t v) { b.m_dispatch_buffer_size = v; }},
+      {"register_file_size", [](core_base& b, uint64_t v) { b.m_register_file_size = v; }},
+      {"rob_size", [](core_base& b, uint64_t v) { b.m_rob_size = v; }},
+      {"lq_size", [](core_base& b, uint64_t v) { b.m_lq_size = v; }},
+      {"sq_size", [](core_base& b, uint64_t v) { b.m_sq_size = v; }},
+      {"fetch_width", [](core_base& b, uint64_t v) { b.m_fetch_width = as_bandwidth(v); }},
+      {"decode_width", [](core_base& b, uint64_t v) { b.m_decode_width = as_bandwidth(v); }},
+      {"dispatch_width", [](core_base& b, uint64_t v) { b.m_dispatch_width = as_bandwidth(v); }},
+      {"scheduler_size", [](core_base& b, uint64_t v) { b.m_schedule_width = as_bandwidth(v); }},
+      {"execute_width", [](core_base& b, uint64_t v) { b.m_execute_width = as_bandwidth(v); }},
+      {"lq_width", [](core_base& b, uint64_t v) { b.m_lq_width = as_bandwidth(v); }},
+      {"sq_width", [](core_base& b, uint64_t v) { b.m_sq_width = as_bandwidth(v); }},
+      {"retire_width", [](core_base& b, uint64_t v) { b.m_retire_width = as_bandwidth(v); }},
+      {"mispredict_penalty", [](core_base& b, uint64_t v) { b.m_mispredict_penalty = static_cast<unsigned>(v); }},
+      {"decode_latency", [](core_base& b, uint64_t v) { b.m_decode_latency = static_cast<unsigned>(v); }},
+      {"dispatch_latency", [](core_base& b, uint64_t v) { b.m_dispatch_latency = static_cast<unsigned>(v); }},
+      {"schedule_latency", [](core_base& b, uint64_t v) { b.m_schedule_latency = static_cast<unsigned>(v); }},
+      {"execute_latency", [](core_base& b, uint64_t v) { b.m_execute_latency = static_cast<unsigned>(v); }}};
+  return parameters;
+}
+
+const std::set<std::string_view>& dram_parameters()
+{
+  static const std::set<std::string_view> parameters{"tRP", "tRCD", "tCAS", "tRAS", "rq_size", "wq_size"};
+  return parameters;
+}
+
+// Parameters that count time may be zero. All others size a structure.
+bool may_be_zero(std::string_view parameter)
+{
+  static const std::set<std::string_view> parameters{"latency",          "hit_latency",      "fill_latency",    "mispredict_penalty", "decode_latency",
+                                                     "dispatch_latency", "schedule_latency", "execute_latency", "tRP",                "tRCD",
+                                                     "tCAS",             "tRAS"};
+  return parameters.count(parameter) > 0;
+}
+
+bool is_parameter(std::string_view parameter)
+{
+  return cache_parameters().count(parameter) > 0 || core_parameters().count(parameter) > 0 || dram_parameters().count(parameter) > 0;
+}
+
+template <typename Builder>
+std::vector<std::string_view> keys_of(const std::map<std::string_view, setter<Builder>>& map)
+{
+  std::vector<std::string_view> result;
+  std::transform(std::begin(map), std::end(map), std::back_inserter(result), [](const auto& x) { return x.first; });
+  return result;
+}
+
+std::vector<std::string_view> keys_of(const std::set<std::string_view>& set) { return {std::begin(set), std::end(set)}; }
+
+bool names_core(const std::string& key, const std::string& core_name) { return key == "ooo_cpu" || key == core_name; }
+} // namespace
+
+void champsim::geometry_overrides::add(const std::string& override_string)
+{
+  const auto dot = override_string.find('.');
+  const auto equals = override_string.find('=', dot == std::string::npos ? 0 : dot);
+  if (dot == std::string::npos || equals == std::string::npos || dot == 0 || equals == dot + 1) {
+    throw std::invalid_argument{fmt::format("The override '{}' must have the form COMPONENT.PARAMETER=VALUE", override_string)};
+  }
+
+  const auto value_string = override_string.substr(equals + 1);
+  std::size_t parsed = 0;
+  uint64_t value = 0;
+  try {
+    value = std::stoull(value_string, &parsed);
+  } catch (const std::logic_error&) {
+    parsed = 0;
+  }
+  if (parsed == 0 || parsed != std::size(value_string) || value_string.front() == '-') {
+    throw std::invalid_argument{fmt::format("The value of the override '{}' must be a non-negative integer", override_string)};
+  }
+
+  auto overrides = nlohmann::json::object();
+  overrides[override_string.substr(0, dot)][override_string.substr(dot + 1, equals - dot - 1)] = value;
+  add_json(overrides.dump());
+}
+
+void champsim::geometry_overrides::add_json(const std::string& overrides_json)
+{
+  auto overrides = nlohmann::json::parse(overrides_json);
+  if (!overrides.is_object()) {
+    throw std::invalid_argument{"The overrides must be a JSON object keyed by component"};
+  }
+
+  std::vector<assignment> added;
+  for (const auto& [component, parameters] : overrides.items()) {
+    if (!parameters.is_object()) {
+      throw std::invalid_argument{fmt::format("The overrides for '{}' must be a JSON object", component)};
+    }
+
+    for (const auto& [parameter, value] : parameters.items()) {
+      if (!is_parameter(parameter)) {
+        throw std::invalid_argument{fmt::format("No component has a parameter '{}' that can be overridden", parameter)};
+      }
+      if (!value.is_number_unsigned() || value.get<uint64_t>() > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument{fmt::format("The override of {}.{} must be a non-negative integer that fits in 32 bits", component, parameter)};
+      }
+      if (value.get<uint64_t>() == 0 && !may_be_zero(parameter)) {
+        throw std::invalid_argument{fmt::format("The override of {}.{} must be positive", component, parameter)};
+      }
+      if (parameter == "sets" && !champsim::is_power_of_2(value.get<uint64_t>())) {
+        throw std::invalid_argument{fmt::format("The override of {}.{} must be a power of two", component, parameter)};
+      }
+      added.push_back({component, parameter, value.get<uint64_t>()});
+    }
+  }
+
+  // The whole object is checked before any of it is kept
+  assignments.insert(std::end(assignments), std::begin(added), std::end(added));
+}
+
+void champsim::geometry_overrides::apply_to(const std::string& name, detail::cache_builder_base& builder) const
+{
+  for (const auto& change : assignments) {
+    if (auto found = cache_parameters().find(change.parameter); found != std::end(cache_parameters()) && champsim::names_cache(change.component, name)) {
+      found->second(builder, change.value);
+    }
+  }
+}
+
+void champsim::geometry_overrides::apply_to(const std::string& name, detail::core_builder_base& builder) const
+{
+  for (const auto& change : assignments) {
+    if (auto found = core_parameters().find(change.parameter); found != std::end(core_parameters()) && names_core(change.component, name)) {
+      found->second(builder, change.value);
+    }
+  }
+}
+
+uint64_t champsim::geometry_overrides::value(const std::string& component, const std::string& parameter, uint64_t configured) const
+{
+  auto found = std::find_if(std::rbegin(assignments), std::rend(assignments),
+                            [&](const auto& change) { return change.component == component && change.parameter == parameter; });
+  return found == std::rend(assignments) ? configured : found->value;
+}
+
+void champsim::geometry_overrides::validate(environment& env, std::string_view dram_name) const
+{
+  std::vector<std::string> cache_names;
+  for (CACHE& cache : env.cache_view()) {
+    cache_names.push_back(cache.NAME);
+  }
+  std::vector<std::string> core_names;
+  for (O3_CPU& cpu : env.cpu_view()) {
+    core_names.push_back(fmt::format("cpu{}", cpu.cpu));
+  }
+
+  for (const auto& change : assignments) {
+    auto is_named_by = [&](const auto& names, auto pred) {
+      return std::any_of(std::begin(names), std::end(names), [&](const auto& name) { return pred(change.component, name); });
+    };
+
+    if (is_named_by(cache_names, champsim::names_cache)) {
+      if (cache_parameters().count(change.parameter) == 0) {
+        throw std::invalid_argument{fmt::format("The cache '{}' has no parameter '{}'. The parameters of a cache are: {}", change.component, change.parameter,
+                                                fmt::join(keys_of(cache_parameters()), ", "))};
+      }
+    } else if (is_named_by(core_names, names_core)) {
+      if (core_parameters().count(change.parameter) == 0) {
+        throw std::invalid_argument{fmt::format("The core '{}' has no parameter '{}'. The parameters of a core are: {}", change.component, change.parameter,
+                                                fmt::join(keys_of(core_parameters()), ", "))};
+      }
+    } else if (change.component == dram_name) {
+      if (dram_parameters().count(change.parameter) == 0) {
+        throw std::invalid_argument{fmt::format("The memory controller has no parameter '{}'. The parameters of the memory controller are: {}", change.parameter,
+                                                fmt::join(keys_of(dram_parameters()), ", "))};
+      }
+    } else {
+      throw std::invalid_argument{fmt::format("The override {}.{} names '{}', which matches no cache, core, or memory controller", change.component,
+                                              change.parameter, change.component)};
+    }
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "host_counters.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+champsim::perf_counter_group::~perf_counter_group() { close(); }
+
+auto champsim::perf_counter_group::instance() -> perf_counter_group&
+{
+  static perf_counter_group group{};
+  return group;
+}
+
+#if defined(__linux__)
+std::string champsim::perf_counter_group::open()
+{
+  close();
+
+  constexpr std::array<uint64_t, NUM_EVENTS> configs{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                                                     PERF_COUNT_HW_BRANCH_MISSES};
+
+  std::string reason{};
+  for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = configs.at(i);
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = (num_open == 0) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    const int leader = (num_open == 0) ? -1 : fds.at(0);
+    const auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+    if (fd < 0) {
+      reason = std::strerror(errno);
+      if (num_open == 0) {
+        break; // Without the cycle counter as a leader, there is no group
+      }
+    } else {
+      positions.at(i) = num_open++;
+      fds.at(i) = fd;
+    }
+  }
+
+  if (!is_open()) {
+    return reason.empty() ? std::string{"no events could be opened"} : reason;
+  }
+
+  ioctl(fds.at(0), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds.at(0), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return {};
+}
+
+void champsim::perf_counter_group::close()
+{
+  for (auto& fd : fds) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    fd = -1;
+  }
+  num_open = 0;
+}
+
+auto champsim::perf_counter_group::read() const -> host_counter_values
+{
+  if (!is_open()) {
+    return {};
+  }
+
+  // With PERF_FORMAT_GROUP, the leader reports the number of events followed by each value
+  std::array<uint64_t, NUM_EVENTS + 1> buffer{};
+  if (::read(fds.at(0), buffer.data(), sizeof(buffer)) < 0) {
+    return {};
+  }
+
+  auto value_of = [&](std::size_t event) { return (fds.at(event) >= 0) ? buffer.at(positions.at(event) + 1) : uint64_t{0}; };
+  return {value_of(0), value_of(1), value_of(2), value_of(3)};
+}
+#else
+std::string champsim::perf_counter_group::open() { return "perf events are only available on Linux"; }
+
+void champsim::perf_counter_group::close() {}
+
+auto champsim::perf_counter_group::read() const -> host_counter_values { return {}; }
+#endif
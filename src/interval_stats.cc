@@ -0,0 +1,104 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interval_stats.h"
+
+#include <algorithm>
+
+#include "environment.h"
+#include "stats_printer.h"
+
+champsim::interval_stats champsim::operator-(interval_stats lhs, const interval_stats& rhs)
+{
+  std::transform(std::begin(lhs.cpus), std::end(lhs.cpus), std::begin(rhs.cpus), std::begin(lhs.cpus), [](const auto& x, const auto& y) { return x - y; });
+  std::transform(std::begin(lhs.caches), std::end(lhs.caches), std::begin(rhs.caches), std::begin(lhs.caches),
+                 [](const auto& x, const auto& y) { return x - y; });
+  std::transform(std::begin(lhs.dram_channels), std::end(lhs.dram_channels), std::begin(rhs.dram_channels), std::begin(lhs.dram_channels),
+                 [](const auto& x, const auto& y) { return x - y; });
+  return lhs;
+}
+
+champsim::interval_stats champsim::take_interval_snapshot(environment& env, const std::string& phase, bool is_warmup, uint64_t index)
+{
+  interval_stats snapshot{phase, is_warmup, index, {}, {}, {}};
+
+  // The cores record where the phase ends only when it ends, so the snapshot marks the current position instead
+  auto cpus = env.cpu_view();
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(snapshot.cpus), [](const O3_CPU& cpu) {
+    auto stats = cpu.sim_stats;
+    stats.end_instrs = stats.begin_instrs + static_cast<long long>(cpu.sim_instr());
+    stats.end_cycles = stats.begin_cycles + static_cast<long long>(cpu.sim_cycle());
+    return stats;
+  });
+
+  auto caches = env.cache_view();
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(snapshot.caches), [](const CACHE& cache) { return cache.sim_stats; });
+
+  auto& dram = env.dram_view();
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(snapshot.dram_channels),
+                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+
+  return snapshot;
+}
+
+champsim::interval_writer::interval_writer(std::ostream& str) : stream(str), worker([this] { run(); }) {}
+
+champsim::interval_writer::~interval_writer() { close(); }
+
+void champsim::interval_writer::push(interval_stats snapshot)
+{
+  {
+    std::lock_guard lock{mutex};
+    pending.push_back(std::move(snapshot));
+  }
+  pending_cv.notify_one();
+}
+
+void champsim::interval_writer::close()
+{
+  {
+    std::lock_guard lock{mutex};
+    closed = true;
+  }
+  pending_cv.notify_one();
+  if (worker.joinable()) {
+    worker.join();
+  }
+  stream.flush();
+}
+
+void champsim::interval_writer::run()
+{
+  std::optional<interval_stats> previous;
+  std::unique_lock lock{mutex};
+  while (true) {
+    pending_cv.wait(lock, [this] { return closed || !std::empty(pending); });
+    if (std::empty(pending)) {
+      return; // closed, and nothing left to write
+    }
+
+    auto snapshot = std::move(pending.front());
+    pending.pop_front();
+    lock.unlock();
+
+    // The first snapshot of a phase counts from the beginning of the phase
+    const bool continues = previous.has_value() && previous->phase == snapshot.phase && previous->index + 1 == snapshot.index;
+    json_printer{stream}.print(continues ? snapshot - previous.value() : snapshot);
+    previous = std::move(snapshot);
+
+    lock.lock();
+  }
+}
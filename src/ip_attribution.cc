@@ -0,0 +1,171 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ip_attribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+
+double champsim::stats::ip_attribution::record::average_miss_latency() const
+{
+  if (miss_latency_samples == 0) {
+    return 0;
+  }
+  return std::ceil(miss_latency_cycles) / std::ceil(miss_latency_samples);
+}
+
+champsim::stats::ip_attribution::ip_attribution(std::size_t capacity) : m_capacity(capacity)
+{
+  entries.reserve(m_capacity);
+  index.reserve(m_capacity);
+  fewest_events.reserve(m_capacity);
+}
+
+auto champsim::stats::ip_attribution::admit(champsim::address ip) -> record&
+{
+  const auto key = ip.to<uint64_t>();
+  if (auto found = index.find(key); found != std::end(index)) {
+    return entries.at(found->second);
+  }
+
+  if (std::size(entries) < m_capacity) {
+    index.emplace(key, std::size(entries));
+    fewest_events.emplace_back(0, std::size(entries));
+    std::push_heap(std::begin(fewest_events), std::end(fewest_events), std::greater<>{});
+    return entries.emplace_back(record{ip});
+  }
+
+  // Replace the entry with the fewest events. Stale keys are refreshed until the top of the heap is current, and then it is the least count.
+  std::pop_heap(std::begin(fewest_events), std::end(fewest_events), std::greater<>{});
+  while (fewest_events.back().first != entries.at(fewest_events.back().second).events) {
+    fewest_events.back().first = entries.at(fewest_events.back().second).events;
+    std::push_heap(std::begin(fewest_events), std::end(fewest_events), std::greater<>{});
+    std::pop_heap(std::begin(fewest_events), std::end(fewest_events), std::greater<>{});
+  }
+
+  auto& victim = entries.at(fewest_events.back().second);
+  index.erase(victim.ip.to<uint64_t>());
+  index.emplace(key, fewest_events.back().second);
+  std::push_heap(std::begin(fewest_events), std::end(fewest_events), std::greater<>{});
+
+  record replacement{ip};
+  replacement.events = victim.events;
+  replacement.error = victim.events;
+  victim = replacement;
+  return victim;
+}
+
+void champsim::stats::ip_attribution::rebuild_heap()
+{
+  for (auto& [events, idx] : fewest_events) {
+    events = entries.at(idx).events;
+  }
+  std::make_heap(std::begin(fewest_events), std::end(fewest_events), std::greater<>{});
+}
+
+auto champsim::stats::ip_attribution::find(champsim::address ip) const -> const record*
+{
+  auto found = index.find(ip.to<uint64_t>());
+  return found == std::end(index) ? nullptr : &entries.at(found->second);
+}
+
+void champsim::stats::ip_attribution::record_miss(champsim::address ip)
+{
+  if (enabled()) {
+    auto& entry = admit(ip);
+    ++entry.events;
+    ++entry.misses;
+  }
+}
+
+void champsim::stats::ip_attribution::record_late_prefetch(champsim::address ip)
+{
+  if (enabled()) {
+    auto& entry = admit(ip);
+    ++entry.events;
+    ++entry.late_prefetches;
+  }
+}
+
+void champsim::stats::ip_attribution::record_useless_prefetch(champsim::address ip)
+{
+  if (enabled()) {
+    auto& entry = admit(ip);
+    ++entry.events;
+    ++entry.useless_prefetches;
+  }
+}
+
+void champsim::stats::ip_attribution::record_untriggered_late_prefetch()
+{
+  if (enabled()) {
+    ++m_untriggered_late_prefetches;
+  }
+}
+
+void champsim::stats::ip_attribution::record_untriggered_useless_prefetch()
+{
+  if (enabled()) {
+    ++m_untriggered_useless_prefetches;
+  }
+}
+
+void champsim::stats::ip_attribution::record_miss_latency(champsim::address ip, long cycles)
+{
+  if (auto found = index.find(ip.to<uint64_t>()); found != std::end(index)) {
+    auto& entry = entries.at(found->second);
+    entry.miss_latency_cycles += cycles;
+    ++entry.miss_latency_samples;
+  }
+}
+
+auto champsim::stats::ip_attribution::top() const -> std::vector<record>
+{
+  std::vector<record> result;
+  std::copy_if(std::begin(entries), std::end(entries), std::back_inserter(result), [](const auto& x) { return x.events > 0; });
+  std::sort(std::begin(result), std::end(result), [](const auto& x, const auto& y) { return x.events > y.events || (x.events == y.events && x.ip < y.ip); });
+  return result;
+}
+
+auto champsim::stats::ip_attribution::operator-=(const ip_attribution& rhs) -> ip_attribution&
+{
+  // Addresses that were replaced in the meantime keep the counts they gathered since
+  for (auto& entry : entries) {
+    if (const auto* earlier = rhs.find(entry.ip); earlier != nullptr && earlier->events <= entry.events) {
+      entry.events -= earlier->events;
+      entry.misses -= earlier->misses;
+      entry.late_prefetches -= earlier->late_prefetches;
+      entry.useless_prefetches -= earlier->useless_prefetches;
+      entry.miss_latency_cycles -= earlier->miss_latency_cycles;
+      entry.miss_latency_samples -= earlier->miss_latency_samples;
+    }
+  }
+
+  m_untriggered_late_prefetches -= rhs.m_untriggered_late_prefetches;
+  m_untriggered_useless_prefetches -= rhs.m_untriggered_useless_prefetches;
+
+  // The counts fell, so the keys may now be too high
+  rebuild_heap();
+  return *this;
+}
+
+champsim::stats::ip_attribution champsim::stats::operator-(ip_attribution lhs, const ip_attribution& rhs)
+{
+  lhs -= rhs;
+  return lhs;
+}
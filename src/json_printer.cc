@@ -15,11 +15,38 @@
  */
 
 #include <algorithm>
+#include <map>
+#include <string>
 #include <utility>
+#include <fmt/core.h>
 #include <nlohmann/json.hpp>
 
 #include "stats_printer.h"
 
+namespace
+{
+nlohmann::json percentiles(const champsim::stats::latency_histogram& histogram)
+{
+  return nlohmann::json{{"count", histogram.count()},
+                        {"mean", histogram.mean()},
+                        {"p50", histogram.percentile(50)},
+                        {"p90", histogram.percentile(90)},
+                        {"p99", histogram.percentile(99)},
+                        {"p99.9", histogram.percentile(99.9)},
+                        {"max", histogram.max()}};
+}
+
+// Keyed by the lower bound of each power-of-two bucket
+std::map<std::string, long> power_of_two_histogram(const champsim::stats::latency_histogram& histogram)
+{
+  std::map<std::string, long> result;
+  for (auto [lower, count] : histogram.power_of_two_buckets()) {
+    result.emplace(std::to_string(lower), count);
+  }
+  return result;
+}
+} // namespace
+
 void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
 {
   constexpr std::array types{branch_type::BRANCH_DIRECT_JUMP, branch_type::BRANCH_INDIRECT,      branch_type::BRANCH_CONDITIONAL,
@@ -57,6 +84,7 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
     total_downstream_demands -= stats.mshr_return.value_or(std::pair{access_type::PREFETCH, cpu}, mshr_return_value_type{});
 
   statsmap.emplace("miss latency", std::ceil(stats.total_miss_latency_cycles) / std::ceil(total_downstream_demands));
+  statsmap.emplace("miss latency percentiles", percentiles(stats.miss_latency));
   for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
     std::vector<hits_value_type> hits;
     std::vector<misses_value_type> misses;
@@ -71,6 +99,24 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
     statsmap.emplace(access_type_names.at(champsim::to_underlying(type)), nlohmann::json{{"hit", hits}, {"miss", misses}, {"mshr_merge", mshr_merges}});
   }
 
+  if (stats.top_ips.enabled()) {
+    std::vector<nlohmann::json> top_ips;
+    for (const auto& entry : stats.top_ips.top()) {
+      top_ips.push_back(nlohmann::json{{"ip", fmt::format("{:#x}", entry.ip.to<uint64_t>())},
+                                       {"events", entry.events},
+                                       {"error", entry.error},
+                                       {"miss", entry.misses},
+                                       {"late prefetch", entry.late_prefetches},
+                                       {"useless prefetch", entry.useless_prefetches}});
+      if (entry.miss_latency_samples > 0) {
+        top_ips.back().emplace("miss latency", entry.average_miss_latency());
+      }
+    }
+    statsmap.emplace("top IPs", top_ips);
+    statsmap.emplace("untriggered late prefetch", stats.top_ips.untriggered_late_prefetches());
+    statsmap.emplace("untriggered useless prefetch", stats.top_ips.untriggered_useless_prefetches());
+  }
+
   j = statsmap;
 }
 
@@ -81,11 +127,60 @@ void to_json(nlohmann::json& j, const DRAM_CHANNEL::stats_type stats)
                      {"WQ ROW_BUFFER_HIT", stats.WQ_ROW_BUFFER_HIT},
                      {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
                      {"AVG DBUS CONGESTED CYCLE", (std::ceil(stats.dbus_cycle_congested) / std::ceil(stats.dbus_count_congested))},
-                     {"REFRESHES ISSUED", stats.refresh_cycles}};
+                     {"REFRESHES ISSUED", stats.refresh_cycles},
+                     {"read latency percentiles", percentiles(stats.read_latency)}};
+}
+
+void to_json(nlohmann::json& j, const PageTableWalker::stats_type& stats)
+{
+  auto histogram = [](const auto& counter) {
+    std::map<std::string, long> result;
+    for (auto key : counter.get_keys()) {
+      result.emplace(std::to_string(key), counter.value_or(key, 0));
+    }
+    return result;
+  };
+
+  std::map<std::string, nlohmann::json> pscl;
+  auto levels = stats.pscl_hits.get_keys();
+  auto miss_levels = stats.pscl_misses.get_keys();
+  levels.insert(std::end(levels), std::begin(miss_levels), std::end(miss_levels));
+  for (auto level : levels) {
+    pscl.insert_or_assign(std::to_string(level), nlohmann::json{{"hit", stats.pscl_hits.value_or(level, 0)}, {"miss", stats.pscl_misses.value_or(level, 0)}});
+  }
+
+  j = nlohmann::json{{"walks", stats.walks},
+                     {"walk latency", std::ceil(stats.total_walk_latency_cycles) / std::ceil(stats.walks)},
+                     {"PSCL", pscl},
+                     {"walk depth histogram", histogram(stats.walk_depth)},
+                     {"walk latency histogram", power_of_two_histogram(stats.walk_latency)},
+                     {"walk latency percentiles", percentiles(stats.walk_latency)}};
+  if (stats.occupancy_stats) {
+    j.emplace("MSHR occupancy", std::ceil(stats.total_mshr_occupancy) / std::ceil(stats.cycles));
+    j.emplace("concurrent walks histogram", histogram(stats.concurrent_walks));
+  }
 }
 
 namespace champsim
 {
+void to_json(nlohmann::json& j, const champsim::host_profile_stats& stats)
+{
+  std::map<std::string, double> components;
+  std::map<std::string, nlohmann::json> counters;
+  for (const auto& component : stats.components) {
+    components.emplace(component.name, component.time.count());
+    counters.emplace(component.name, nlohmann::json{{"cycles", component.counters.cycles},
+                                                    {"instructions", component.counters.instructions},
+                                                    {"LLC misses", component.counters.llc_misses},
+                                                    {"branch misses", component.counters.branch_misses}});
+  }
+
+  j = nlohmann::json{{"elapsed seconds", stats.elapsed.count()}, {"KIPS", stats.kips()}, {"component seconds", components}};
+  if (stats.counters_available) {
+    j.emplace("component counters", counters);
+  }
+}
+
 void to_json(nlohmann::json& j, const champsim::phase_stats stats)
 {
   std::map<std::string, nlohmann::json> roi_stats;
@@ -94,6 +189,9 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
   for (auto x : stats.roi_cache_stats) {
     roi_stats.emplace(x.name, x);
   }
+  for (auto x : stats.roi_ptw_stats) {
+    roi_stats.emplace(x.name, x);
+  }
 
   std::map<std::string, nlohmann::json> sim_stats;
   sim_stats.emplace("cores", stats.sim_cpu_stats);
@@ -101,12 +199,30 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
   for (auto x : stats.sim_cache_stats) {
     sim_stats.emplace(x.name, x);
   }
+  for (auto x : stats.sim_ptw_stats) {
+    sim_stats.emplace(x.name, x);
+  }
 
   std::map<std::string, nlohmann::json> statsmap{{"name", stats.name}, {"traces", stats.trace_names}};
   statsmap.emplace("roi", roi_stats);
   statsmap.emplace("sim", sim_stats);
+  statsmap.emplace("host_profile", stats.host_profile);
   j = statsmap;
 }
 } // namespace champsim
 
 void champsim::json_printer::print(std::vector<phase_stats>& stats) { stream << nlohmann::json::array_t{std::begin(stats), std::end(stats)}; }
+
+void champsim::json_printer::print(const phase_stats& stats) { stream << nlohmann::json(stats) << '\n'; }
+
+void champsim::json_printer::print(const interval_stats& stats)
+{
+  std::map<std::string, nlohmann::json> sim_stats;
+  sim_stats.emplace("cores", stats.cpus);
+  sim_stats.emplace("DRAM", stats.dram_channels);
+  for (const auto& x : stats.caches) {
+    sim_stats.emplace(x.name, x);
+  }
+
+  stream << nlohmann::json{{"name", stats.phase}, {"warmup", stats.is_warmup}, {"interval", stats.index}, {"sim", sim_stats}} << '\n';
+}
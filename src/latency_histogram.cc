@@ -0,0 +1,139 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "util/bits.h"
+
+namespace
+{
+constexpr uint64_t sub_buckets = uint64_t{1} << champsim::stats::latency_histogram::precision_bits;
+}
+
+std::size_t champsim::stats::latency_histogram::bucket_index(uint64_t value)
+{
+  if (value < sub_buckets) {
+    return static_cast<std::size_t>(value);
+  }
+
+  // Keep the most significant precision_bits + 1 bits of the value
+  const auto shift = champsim::lg2(value) - precision_bits;
+  return static_cast<std::size_t>((shift + 1) * sub_buckets + ((value >> shift) - sub_buckets));
+}
+
+uint64_t champsim::stats::latency_histogram::bucket_lower_bound(std::size_t index)
+{
+  if (index < sub_buckets) {
+    return index;
+  }
+
+  const auto shift = index / sub_buckets - 1;
+  return (sub_buckets + index % sub_buckets) << shift;
+}
+
+uint64_t champsim::stats::latency_histogram::bucket_upper_bound(std::size_t index) { return bucket_lower_bound(index + 1) - 1; }
+
+void champsim::stats::latency_histogram::record(long value)
+{
+  const auto index = bucket_index(static_cast<uint64_t>(std::max(value, 0L)));
+  if (index >= std::size(buckets)) {
+    buckets.resize(index + 1);
+  }
+  ++buckets[index];
+  ++m_count;
+  m_sum += std::max(value, 0L);
+}
+
+double champsim::stats::latency_histogram::mean() const { return std::ceil(m_sum) / std::ceil(m_count); }
+
+uint64_t champsim::stats::latency_histogram::percentile(double pct) const
+{
+  if (m_count <= 0) {
+    return 0;
+  }
+
+  const auto target = std::max<value_type>(1, static_cast<value_type>(std::ceil(pct / 100.0 * static_cast<double>(m_count))));
+  value_type seen = 0;
+  for (std::size_t i = 0; i < std::size(buckets); ++i) {
+    seen += buckets[i];
+    if (seen >= target) {
+      return bucket_upper_bound(i);
+    }
+  }
+  return bucket_upper_bound(std::size(buckets) - 1);
+}
+
+auto champsim::stats::latency_histogram::value_or(std::size_t index, value_type default_value) const -> value_type
+{
+  return index < std::size(buckets) ? buckets[index] : default_value;
+}
+
+auto champsim::stats::latency_histogram::power_of_two_buckets() const -> std::vector<std::pair<uint64_t, value_type>>
+{
+  // Every power of two begins a fine bucket, so each fine bucket lies within one coarse bucket
+  std::vector<std::pair<uint64_t, value_type>> result{};
+  for (std::size_t i = 0; i < std::size(buckets); ++i) {
+    if (buckets[i] == 0) {
+      continue;
+    }
+
+    const auto lower = bucket_lower_bound(i);
+    const auto coarse_lower = (lower == 0) ? 0 : (uint64_t{1} << champsim::lg2(lower));
+    if (std::empty(result) || result.back().first != coarse_lower) {
+      result.emplace_back(coarse_lower, 0);
+    }
+    result.back().second += buckets[i];
+  }
+  return result;
+}
+
+auto champsim::stats::latency_histogram::operator+=(const latency_histogram& rhs) -> latency_histogram&
+{
+  if (std::size(rhs.buckets) > std::size(buckets)) {
+    buckets.resize(std::size(rhs.buckets));
+  }
+  std::transform(std::begin(rhs.buckets), std::end(rhs.buckets), std::begin(buckets), std::begin(buckets), std::plus<>{});
+  m_count += rhs.m_count;
+  m_sum += rhs.m_sum;
+  return *this;
+}
+
+auto champsim::stats::latency_histogram::operator-=(const latency_histogram& rhs) -> latency_histogram&
+{
+  if (std::size(rhs.buckets) > std::size(buckets)) {
+    buckets.resize(std::size(rhs.buckets));
+  }
+  std::transform(std::begin(rhs.buckets), std::end(rhs.buckets), std::begin(buckets), std::begin(buckets), [](auto x, auto y) { return y - x; });
+  m_count -= rhs.m_count;
+  m_sum -= rhs.m_sum;
+  return *this;
+}
+
+champsim::stats::latency_histogram champsim::stats::operator+(latency_histogram lhs, const latency_histogram& rhs)
+{
+  lhs += rhs;
+  return lhs;
+}
+
+champsim::stats::latency_histogram champsim::stats::operator-(latency_histogram lhs, const latency_histogram& rhs)
+{
+  lhs -= rhs;
+  return lhs;
+}
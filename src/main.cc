@@ -16,6 +16,8 @@
 
 #include <algorithm>
 #include <fstream>
+#include <iterator>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -30,8 +32,13 @@
 #endif
 #include "defaults.hpp"
 #include "environment.h"
+#include "geometry_overrides.h"
+#include "host_counters.h"
+#include "interval_stats.h"
+#include "module_registry.h"
 #include "ooo_cpu.h" // for O3_CPU
 #include "phase_info.h"
+#include "policy_control.h"
 #include "stats_printer.h"
 #include "tracereader.h"
 #include "vmem.h"
@@ -55,28 +62,30 @@ const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
 #ifndef CHAMPSIM_TEST_BUILD
 int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 {
-  configured_environment gen_environment{};
-
   CLI::App app{"A microarchitecture simulator for research and education"};
 
   bool knob_cloudsuite{false};
   bool knob_verbose{false};
+  bool knob_hide_heartbeat{false};
+  bool knob_host_counters{false};
   long long warmup_instructions = 0;
   long long simulation_instructions = std::numeric_limits<long long>::max();
   long subtrace_count = 1;
+  long long stats_interval = 0;
+  std::string interval_file_name;
   std::string json_file_name;
   std::string checkpoint_path;
+  std::string dram_capture_name;
+  std::string module_config_name;
+  std::string control_in_name;
+  std::string control_out_name;
+  std::string override_file_name;
+  std::vector<std::string> override_strings;
   std::vector<std::string> trace_names;
 
-  auto set_heartbeat_callback = [&](auto) {
-    for (O3_CPU& cpu : gen_environment.cpu_view()) {
-      cpu.show_heartbeat = false;
-    }
-  };
-
   app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
   app.add_flag("--verbose", knob_verbose, "Enable detailed console output");
-  app.add_flag("--hide-heartbeat", set_heartbeat_callback, "Hide the heartbeat output");
+  app.add_flag("--hide-heartbeat", knob_hide_heartbeat, "Hide the heartbeat output");
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
@@ -90,6 +99,28 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   app.add_option("--subtrace-count", subtrace_count, "Number of simulation subtraces to run sequentially after warmup")->check(CLI::PositiveNumber);
   app.add_option("--cache-checkpoint", checkpoint_path, "Path to cache checkpoint log file used to persist cache contents between phases")
       ->expected(0, 1);
+  app.add_option("--dram-capture", dram_capture_name, "The name of the file to receive a record of each request accepted by the memory controller after warmup");
+  app.add_flag("--host-counters", knob_host_counters, "Count host hardware events for each component with Linux perf events");
+  auto* interval_file_option =
+      app.add_option("--interval-stats", interval_file_name, "The name of the file to receive the statistics of each interval as newline-delimited JSON");
+  auto* stats_interval_option =
+      app.add_option("--stats-interval", stats_interval, "The number of instructions, retired across all CPUs, in each interval of --interval-stats")
+          ->check(CLI::PositiveNumber)
+          ->needs(interval_file_option);
+  interval_file_option->needs(stats_interval_option);
+  app.add_option("--module-config", module_config_name,
+                 "A JSON file choosing the prefetcher or replacement policy of each cache. The executable must be configured with \"runtime_modules\": true")
+      ->check(CLI::ExistingFile);
+  auto* control_in_option =
+      app.add_option("--control-in", control_in_name, "A file or named pipe from which to read commands between phases. See --control-out")->check(CLI::ExistingFile);
+  auto* control_out_option =
+      app.add_option("--control-out", control_out_name, "A file or named pipe to receive the statistics of each phase as it ends, for an external controller")
+          ->needs(control_in_option);
+  control_in_option->needs(control_out_option);
+  app.add_option("--override", override_strings,
+                 "Replace a configured parameter of a cache, core, or the DRAM, as COMPONENT.PARAMETER=VALUE (for example LLC.sets=4096). May be repeated");
+  app.add_option("--override-file", override_file_name, "A JSON file of parameters to replace, keyed by component like the configuration file. --override is applied after it")
+      ->check(CLI::ExistingFile);
 
   app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
 
@@ -98,11 +129,51 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   const bool warmup_given = (warmup_instr_option->count() > 0) || (deprec_warmup_instr_option->count() > 0);
   const bool simulation_given = (sim_instr_option->count() > 0) || (deprec_sim_instr_option->count() > 0);
 
-  if (!knob_verbose) {
-    set_heartbeat_callback(0);
+  champsim::geometry_overrides overrides;
+  try {
+    if (!override_file_name.empty()) {
+      std::ifstream override_file{override_file_name};
+      overrides.add_json(std::string{std::istreambuf_iterator<char>{override_file}, std::istreambuf_iterator<char>{}});
+    }
+    for (const auto& override_string : override_strings) {
+      overrides.add(override_string);
+    }
+  } catch (const std::exception& err) {
+    fmt::print("ERROR: {}\n", err.what());
+    return 1;
+  }
+
+  configured_environment gen_environment{overrides};
+  try {
+    overrides.validate(gen_environment, configured_environment::dram_name);
+  } catch (const std::exception& err) {
+    fmt::print("ERROR: {}\n", err.what());
+    return 1;
+  }
+
+  if (!knob_verbose || knob_hide_heartbeat) {
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      cpu.show_heartbeat = false;
+    }
   }
   gen_environment.dram_view().set_verbose(knob_verbose);
 
+  if (knob_host_counters) {
+    if (auto reason = champsim::perf_counter_group::instance().open(); !reason.empty()) {
+      fmt::print("WARNING: host hardware counters are unavailable ({}). Continuing without them.\n", reason);
+    }
+  }
+
+  std::ofstream dram_capture_file;
+  if (!dram_capture_name.empty()) {
+    dram_capture_file.open(dram_capture_name);
+    if (!dram_capture_file.is_open()) {
+      fmt::print("ERROR: Unable to open '{}' for writing the DRAM capture\n", dram_capture_name);
+      return 1;
+    }
+    gen_environment.dram_view().set_capture(&dram_capture_file);
+  }
+
   if (deprec_warmup_instr_option->count() > 0) {
     fmt::print("WARNING: option --warmup_instructions is deprecated. Use --warmup-instructions instead.\n");
   }
@@ -127,6 +198,46 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     return 1;
   }
 
+  if (!module_config_name.empty()) {
+    std::ifstream module_config_file{module_config_name};
+    std::string selection{std::istreambuf_iterator<char>{module_config_file}, std::istreambuf_iterator<char>{}};
+    try {
+      champsim::select_modules(gen_environment.runtime_modules(), gen_environment.cache_view(), selection);
+    } catch (const std::exception& err) {
+      fmt::print("ERROR: {} ({})\n", err.what(), module_config_name);
+      return 1;
+    }
+  }
+
+  // Open the commands first, so a controller may open its ends of two named pipes in the same order
+  std::ifstream control_in_file;
+  std::ofstream control_out_file;
+  std::shared_ptr<champsim::policy_controller> controller;
+  if (!control_in_name.empty()) {
+    control_in_file.open(control_in_name);
+    if (!control_in_file.is_open()) {
+      fmt::print("ERROR: Unable to open '{}' for reading the controller's commands\n", control_in_name);
+      return 1;
+    }
+    control_out_file.open(control_out_name);
+    if (!control_out_file.is_open()) {
+      fmt::print("ERROR: Unable to open '{}' for writing the phase statistics\n", control_out_name);
+      return 1;
+    }
+    controller = std::make_shared<champsim::policy_controller>(control_in_file, control_out_file, gen_environment.runtime_modules());
+  }
+
+  std::ofstream interval_file;
+  std::shared_ptr<champsim::interval_writer> interval_sink;
+  if (stats_interval > 0) {
+    interval_file.open(interval_file_name);
+    if (!interval_file.is_open()) {
+      fmt::print("ERROR: Unable to open '{}' for writing the interval statistics\n", interval_file_name);
+      return 1;
+    }
+    interval_sink = std::make_shared<champsim::interval_writer>(interval_file);
+  }
+
   std::vector<champsim::tracereader> traces;
   std::transform(
       std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
@@ -145,6 +256,9 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     phase.length = length;
     phase.trace_index = default_trace_index;
     phase.trace_names = trace_names;
+    phase.stats_interval = stats_interval;
+    phase.interval_sink = interval_sink;
+    phase.controller = controller;
     return phase;
   };
 
@@ -175,6 +289,10 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 
   auto phase_stats = champsim::main(gen_environment, phases, traces);
 
+  if (interval_sink != nullptr) {
+    interval_sink->close();
+  }
+
   if (knob_verbose) {
     fmt::print("\nChampSim completed all CPUs\n\n");
   }
@@ -0,0 +1,162 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "module_registry.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+template <typename Map>
+std::vector<std::string> keys_of(const Map& map)
+{
+  std::vector<std::string> result;
+  std::transform(std::begin(map), std::end(map), std::back_inserter(result), [](const auto& x) { return x.first; });
+  return result;
+}
+} // namespace
+
+bool champsim::names_cache(const std::string& key, const std::string& cache_name)
+{
+  const auto suffix = "_" + key;
+  return cache_name == key
+         || (std::size(cache_name) > std::size(suffix) && cache_name.compare(std::size(cache_name) - std::size(suffix), std::size(suffix), suffix) == 0);
+}
+
+std::vector<std::string> champsim::module_registry::prefetcher_names() const { return keys_of(prefetchers); }
+
+std::vector<std::string> champsim::module_registry::replacement_names() const { return keys_of(replacements); }
+
+auto champsim::module_registry::find_prefetcher(const std::string& name) const -> const prefetcher_factory&
+{
+  auto found = prefetchers.find(name);
+  if (found == std::end(prefetchers)) {
+    throw std::invalid_argument{fmt::format("No prefetcher named '{}' is available. The choices are: {}", name, fmt::join(prefetcher_names(), ", "))};
+  }
+  return found->second;
+}
+
+auto champsim::module_registry::find_replacement(const std::string& name) const -> const replacement_factory&
+{
+  auto found = replacements.find(name);
+  if (found == std::end(replacements)) {
+    throw std::invalid_argument{
+        fmt::format("No replacement policy named '{}' is available. The choices are: {}", name, fmt::join(replacement_names(), ", "))};
+  }
+  return found->second;
+}
+
+void champsim::module_registry::set_prefetcher(CACHE& cache, const std::string& name) const { cache.pref_module_pimpl = find_prefetcher(name)(&cache); }
+
+void champsim::module_registry::set_replacement(CACHE& cache, const std::string& name) const { cache.repl_module_pimpl = find_replacement(name)(&cache); }
+
+void champsim::module_registry::switch_prefetcher(CACHE& cache, const std::string& name) const { cache.switch_prefetcher(find_prefetcher(name)(&cache)); }
+
+void champsim::module_registry::switch_replacement(CACHE& cache, const std::string& name) const
+{
+  cache.switch_replacement(find_replacement(name)(&cache));
+}
+
+namespace
+{
+struct module_choice {
+  std::reference_wrapper<CACHE> cache;
+  bool is_prefetcher;
+  std::string name;
+};
+
+// Check the whole selection before any of it is applied
+std::vector<module_choice> parse_selection(const champsim::module_registry& registry, const std::vector<std::reference_wrapper<CACHE>>& caches,
+                                           const std::string& selection_json)
+{
+  if (registry.empty()) {
+    throw std::invalid_argument{"This executable has no modules to select from. Configure it with \"runtime_modules\": true."};
+  }
+
+  nlohmann::json selection;
+  try {
+    selection = nlohmann::json::parse(selection_json);
+  } catch (const nlohmann::json::parse_error& err) {
+    throw std::invalid_argument{fmt::format("A module selection must be valid JSON: {}", err.what())};
+  }
+  if (!selection.is_object()) {
+    throw std::invalid_argument{"A module selection must be a JSON object keyed by cache name"};
+  }
+
+  std::vector<module_choice> choices;
+  for (const auto& [key, modules] : selection.items()) {
+    if (!modules.is_object()) {
+      throw std::invalid_argument{fmt::format("The module selection for '{}' must be a JSON object", key)};
+    }
+
+    bool matched = false;
+    for (CACHE& cache : caches) {
+      if (!champsim::names_cache(key, cache.NAME)) {
+        continue;
+      }
+      matched = true;
+
+      for (const auto& [kind, name] : modules.items()) {
+        if (!name.is_string()) {
+          throw std::invalid_argument{fmt::format("The {} selected for '{}' must be a single module name", kind, key)};
+        }
+
+        if (kind == "prefetcher") {
+          (void)registry.find_prefetcher(name.get<std::string>());
+          choices.push_back({cache, true, name.get<std::string>()});
+        } else if (kind == "replacement") {
+          (void)registry.find_replacement(name.get<std::string>());
+          choices.push_back({cache, false, name.get<std::string>()});
+        } else {
+          throw std::invalid_argument{fmt::format("Only the prefetcher and replacement of a cache can be selected, not '{}'", kind)};
+        }
+      }
+    }
+
+    if (!matched) {
+      throw std::invalid_argument{fmt::format("The module selection names '{}', which matches no cache", key)};
+    }
+  }
+
+  return choices;
+}
+} // namespace
+
+void champsim::select_modules(const module_registry& registry, const std::vector<std::reference_wrapper<CACHE>>& caches, const std::string& selection_json)
+{
+  for (const auto& choice : parse_selection(registry, caches, selection_json)) {
+    if (choice.is_prefetcher) {
+      registry.set_prefetcher(choice.cache, choice.name);
+    } else {
+      registry.set_replacement(choice.cache, choice.name);
+    }
+  }
+}
+
+void champsim::switch_modules(const module_registry& registry, const std::vector<std::reference_wrapper<CACHE>>& caches, const std::string& selection_json)
+{
+  for (const auto& choice : parse_selection(registry, caches, selection_json)) {
+    if (choice.is_prefetcher) {
+      registry.switch_prefetcher(choice.cache, choice.name);
+    } else {
+      registry.switch_replacement(choice.cache, choice.name);
+    }
+  }
+}
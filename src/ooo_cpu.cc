@@ -61,11 +61,16 @@ long O3_CPU::operate()
     auto phase_instr{std::ceil(num_retired - begin_phase_instr)};
     auto phase_cycle{double_duration{current_time - begin_phase_time} / clock_period};
 
-    fmt::print("Heartbeat CPU {} instructions: {} cycles: {} heartbeat IPC: {:.4g} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", cpu,
-               num_retired, current_time.time_since_epoch() / clock_period, heartbeat_instr / heartbeat_cycle, phase_instr / phase_cycle, elapsed_time());
+    const auto heartbeat_host_now = std::chrono::steady_clock::now();
+    const std::chrono::duration<double, std::milli> heartbeat_host_time{heartbeat_host_now - last_heartbeat_host_time};
+
+    fmt::print("Heartbeat CPU {} instructions: {} cycles: {} heartbeat IPC: {:.4g} cumulative IPC: {:.4g} KIPS: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n",
+               cpu, num_retired, current_time.time_since_epoch() / clock_period, heartbeat_instr / heartbeat_cycle, phase_instr / phase_cycle,
+               heartbeat_instr / heartbeat_host_time.count(), elapsed_time());
 
     last_heartbeat_instr = num_retired;
     last_heartbeat_time = current_time;
+    last_heartbeat_host_time = heartbeat_host_now;
   }
 
   return progress;
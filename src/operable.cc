@@ -33,7 +33,7 @@ long champsim::operable::operate_on(const champsim::chrono::clock& clock)
 long champsim::operable::_operate()
 {
   current_time += clock_period;
-  return operate();
+  return host_time.measure([this] { return operate(); });
 }
 
 uint64_t champsim::operable::current_cycle() const { return static_cast<uint64_t>(current_time.time_since_epoch() / clock_period); }
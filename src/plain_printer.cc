@@ -145,6 +145,52 @@ std::vector<std::string> champsim::plain_printer::format(DRAM_CHANNEL::stats_typ
   return lines;
 }
 
+std::vector<std::string> champsim::plain_printer::format(PageTableWalker::stats_type stats)
+{
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("{} WALKS: {:10} AVERAGE WALK LATENCY: {} cycles AVERAGE MSHR OCCUPANCY: {}", stats.name, stats.walks,
+                              ::print_ratio(stats.total_walk_latency_cycles, stats.walks), ::print_ratio(stats.total_mshr_occupancy, stats.cycles)));
+
+  auto levels = stats.pscl_hits.get_keys();
+  auto miss_levels = stats.pscl_misses.get_keys();
+  levels.insert(std::end(levels), std::begin(miss_levels), std::end(miss_levels));
+  std::sort(std::begin(levels), std::end(levels), std::greater{});
+  levels.erase(std::unique(std::begin(levels), std::end(levels)), std::end(levels));
+  for (auto level : levels) {
+    lines.push_back(
+        fmt::format("{} PSCL{} HIT: {:10} MISS: {:10}", stats.name, level, stats.pscl_hits.value_or(level, 0), stats.pscl_misses.value_or(level, 0)));
+  }
+
+  for (auto depth : stats.walk_depth.get_keys()) {
+    lines.push_back(fmt::format("{} WALK DEPTH {}: {:10}", stats.name, depth, stats.walk_depth.value_or(depth, 0)));
+  }
+  for (auto [lower, count] : stats.walk_latency.power_of_two_buckets()) {
+    lines.push_back(fmt::format("{} WALK LATENCY [{}, {}): {:10}", stats.name, lower, std::max(2 * lower, uint64_t{1}), count));
+  }
+  for (auto count : stats.concurrent_walks.get_keys()) {
+    lines.push_back(fmt::format("{} CONCURRENT WALKS {}: {:10}", stats.name, count, stats.concurrent_walks.value_or(count, 0)));
+  }
+
+  return lines;
+}
+
+std::vector<std::string> champsim::plain_printer::format(const champsim::host_profile_stats& stats)
+{
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("Simulation speed: {:.4g} KIPS elapsed: {:.4g} s", stats.kips(), stats.elapsed.count()));
+  for (const auto& component : stats.components) {
+    auto share = (stats.elapsed.count() > 0) ? fmt::format("{:.4g}", 100 * component.time.count() / stats.elapsed.count()) : std::string{"-"};
+    lines.push_back(fmt::format("{} host time: {:.4g} s ({}%)", component.name, component.time.count(), share));
+    if (stats.counters_available) {
+      const auto& counts = component.counters;
+      lines.push_back(fmt::format("{} host cycles: {} instructions: {} IPC: {} LLC misses: {} branch misses: {}", component.name, counts.cycles,
+                                  counts.instructions, ::print_ratio(counts.instructions, counts.cycles), counts.llc_misses, counts.branch_misses));
+    }
+  }
+
+  return lines;
+}
+
 void champsim::plain_printer::print(champsim::phase_stats& stats)
 {
   auto lines = format(stats);
@@ -176,6 +222,11 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
       auto sublines = format(stat);
       std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
     }
+
+    for (const auto& stat : stats.sim_ptw_stats) {
+      auto sublines = format(stat);
+      std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+    }
   }
 
   lines.emplace_back("");
@@ -193,6 +244,11 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
     std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
   }
 
+  for (const auto& stat : stats.roi_ptw_stats) {
+    auto sublines = format(stat);
+    std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+  }
+
   lines.emplace_back("");
   lines.emplace_back("DRAM Statistics");
   for (const auto& stat : stats.roi_dram_stats) {
@@ -201,6 +257,11 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
     std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
   }
 
+  lines.emplace_back("");
+  lines.emplace_back("Host Profile");
+  auto sublines = format(stats.host_profile);
+  std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+
   return lines;
 }
 
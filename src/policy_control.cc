@@ -0,0 +1,58 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "policy_control.h"
+
+#include <exception>
+#include <string>
+#include <nlohmann/json.hpp>
+
+#include "environment.h"
+#include "phase_info.h"
+#include "stats_printer.h"
+
+champsim::policy_controller::policy_controller(std::istream& in_stream, std::ostream& out_stream, module_registry modules)
+    : in(in_stream), out(out_stream), registry(std::move(modules))
+{
+}
+
+bool champsim::policy_controller::phase_complete(environment& env, const phase_stats& stats)
+{
+  champsim::json_printer{out}.print(stats);
+  out.flush();
+
+  std::string command;
+  while (std::getline(in, command)) {
+    if (command.empty() || command == "continue") {
+      return true;
+    }
+
+    if (command == "stop") {
+      return false;
+    }
+
+    try {
+      champsim::switch_modules(registry, env.cache_view(), command);
+      out << nlohmann::json{{"ok", true}} << '\n';
+    } catch (const std::exception& err) {
+      out << nlohmann::json{{"error", err.what()}} << '\n';
+    }
+    out.flush();
+  }
+
+  return false;
+}
@@ -34,7 +34,7 @@ PageTableWalker::PageTableWalker(champsim::ptw_builder b)
       MSHR_SIZE(b.m_mshr_size.value_or(std::lround(b.m_mshr_factor * std::floor(std::size(upper_levels))))),
       MAX_READ(b.m_max_tag_check.value_or(champsim::bandwidth::maximum_type{b.scaled_by_ul_size(b.m_bandwidth_factor)})),
       MAX_FILL(b.m_max_fill.value_or(champsim::bandwidth::maximum_type{b.scaled_by_ul_size(b.m_bandwidth_factor)})),
-      HIT_LATENCY(b.m_clock_period * b.m_latency), vmem(b.m_vmem), CR3_addr(b.m_vmem->get_pte_pa(b.m_cpu, champsim::page_number{}, b.m_vmem->pt_levels).first)
+      HIT_LATENCY(b.m_clock_period * b.m_latency), occupancy_stats(b.m_occupancy_stats), vmem(b.m_vmem), CR3_addr(b.m_vmem->get_pte_pa(b.m_cpu, champsim::page_number{}, b.m_vmem->pt_levels).first)
 {
   std::vector<decltype(b.m_pscl)::value_type> local_pscl_dims{};
   std::remove_copy_if(std::begin(b.m_pscl), std::end(b.m_pscl), std::back_inserter(local_pscl_dims), [](auto x) { return std::get<0>(x) == 0; });
@@ -42,6 +42,7 @@ PageTableWalker::PageTableWalker(champsim::ptw_builder b)
 
   for (auto [level, sets, ways] : local_pscl_dims) {
     pscl.emplace_back(sets, ways, pscl_indexer{b.m_vmem->shamt(level)}, pscl_indexer{b.m_vmem->shamt(level)});
+    pscl_levels.push_back(level);
   }
 }
 
@@ -66,6 +67,8 @@ auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type*
       vmem->get_offset(handle_pkt.address, walk_init.level)};
 
   mshr_type fwd_mshr{handle_pkt, walk_init.level};
+  fwd_mshr.walk_start_level = walk_init.level;
+  fwd_mshr.walk_start = current_time;
   fwd_mshr.address = champsim::address{champsim::splice(champsim::page_number{walk_init.ptw_addr}, champsim::page_offset{walk_offset})};
   fwd_mshr.v_address = handle_pkt.address;
   if (handle_pkt.response_requested) {
@@ -77,7 +80,21 @@ auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type*
                walk_offset.to<int>(), walk_init.level, current_time.time_since_epoch() / clock_period);
   }
 
-  return step_translation(fwd_mshr);
+  auto result = step_translation(fwd_mshr);
+  if (result.has_value()) {
+    for (std::size_t i = 0; i < std::size(pscl); ++i) {
+      if (pscl_hits.at(i).has_value()) {
+        sim_stats.pscl_hits.increment(pscl_levels.at(i));
+      } else {
+        sim_stats.pscl_misses.increment(pscl_levels.at(i));
+      }
+    }
+    if (occupancy_stats) {
+      sim_stats.concurrent_walks.increment(std::size(MSHR) + std::size(finished));
+    }
+  }
+
+  return result;
 }
 
 auto PageTableWalker::handle_fill(const mshr_type& fill_mshr) -> std::optional<mshr_type>
@@ -123,6 +140,11 @@ long PageTableWalker::operate()
 {
   long progress{0};
 
+  if (occupancy_stats) {
+    sim_stats.total_mshr_occupancy += std::size(MSHR);
+    ++sim_stats.cycles;
+  }
+
   auto is_ready = [time = current_time](const auto& pkt) {
     return pkt.data.is_ready_at(time);
   };
@@ -134,7 +156,8 @@ long PageTableWalker::operate()
 
   champsim::bandwidth fill_bw{MAX_FILL};
   auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(completed), std::cend(completed), fill_bw, is_ready);
-  std::for_each(complete_begin, complete_end, [](auto& mshr_entry) {
+  std::for_each(complete_begin, complete_end, [this](auto& mshr_entry) {
+    this->record_walk(mshr_entry);
     for (auto ret : mshr_entry.to_return) {
       ret->emplace_back(mshr_entry.v_address, mshr_entry.v_address, *mshr_entry.data, mshr_entry.pf_metadata, mshr_entry.instr_depend_on_me);
     }
@@ -209,21 +232,49 @@ void PageTableWalker::finish_packet(const response_type& packet)
   auto matches_addr = [block = champsim::block_number{packet.address}](auto x) {
     return champsim::block_number{x.address} == block;
   };
-  auto is_last_step = [](auto x) {
-    return x.translation_level <= 0;
+  // Walks for large pages end at the level that holds the large page entry
+  auto is_last_step = [vmem = this->vmem](const auto& x) {
+    return x.translation_level <= vmem->leaf_level(x.cpu, champsim::page_number{x.v_address});
   };
   auto last_finished = std::partition(std::begin(MSHR), std::end(MSHR), matches_addr);
 
-  std::for_each(std::begin(MSHR), last_finished, [is_last_step, finish_step, finish_last_step](auto& mshr_entry) {
-    mshr_entry.data = is_last_step(mshr_entry) ? finish_last_step(mshr_entry) : finish_step(mshr_entry);
+  // Decide which walks are complete before translating, since a translation may promote its region to a large page
+  std::vector<bool> is_complete{};
+  std::transform(std::begin(MSHR), last_finished, std::back_inserter(is_complete), is_last_step);
+
+  auto complete_it = std::cbegin(is_complete);
+  std::for_each(std::begin(MSHR), last_finished, [&complete_it, finish_step, finish_last_step](auto& mshr_entry) {
+    mshr_entry.data = *(complete_it++) ? finish_last_step(mshr_entry) : finish_step(mshr_entry);
   });
 
-  std::partition_copy(std::begin(MSHR), last_finished, std::back_inserter(completed), std::back_inserter(finished), is_last_step);
+  complete_it = std::cbegin(is_complete);
+  std::partition_copy(std::begin(MSHR), last_finished, std::back_inserter(completed), std::back_inserter(finished),
+                      [&complete_it](const auto&) { return *(complete_it++); });
   MSHR.erase(std::begin(MSHR), last_finished);
 }
 
+void PageTableWalker::record_walk(const mshr_type& mshr_entry)
+{
+  const auto latency = (current_time - mshr_entry.walk_start) / clock_period;
+  ++sim_stats.walks;
+  sim_stats.total_walk_latency_cycles += latency;
+  sim_stats.walk_depth.increment(mshr_entry.walk_start_level - mshr_entry.translation_level + 1);
+  sim_stats.walk_latency.record(latency);
+}
+
 void PageTableWalker::begin_phase()
 {
+  stats_type new_roi_stats;
+  stats_type new_sim_stats;
+
+  new_roi_stats.name = NAME;
+  new_sim_stats.name = NAME;
+  new_roi_stats.occupancy_stats = occupancy_stats;
+  new_sim_stats.occupancy_stats = occupancy_stats;
+
+  roi_stats = new_roi_stats;
+  sim_stats = new_sim_stats;
+
   for (auto* ul : upper_levels) {
     channel_type::stats_type ul_new_roi_stats;
     channel_type::stats_type ul_new_sim_stats;
@@ -232,6 +283,8 @@ void PageTableWalker::begin_phase()
   }
 }
 
+void PageTableWalker::end_phase(unsigned /*cpu*/) { roi_stats = sim_stats; }
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void PageTableWalker::print_deadlock()
 {
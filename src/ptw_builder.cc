@@ -97,6 +97,18 @@ auto champsim::ptw_builder::virtual_memory(VirtualMemory* vmem_) -> ptw_builder&
   return *this;
 }
 
+auto champsim::ptw_builder::set_occupancy_stats() -> ptw_builder&
+{
+  m_occupancy_stats = true;
+  return *this;
+}
+
+auto champsim::ptw_builder::reset_occupancy_stats() -> ptw_builder&
+{
+  m_occupancy_stats = false;
+  return *this;
+}
+
 auto champsim::ptw_builder::scaled_by_ul_size(double factor) const -> uint32_t
 {
   return factor < 0 ? 0 : static_cast<uint32_t>(std::lround(factor * std::floor(std::size(m_uls))));
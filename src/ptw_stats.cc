@@ -0,0 +1,15 @@
+#include "ptw_stats.h"
+
+ptw_stats operator-(ptw_stats lhs, ptw_stats rhs)
+{
+  lhs.pscl_hits -= rhs.pscl_hits;
+  lhs.pscl_misses -= rhs.pscl_misses;
+  lhs.walks -= rhs.walks;
+  lhs.total_walk_latency_cycles -= rhs.total_walk_latency_cycles;
+  lhs.walk_depth -= rhs.walk_depth;
+  lhs.walk_latency -= rhs.walk_latency;
+  lhs.concurrent_walks -= rhs.concurrent_walks;
+  lhs.total_mshr_occupancy -= rhs.total_mshr_occupancy;
+  lhs.cycles -= rhs.cycles;
+  return lhs;
+}
@@ -0,0 +1,278 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <fmt/core.h>
+
+namespace
+{
+// General-purpose registers, which exclude the stack pointer, flags, and instruction pointer that identify branches
+constexpr std::array<unsigned char, 29> chain_registers{1,  2,  3,  4,  5,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+                                                        17, 18, 19, 20, 21, 22, 23, 24, 27, 28, 29, 30, 31, 32};
+
+// Conditional branches jump within this many slots, so that they form loops and short forward skips
+constexpr int64_t conditional_reach = 64;
+
+// Calls deeper than this overwrite the oldest return addresses
+constexpr std::size_t max_call_depth = 64;
+
+constexpr uint64_t chase_granule = 64;
+
+void validate(const champsim::trace_generator_spec& spec)
+{
+  if (spec.code_footprint < 4) {
+    throw std::invalid_argument{fmt::format("The code footprint ({} bytes) must hold at least one instruction", spec.code_footprint)};
+  }
+  if (spec.load_fraction < 0 || spec.store_fraction < 0 || spec.branch_fraction < 0
+      || spec.load_fraction + spec.store_fraction + spec.branch_fraction > 1) {
+    throw std::invalid_argument{fmt::format("The load, store, and branch fractions ({}, {}, {}) must be non-negative and sum to at most 1",
+                                            spec.load_fraction, spec.store_fraction, spec.branch_fraction)};
+  }
+  if (spec.branch_predictability < 0.5 || spec.branch_predictability > 1) {
+    throw std::invalid_argument{fmt::format("The branch predictability ({}) must be between 0.5 and 1", spec.branch_predictability)};
+  }
+  if ((spec.load_fraction > 0 || spec.store_fraction > 0) && std::empty(spec.streams)) {
+    throw std::invalid_argument{"A trace with loads or stores must have at least one data stream"};
+  }
+  for (const auto& stream : spec.streams) {
+    if (stream.base == 0 || stream.footprint < chase_granule) {
+      throw std::invalid_argument{
+          fmt::format("A data stream must have a nonzero base and a footprint of at least {} bytes (base {:#x}, footprint {})", chase_granule, stream.base, stream.footprint)};
+    }
+  }
+}
+} // namespace
+
+champsim::trace_generator::phase::phase(trace_generator_spec spec_) : spec(std::move(spec_)), rng(spec.seed)
+{
+  validate(spec);
+
+  const auto branch_weight_total = spec.conditional_weight + spec.direct_jump_weight + spec.indirect_weight + spec.call_weight + spec.return_weight;
+  auto branch_share = [&](double weight) {
+    return branch_weight_total > 0 ? spec.branch_fraction * weight / branch_weight_total : 0;
+  };
+  std::discrete_distribution<int> kind_dist{1 - spec.load_fraction - spec.store_fraction - spec.branch_fraction,
+                                            spec.load_fraction,
+                                            spec.store_fraction,
+                                            branch_share(spec.conditional_weight),
+                                            branch_share(spec.direct_jump_weight),
+                                            branch_share(spec.indirect_weight),
+                                            branch_share(spec.call_weight),
+                                            branch_share(spec.return_weight)};
+
+  std::vector<double> stream_weights;
+  std::transform(std::begin(spec.streams), std::end(spec.streams), std::back_inserter(stream_weights), [](const auto& s) { return s.weight; });
+  std::discrete_distribution<std::size_t> stream_dist{std::begin(stream_weights), std::end(stream_weights)};
+
+  const auto num_slots = static_cast<int64_t>(spec.code_footprint / 4);
+  std::uniform_int_distribution<int64_t> any_slot{0, num_slots - 1};
+  std::uniform_int_distribution<int64_t> near_slot{-conditional_reach, conditional_reach};
+  std::bernoulli_distribution coin{};
+
+  program.resize(static_cast<std::size_t>(num_slots));
+  for (int64_t i = 0; i < num_slots; ++i) {
+    auto& s = program.at(static_cast<std::size_t>(i));
+    s.kind = static_cast<slot_kind>(kind_dist(rng));
+    switch (s.kind) {
+    case slot_kind::load:
+    case slot_kind::store: {
+      s.stream = stream_dist(rng);
+      const auto& stream = spec.streams.at(s.stream);
+      s.cursor = std::uniform_int_distribution<uint64_t>{0, stream.footprint / chase_granule - 1}(rng)*chase_granule;
+      break;
+    }
+    case slot_kind::conditional:
+      s.taken_probability = coin(rng) ? spec.branch_predictability : 1 - spec.branch_predictability;
+      s.targets.push_back(static_cast<uint64_t>(std::clamp<int64_t>(i + near_slot(rng), 0, num_slots - 1)));
+      break;
+    case slot_kind::direct_jump:
+    case slot_kind::call:
+    case slot_kind::ret:
+      s.targets.push_back(static_cast<uint64_t>(any_slot(rng)));
+      break;
+    case slot_kind::indirect:
+      s.targets.resize(std::max<std::size_t>(spec.indirect_targets, 1));
+      std::generate(std::begin(s.targets), std::end(s.targets), [&] { return static_cast<uint64_t>(any_slot(rng)); });
+      break;
+    case slot_kind::alu:
+      break;
+    }
+  }
+
+  for (const auto& params : spec.streams) {
+    auto& state = streams.emplace_back(stream_state{params});
+    if (params.kind == trace_generator_spec::stream_kind::pointer_chase) {
+      // A single random cycle through every granule of the footprint
+      std::vector<uint32_t> order(params.footprint / chase_granule);
+      std::iota(std::begin(order), std::end(order), 0);
+      std::shuffle(std::begin(order), std::end(order), rng);
+      state.next_element.resize(std::size(order));
+      for (std::size_t i = 0; i < std::size(order); ++i) {
+        state.next_element.at(order.at(i)) = order.at((i + 1) % std::size(order));
+      }
+      state.current = order.front();
+    }
+  }
+
+  chain_position.resize(std::clamp<std::size_t>(spec.dependency_chains, 1, std::size(chain_registers)));
+}
+
+uint64_t champsim::trace_generator::phase::address_for(slot& s)
+{
+  auto& stream = streams.at(s.stream);
+  switch (stream.params.kind) {
+  case trace_generator_spec::stream_kind::stride: {
+    auto result = stream.params.base + s.cursor;
+    auto footprint = static_cast<int64_t>(stream.params.footprint);
+    auto next = (static_cast<int64_t>(s.cursor) + stream.params.stride) % footprint;
+    s.cursor = static_cast<uint64_t>(next < 0 ? next + footprint : next);
+    return result;
+  }
+  case trace_generator_spec::stream_kind::pointer_chase:
+    stream.current = stream.next_element.at(stream.current);
+    return stream.params.base + stream.current * chase_granule;
+  case trace_generator_spec::stream_kind::random:
+    return stream.params.base + std::uniform_int_distribution<uint64_t>{0, stream.params.footprint / 8 - 1}(rng)*8;
+  }
+  return stream.params.base;
+}
+
+void champsim::trace_generator::phase::set_registers(input_instr& instr, slot_kind kind)
+{
+  const auto chain = next_chain;
+  const auto reg = chain_registers.at(chain);
+  auto& position = chain_position.at(chain);
+
+  switch (kind) {
+  case slot_kind::alu:
+  case slot_kind::load:
+    // The first instruction of a chain has no register inputs
+    if (position > 0) {
+      instr.source_registers[0] = reg;
+    }
+    instr.destination_registers[0] = reg;
+    break;
+  case slot_kind::store:
+    instr.source_registers[0] = reg;
+    break;
+  case slot_kind::conditional:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[1] = champsim::REG_FLAGS;
+    return;
+  case slot_kind::direct_jump:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    return;
+  case slot_kind::indirect:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[0] = reg;
+    return;
+  case slot_kind::call:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.destination_registers[1] = champsim::REG_STACK_POINTER;
+    instr.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[1] = champsim::REG_STACK_POINTER;
+    return;
+  case slot_kind::ret:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.destination_registers[1] = champsim::REG_STACK_POINTER;
+    instr.source_registers[0] = champsim::REG_STACK_POINTER;
+    return;
+  }
+
+  position = (position + 1) % std::max<std::size_t>(spec.chain_length, 1);
+  next_chain = (next_chain + 1) % std::size(chain_position);
+}
+
+input_instr champsim::trace_generator::phase::next()
+{
+  auto& s = program.at(pc);
+  input_instr instr{};
+  instr.ip = spec.code_base + 4 * pc;
+  set_registers(instr, s.kind);
+
+  auto next_pc = (pc + 1) % std::size(program);
+  switch (s.kind) {
+  case slot_kind::load:
+    instr.source_memory[0] = address_for(s);
+    break;
+  case slot_kind::store:
+    instr.destination_memory[0] = address_for(s);
+    break;
+  case slot_kind::conditional:
+    instr.branch_taken = std::bernoulli_distribution{s.taken_probability}(rng);
+    if (instr.branch_taken) {
+      next_pc = s.targets.front();
+    }
+    break;
+  case slot_kind::direct_jump:
+    instr.branch_taken = true;
+    next_pc = s.targets.front();
+    break;
+  case slot_kind::indirect:
+    instr.branch_taken = true;
+    next_pc = s.targets.at(std::uniform_int_distribution<std::size_t>{0, std::size(s.targets) - 1}(rng));
+    break;
+  case slot_kind::call:
+    instr.branch_taken = true;
+    if (std::size(call_stack) == max_call_depth) {
+      call_stack.erase(std::begin(call_stack));
+    }
+    call_stack.push_back(next_pc);
+    next_pc = s.targets.front();
+    break;
+  case slot_kind::ret:
+    // A return with no matching call goes to a fixed target instead
+    instr.branch_taken = true;
+    if (std::empty(call_stack)) {
+      next_pc = s.targets.front();
+    } else {
+      next_pc = call_stack.back();
+      call_stack.pop_back();
+    }
+    break;
+  case slot_kind::alu:
+    break;
+  }
+
+  instr.is_branch = (s.kind != slot_kind::alu && s.kind != slot_kind::load && s.kind != slot_kind::store);
+  pc = next_pc;
+  return instr;
+}
+
+champsim::trace_generator::trace_generator(std::vector<trace_generator_spec> phase_specs)
+{
+  if (std::empty(phase_specs)) {
+    throw std::invalid_argument{"A trace generator must have at least one phase"};
+  }
+  std::transform(std::begin(phase_specs), std::end(phase_specs), std::back_inserter(phases), [](auto spec) { return phase{std::move(spec)}; });
+}
+
+input_instr champsim::trace_generator::operator()()
+{
+  if (auto length = phases.at(current_phase).spec.length; length > 0 && phase_count == length) {
+    current_phase = (current_phase + 1) % std::size(phases);
+    phase_count = 0;
+  }
+
+  ++phase_count;
+  return phases.at(current_phase).next();
+}
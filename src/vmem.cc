@@ -16,7 +16,9 @@
 
 #include "vmem.h"
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 #include <fmt/core.h>
 
 #include "champsim.h"
@@ -26,11 +28,12 @@
 using namespace champsim::data::data_literals;
 
 VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
-                             MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_)
+                             MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_, champsim::large_page_policy large_page_policy_)
     : randomization_seed(randomization_seed_), dram(dram_), minor_fault_penalty(minor_penalty), pt_levels(page_table_levels),
       pte_page_size(page_table_page_size),
       next_pte_page(
-          champsim::dynamic_extent{champsim::data::bits{LOG2_PAGE_SIZE}, champsim::data::bits{champsim::lg2(champsim::data::bytes{pte_page_size}.count())}}, 0)
+          champsim::dynamic_extent{champsim::data::bits{LOG2_PAGE_SIZE}, champsim::data::bits{champsim::lg2(champsim::data::bytes{pte_page_size}.count())}}, 0),
+      large_pages(std::move(large_page_policy_))
 {
   assert(pte_page_size > 1_kiB);
   assert(champsim::is_power_of_2(pte_page_size.count()));
@@ -48,8 +51,28 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
       fmt::print("[VMEM] WARNING: physical memory size is smaller than virtual memory size.\n"); // LCOV_EXCL_LINE
     }
   }
+  if (large_pages.page_size > champsim::data::bytes{0}) {
+    // Find the level whose entries span one large page
+    champsim::data::bytes span{PAGE_SIZE};
+    for (std::size_t level = 1; level < pt_levels && large_page_level == 0; ++level) {
+      span = span * pte_page_size.count();
+      if (span == large_pages.page_size) {
+        large_page_level = level;
+      }
+    }
+
+    if (large_page_level == 0) {
+      throw std::invalid_argument{fmt::format("Large page size of {} bytes is not the span of a page table entry", large_pages.page_size.count())};
+    }
+  }
+
   populate_pages();
-  shuffle_pages();
+}
+
+VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
+                             MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_)
+    : VirtualMemory(page_table_page_size, page_table_levels, minor_penalty, dram_, randomization_seed_, {})
+{
 }
 
 VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
@@ -61,20 +84,32 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
 void VirtualMemory::populate_pages()
 {
   assert(dram.size() > 1_MiB);
-  ppage_free_list.resize(((dram.size() - 1_MiB) / PAGE_SIZE).count());
-  assert(ppage_free_list.size() != 0);
-  champsim::page_number base_address =
-      champsim::page_number{champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
-  for (auto it = ppage_free_list.begin(); it != ppage_free_list.end(); it++) {
-    *it = base_address;
-    base_address++;
+  const auto total_pages = static_cast<uint64_t>(((dram.size() - 1_MiB) / PAGE_SIZE).count());
+  assert(total_pages != 0);
+  ppage_base = champsim::page_number{champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
+  ppage_next = 0;
+  ppage_count = total_pages;
+  large_frame_top = total_pages;
+
+  if (large_page_level != 0) {
+    // Set aside whole, aligned frames at the top of memory. Base pages are drawn only from below them.
+    const auto base = ppage_base.to<uint64_t>();
+    const auto top = ((base + total_pages) / pages_per_large_page()) * pages_per_large_page();
+    const auto reserved_pages = large_pages.reserved > champsim::data::bytes{0} ? static_cast<uint64_t>(large_pages.reserved.count()) / PAGE_SIZE : total_pages / 2;
+    const auto reserved_frames = reserved_pages / pages_per_large_page();
+    if (reserved_frames > 0) {
+      if (top <= base + reserved_frames * pages_per_large_page()) {
+        throw std::invalid_argument{fmt::format("Reserving {} bytes for large pages leaves no physical memory for base pages", large_pages.reserved.count())};
+      }
+      large_frame_top = top - base;
+      ppage_count = large_frame_top - reserved_frames * pages_per_large_page();
+    }
   }
-}
 
-void VirtualMemory::shuffle_pages()
-{
-  if (randomization_seed.has_value())
-    std::shuffle(ppage_free_list.begin(), ppage_free_list.end(), std::mt19937_64{randomization_seed.value()});
+  large_frame_floor = ppage_count;
+  if (randomization_seed.has_value()) {
+    ppage_order.emplace(ppage_count, randomization_seed.value());
+  }
 }
 
 champsim::dynamic_extent VirtualMemory::extent(std::size_t level) const
@@ -93,41 +128,162 @@ uint64_t VirtualMemory::get_offset(champsim::page_number vaddr, std::size_t leve
 champsim::page_number VirtualMemory::ppage_front() const
 {
   assert(available_ppages() > 0);
-  return ppage_free_list.front();
+  return ppage_base + static_cast<champsim::page_number::difference_type>(ppage_index(ppage_next));
 }
 
+uint64_t VirtualMemory::ppage_index(uint64_t position) const { return ppage_order.has_value() ? ppage_order.value()(position) : position; }
+
 void VirtualMemory::ppage_pop()
 {
-  ppage_free_list.pop_front();
+  ++ppage_next;
   if (available_ppages() == 0) {
     if (dram.is_verbose()) {
       fmt::print("[VMEM] WARNING: Out of physical memory, freeing ppages\n");
     }
-    populate_pages();
-    shuffle_pages();
+    ppage_next = 0;
+  }
+}
+
+champsim::open_addressing_map& VirtualMemory::table_for(uint32_t cpu_num, std::size_t level)
+{
+  if (cpu_num >= std::size(translation_tables)) {
+    translation_tables.resize(cpu_num + 1);
+  }
+
+  auto& asid_tables = translation_tables[cpu_num];
+  if (level >= std::size(asid_tables)) {
+    asid_tables.resize(std::max(level, pt_levels) + 1);
+  }
+
+  return asid_tables[level];
+}
+
+uint64_t VirtualMemory::pages_per_large_page() const
+{
+  return uint64_t{1} << (champsim::lg2(pte_page_size.count()) * large_page_level);
+}
+
+uint64_t VirtualMemory::large_page_region(champsim::page_number vaddr) const { return vaddr.to<uint64_t>() / pages_per_large_page(); }
+
+bool VirtualMemory::large_page_eligible(uint32_t cpu_num, champsim::page_number vaddr) const
+{
+  if (large_page_level == 0) {
+    return false;
+  }
+
+  const auto& asids = large_pages.asids;
+  if (!std::empty(asids) && std::find(std::begin(asids), std::end(asids), cpu_num) == std::end(asids)) {
+    return false;
+  }
+
+  // The whole region must lie within one of the ranges
+  const auto first_page = large_page_region(vaddr) * pages_per_large_page();
+  const champsim::address region_begin{champsim::page_number{first_page}};
+  const champsim::address region_last{champsim::page_number{first_page + pages_per_large_page() - 1}};
+  const auto& ranges = large_pages.ranges;
+  return std::empty(ranges) || std::any_of(std::begin(ranges), std::end(ranges), [region_begin, region_last](const auto& range) {
+           return range.first <= region_begin && region_last < range.second;
+         });
+}
+
+const uint64_t* VirtualMemory::find_base_page(uint32_t cpu_num, champsim::page_number vaddr) const
+{
+  if (cpu_num >= std::size(translation_tables) || std::empty(translation_tables[cpu_num])) {
+    return nullptr;
+  }
+  return translation_tables[cpu_num][0].find(vaddr.to<uint64_t>());
+}
+
+const uint64_t* VirtualMemory::find_large_frame(uint32_t cpu_num, champsim::page_number vaddr) const
+{
+  if (large_page_level == 0 || cpu_num >= std::size(large_page_frames)) {
+    return nullptr;
+  }
+  return large_page_frames[cpu_num].find(large_page_region(vaddr));
+}
+
+std::optional<uint64_t> VirtualMemory::map_large_page(uint32_t cpu_num, champsim::page_number vaddr)
+{
+  // Carve the next frame from the reserved pool, below the existing frames
+  if (large_frame_top < large_frame_floor + pages_per_large_page()) {
+    return std::nullopt;
+  }
+
+  large_frame_top -= pages_per_large_page();
+  const auto frame = ppage_base.to<uint64_t>() + large_frame_top;
+
+  if (cpu_num >= std::size(large_page_frames)) {
+    large_page_frames.resize(cpu_num + 1);
+  }
+  large_page_frames[cpu_num].try_emplace(large_page_region(vaddr), frame);
+
+  if constexpr (champsim::debug_print) {
+    if (dram.is_verbose()) {
+      fmt::print("[VMEM] {} vpage: {} frame: {}\n", __func__, vaddr, champsim::page_number{frame});
+    }
   }
+
+  return frame;
 }
 
-std::size_t VirtualMemory::available_ppages() const { return (ppage_free_list.size()); }
+std::size_t VirtualMemory::leaf_level(uint32_t cpu_num, champsim::page_number vaddr) const
+{
+  if (find_large_frame(cpu_num, vaddr) != nullptr) {
+    return find_base_page(cpu_num, vaddr) == nullptr ? large_page_level : 0;
+  }
+  if (large_pages.promotion_threshold <= 1 && large_page_eligible(cpu_num, vaddr) && large_frame_top >= large_frame_floor + pages_per_large_page()) {
+    return large_page_level;
+  }
+  return 0;
+}
+
+std::size_t VirtualMemory::available_ppages() const { return static_cast<std::size_t>(ppage_count - ppage_next); }
 
 std::pair<champsim::page_number, champsim::chrono::clock::duration> VirtualMemory::va_to_pa(uint32_t cpu_num, champsim::page_number vaddr)
 {
-  auto [ppage, fault] = vpage_to_ppage_map.try_emplace({cpu_num, champsim::page_number{vaddr}}, ppage_front());
+  // Base pages mapped before their region was promoted are kept, so that a translation never changes
+  if (large_page_level != 0 && find_base_page(cpu_num, vaddr) == nullptr) {
+    const auto page_in_region = vaddr.to<uint64_t>() % pages_per_large_page();
+    if (const auto* frame = find_large_frame(cpu_num, vaddr); frame != nullptr) {
+      return {champsim::page_number{*frame + page_in_region}, champsim::chrono::clock::duration::zero()};
+    }
+
+    if (large_pages.promotion_threshold <= 1 && large_page_eligible(cpu_num, vaddr)) {
+      if (auto frame = map_large_page(cpu_num, vaddr); frame.has_value()) {
+        return {champsim::page_number{*frame + page_in_region}, minor_fault_penalty};
+      }
+    }
+  }
+
+  // Draw a physical page only on a miss, since finding the next page in the permutation is not free
+  auto [ppage_raw, fault] = table_for(cpu_num, 0).try_emplace_with(vaddr.to<uint64_t>(), [this] { return ppage_front().to<uint64_t>(); });
+  champsim::page_number ppage{ppage_raw};
 
   // this vpage doesn't yet have a ppage mapping
   if (fault) {
     ppage_pop();
+
+    // Promote the region once enough of its base pages have been touched. Later translations use the large page.
+    if (large_page_eligible(cpu_num, vaddr)) {
+      if (cpu_num >= std::size(region_touches)) {
+        region_touches.resize(cpu_num + 1);
+      }
+      auto& touches = region_touches[cpu_num].try_emplace(large_page_region(vaddr), 0).first;
+      if (++touches >= large_pages.promotion_threshold) {
+        map_large_page(cpu_num, vaddr);
+      }
+    }
   }
 
   auto penalty = fault ? minor_fault_penalty : champsim::chrono::clock::duration::zero();
 
   if constexpr (champsim::debug_print) {
     if (dram.is_verbose()) {
-      fmt::print("[VMEM] {} paddr: {} vpage: {} fault: {}\n", __func__, ppage->second, champsim::page_number{vaddr}, fault);
+      fmt::print("[VMEM] {} paddr: {} vpage: {} fault: {}\n", __func__, ppage, champsim::page_number{vaddr}, fault);
     }
   }
 
-  return std::pair{ppage->second, penalty};
+  return std::pair{ppage, penalty};
 }
 
 std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::get_pte_pa(uint32_t cpu_num, champsim::page_number vaddr, std::size_t level)
@@ -138,8 +294,10 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
   }
 
   champsim::dynamic_extent pte_table_entry_extent{champsim::address::bits, shamt(level)};
-  auto [ppage, fault] =
-      page_table.try_emplace({cpu_num, level, champsim::address_slice{pte_table_entry_extent, vaddr}}, champsim::splice(active_pte_page, next_pte_page));
+  auto [pte_raw, fault] = table_for(cpu_num, level).try_emplace_with(champsim::address_slice{pte_table_entry_extent, vaddr}.to<uint64_t>(), [this] {
+    return champsim::address{champsim::splice(active_pte_page, next_pte_page)}.to<uint64_t>();
+  });
+  champsim::address pte_page{pte_raw};
 
   // this PTE doesn't yet have a mapping
   if (fault) {
@@ -148,9 +306,9 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
 
   auto offset = get_offset(vaddr, level);
   champsim::address paddr{
-      champsim::splice(ppage->second, champsim::address_slice{champsim::dynamic_extent{champsim::data::bits{champsim::lg2(pte_entry::byte_multiple)},
-                                                                                       static_cast<std::size_t>(champsim::lg2(pte_page_size.count()))},
-                                                              offset})};
+      champsim::splice(pte_page, champsim::address_slice{champsim::dynamic_extent{champsim::data::bits{champsim::lg2(pte_entry::byte_multiple)},
+                                                                                  static_cast<std::size_t>(champsim::lg2(pte_page_size.count()))},
+                                                         offset})};
   if constexpr (champsim::debug_print) {
     if (dram.is_verbose()) {
       fmt::print("[VMEM] {} paddr: {} vaddr: {} pt_page_offset: {} translation_level: {} fault: {}\n", __func__, paddr, vaddr, offset, level, fault);
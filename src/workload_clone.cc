@@ -0,0 +1,384 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "workload_clone.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include "util/to_underlying.h"
+
+namespace
+{
+// General-purpose registers, which exclude the stack pointer, flags, and instruction pointer that identify branches
+constexpr std::array<unsigned char, 29> clone_registers{1,  2,  3,  4,  5,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+                                                        17, 18, 19, 20, 21, 22, 23, 24, 27, 28, 29, 30, 31, 32};
+
+// Reuse is measured between blocks of this size, independent of the cache configuration
+constexpr uint64_t reuse_granule = 64;
+
+// Blocks that the profile saw for the first time are drawn from a region above any user-space address
+constexpr uint64_t cold_region = uint64_t{1} << 48;
+
+bool is_special(PHYSICAL_REGISTER_ID reg)
+{
+  return reg == champsim::REG_STACK_POINTER || reg == champsim::REG_FLAGS || reg == champsim::REG_INSTRUCTION_POINTER;
+}
+
+std::size_t log2_bucket(uint64_t distance, std::size_t last)
+{
+  std::size_t bucket = 0;
+  while (distance > 1 && bucket < last) {
+    distance >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+// The most frequent entries of a histogram, most frequent first
+template <typename K>
+std::vector<std::pair<K, uint64_t>> most_common(const std::map<K, uint64_t>& histogram, std::size_t count)
+{
+  std::vector<std::pair<K, uint64_t>> result{std::begin(histogram), std::end(histogram)};
+  std::stable_sort(std::begin(result), std::end(result), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+  result.resize(std::min(std::size(result), count));
+  return result;
+}
+
+template <typename R>
+bool all_zero(const R& range)
+{
+  return std::all_of(std::begin(range), std::end(range), [](auto x) { return x == 0; });
+}
+} // namespace
+
+namespace champsim
+{
+void to_json(nlohmann::json& j, const workload_profile::ip_model& model)
+{
+  j = nlohmann::json{{"ip", model.ip},
+                     {"count", model.count},
+                     {"branch", champsim::to_underlying(model.branch)},
+                     {"loads", model.loads},
+                     {"stores", model.stores},
+                     {"strides", model.strides},
+                     {"other strides", model.other_strides},
+                     {"reuse", model.reuse},
+                     {"dependency", model.dependency},
+                     {"taken", model.taken},
+                     {"after taken", model.after_taken},
+                     {"taken after taken", model.taken_after_taken},
+                     {"taken after not taken", model.taken_after_not_taken},
+                     {"targets", model.targets}};
+  if (model.fallthrough.has_value()) {
+    j.emplace("fallthrough", model.fallthrough.value());
+  }
+}
+
+void from_json(const nlohmann::json& j, workload_profile::ip_model& model)
+{
+  model.ip = j.at("ip").get<uint64_t>();
+  model.count = j.at("count").get<uint64_t>();
+  model.branch = static_cast<branch_type>(j.value("branch", champsim::to_underlying(NOT_BRANCH)));
+  model.loads = j.value("loads", model.loads);
+  model.stores = j.value("stores", model.stores);
+  model.strides = j.value("strides", model.strides);
+  model.other_strides = j.value("other strides", model.other_strides);
+  model.reuse = j.value("reuse", model.reuse);
+  model.dependency = j.value("dependency", model.dependency);
+  model.taken = j.value("taken", model.taken);
+  model.after_taken = j.value("after taken", model.after_taken);
+  model.taken_after_taken = j.value("taken after taken", model.taken_after_taken);
+  model.taken_after_not_taken = j.value("taken after not taken", model.taken_after_not_taken);
+  model.targets = j.value("targets", model.targets);
+  if (j.contains("fallthrough")) {
+    model.fallthrough = j.at("fallthrough").get<uint64_t>();
+  }
+}
+} // namespace champsim
+
+void champsim::write_workload_profile(std::ostream& stream, const workload_profile& profile)
+{
+  stream << nlohmann::json{{"instructions", profile.instructions}, {"first ip", profile.first_ip}, {"ips", profile.ips}};
+}
+
+auto champsim::read_workload_profile(std::istream& stream) -> workload_profile
+{
+  auto j = nlohmann::json::parse(stream);
+  workload_profile result;
+  result.instructions = j.at("instructions").get<uint64_t>();
+  result.first_ip = j.at("first ip").get<uint64_t>();
+  result.ips = j.at("ips").get<std::vector<workload_profile::ip_model>>();
+  return result;
+}
+
+void champsim::workload_profiler::operator()(const ooo_model_instr& instr)
+{
+  const auto ip = instr.ip.to<uint64_t>();
+  if (instr_count == 0) {
+    first_ip = ip;
+  }
+
+  // The successor of the previous instruction
+  if (previous.has_value()) {
+    auto& prev = ips.at(previous->first);
+    ++(previous->second ? prev.targets : prev.fallthroughs)[ip];
+  }
+
+  auto& state = ips[ip];
+  auto& model = state.model;
+  model.ip = ip;
+  model.branch = instr.branch;
+  ++model.count;
+
+  // Branch bias and transitions
+  if (instr.is_branch) {
+    model.taken += instr.branch_taken ? 1 : 0;
+    if (state.last_taken.has_value()) {
+      if (state.last_taken.value()) {
+        ++model.after_taken;
+        model.taken_after_taken += instr.branch_taken ? 1 : 0;
+      } else {
+        model.taken_after_not_taken += instr.branch_taken ? 1 : 0;
+      }
+    }
+    state.last_taken = instr.branch_taken;
+  }
+
+  // Register dependency on the nearest producer
+  std::optional<uint64_t> distance;
+  for (auto reg : instr.source_registers) {
+    if (auto producer = register_producer.at(reg); !is_special(reg) && producer.has_value()) {
+      distance = std::min(distance.value_or(instr_count - producer.value()), instr_count - producer.value());
+    }
+  }
+  constexpr auto no_dependency = workload_profile::dependency_buckets - 1;
+  ++model.dependency.at(distance.has_value() ? log2_bucket(distance.value(), no_dependency) : no_dependency);
+  for (auto reg : instr.destination_registers) {
+    register_producer.at(reg) = instr_count;
+  }
+
+  // Memory strides and reuse
+  model.loads += std::empty(instr.source_memory) ? 0 : 1;
+  model.stores += std::empty(instr.destination_memory) ? 0 : 1;
+  auto record_access = [&](champsim::address address) {
+    const auto addr = address.to<uint64_t>();
+    if (state.last_address.has_value()) {
+      ++state.strides[static_cast<int64_t>(addr - state.last_address.value())];
+    }
+    state.last_address = addr;
+
+    constexpr auto cold = workload_profile::reuse_buckets - 1;
+    auto [last_access, inserted] = block_last_access.try_emplace(addr / reuse_granule, access_count);
+    ++model.reuse.at(inserted ? cold : log2_bucket(access_count - last_access->second, cold - 1));
+    last_access->second = access_count;
+    ++access_count;
+  };
+  std::for_each(std::begin(instr.source_memory), std::end(instr.source_memory), record_access);
+  std::for_each(std::begin(instr.destination_memory), std::end(instr.destination_memory), record_access);
+
+  previous = {ip, instr.is_branch && instr.branch_taken};
+  ++instr_count;
+}
+
+auto champsim::workload_profiler::profile() const -> workload_profile
+{
+  workload_profile result;
+  result.instructions = instr_count;
+  result.first_ip = first_ip;
+
+  for (const auto& [ip, state] : ips) {
+    auto& model = result.ips.emplace_back(state.model);
+    model.strides = most_common(state.strides, max_strides);
+    model.other_strides = std::accumulate(std::begin(state.strides), std::end(state.strides), uint64_t{0}, [](auto acc, const auto& x) { return acc + x.second; })
+                          - std::accumulate(std::begin(model.strides), std::end(model.strides), uint64_t{0}, [](auto acc, const auto& x) { return acc + x.second; });
+    model.targets = most_common(state.targets, max_targets);
+    if (auto fallthrough = most_common(state.fallthroughs, 1); !std::empty(fallthrough)) {
+      model.fallthrough = fallthrough.front().first;
+    }
+  }
+
+  std::sort(std::begin(result.ips), std::end(result.ips), [](const auto& lhs, const auto& rhs) { return lhs.ip < rhs.ip; });
+  return result;
+}
+
+champsim::clone_generator::clone_generator(workload_profile profile_, uint64_t seed) : profile(std::move(profile_)), rng(seed)
+{
+  if (std::empty(profile.ips)) {
+    throw std::invalid_argument{"A workload profile must have at least one instruction"};
+  }
+
+  for (std::size_t i = 0; i < std::size(profile.ips); ++i) {
+    index_of.emplace(profile.ips.at(i).ip, i);
+  }
+  last_address.resize(std::size(profile.ips));
+  last_taken.resize(std::size(profile.ips));
+
+  if (auto first = index_of.find(profile.first_ip); first != std::end(index_of)) {
+    current = first->second;
+  }
+}
+
+uint64_t champsim::clone_generator::address_for(std::size_t index)
+{
+  const auto& model = profile.ips.at(index);
+  auto& last = last_address.at(index);
+
+  std::optional<uint64_t> result;
+
+  // Follow one of the recorded strides, if this instruction has accessed memory before
+  auto stride_total = std::accumulate(std::begin(model.strides), std::end(model.strides), model.other_strides,
+                                      [](auto acc, const auto& x) { return acc + x.second; });
+  if (last.has_value() && stride_total > 0) {
+    std::vector<uint64_t> weights;
+    std::transform(std::begin(model.strides), std::end(model.strides), std::back_inserter(weights), [](const auto& x) { return x.second; });
+    weights.push_back(model.other_strides);
+    std::discrete_distribution<std::size_t> stride_dist{std::begin(weights), std::end(weights)};
+    if (auto choice = stride_dist(rng); choice < std::size(model.strides)) {
+      result = last.value() + static_cast<uint64_t>(model.strides.at(choice).first);
+    }
+  }
+
+  // Otherwise, revisit a block at the sampled reuse distance, or touch a new one
+  if (!result.has_value()) {
+    constexpr auto cold = workload_profile::reuse_buckets - 1;
+    auto bucket = cold;
+    if (!all_zero(model.reuse)) {
+      bucket = std::discrete_distribution<std::size_t>{std::begin(model.reuse), std::end(model.reuse)}(rng);
+    }
+
+    uint64_t block = 0;
+    auto distance = std::uniform_int_distribution<uint64_t>{uint64_t{1} << bucket, (uint64_t{2} << bucket) - 1}(rng);
+    if (bucket != cold && distance <= std::min<uint64_t>(access_count, history_size)) {
+      block = block_history.at((access_count - distance) % history_size);
+    } else {
+      block = cold_region / reuse_granule + next_cold_block++;
+    }
+    result = block * reuse_granule + last.value_or(0) % reuse_granule;
+  }
+
+  auto addr = result.value() == 0 ? reuse_granule : result.value();
+  block_history.at(access_count % history_size) = addr / reuse_granule;
+  ++access_count;
+  last = addr;
+  return addr;
+}
+
+input_instr champsim::clone_generator::operator()()
+{
+  const auto& model = profile.ips.at(current);
+  input_instr instr{};
+  instr.ip = model.ip;
+  instr.is_branch = (model.branch != NOT_BRANCH);
+
+  // A source register written at the sampled dependency distance, if that instruction wrote one
+  unsigned char dependence = 0;
+  if (constexpr auto no_dependency = workload_profile::dependency_buckets - 1; !all_zero(model.dependency)) {
+    auto bucket = std::discrete_distribution<std::size_t>{std::begin(model.dependency), std::end(model.dependency)}(rng);
+    auto distance = std::uniform_int_distribution<uint64_t>{uint64_t{1} << bucket, (uint64_t{2} << bucket) - 1}(rng);
+    if (bucket != no_dependency && distance <= std::min<uint64_t>(instr_count, std::size(clone_registers) - 1)) {
+      dependence = register_history.at((instr_count - distance) % dependency_window);
+    }
+  }
+
+  // Branches are encoded with the registers that ooo_model_instr decodes into their type
+  auto& produced = register_history.at(instr_count % dependency_window);
+  produced = 0;
+  switch (model.branch) {
+  case BRANCH_DIRECT_JUMP:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    break;
+  case BRANCH_INDIRECT:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[0] = dependence != 0 ? dependence : clone_registers.front();
+    break;
+  case BRANCH_CONDITIONAL:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[1] = champsim::REG_FLAGS;
+    instr.source_registers[2] = dependence;
+    break;
+  case BRANCH_DIRECT_CALL:
+  case BRANCH_INDIRECT_CALL:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.destination_registers[1] = champsim::REG_STACK_POINTER;
+    instr.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[1] = champsim::REG_STACK_POINTER;
+    if (model.branch == BRANCH_INDIRECT_CALL) {
+      instr.source_registers[2] = dependence != 0 ? dependence : clone_registers.front();
+    }
+    break;
+  case BRANCH_RETURN:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.destination_registers[1] = champsim::REG_STACK_POINTER;
+    instr.source_registers[0] = champsim::REG_STACK_POINTER;
+    break;
+  case BRANCH_OTHER:
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    instr.source_registers[0] = dependence;
+    break;
+  case NOT_BRANCH:
+    produced = clone_registers.at(instr_count % std::size(clone_registers));
+    instr.destination_registers[0] = produced;
+    instr.source_registers[0] = dependence;
+    break;
+  }
+
+  // Memory accesses, at the rate that this instruction made them
+  if (model.count > 0) {
+    if (std::bernoulli_distribution{static_cast<double>(model.loads) / static_cast<double>(model.count)}(rng)) {
+      instr.source_memory[0] = address_for(current);
+    }
+    if (std::bernoulli_distribution{static_cast<double>(model.stores) / static_cast<double>(model.count)}(rng)) {
+      instr.destination_memory[0] = address_for(current);
+    }
+  }
+
+  // Branch direction, from the transition rates of this branch
+  if (instr.is_branch) {
+    auto not_after_taken = std::max<uint64_t>(model.count, 1) - 1 - std::min(std::max<uint64_t>(model.count, 1) - 1, model.after_taken);
+    double probability = model.count > 0 ? static_cast<double>(model.taken) / static_cast<double>(model.count) : 0;
+    if (last_taken.at(current) && model.after_taken > 0) {
+      probability = static_cast<double>(model.taken_after_taken) / static_cast<double>(model.after_taken);
+    } else if (!last_taken.at(current) && not_after_taken > 0) {
+      probability = static_cast<double>(model.taken_after_not_taken) / static_cast<double>(not_after_taken);
+    }
+    instr.branch_taken = std::bernoulli_distribution{std::clamp(probability, 0.0, 1.0)}(rng);
+    last_taken.at(current) = instr.branch_taken;
+  }
+
+  // The next instruction is one of the profiled successors in the chosen direction. Where the profile has none, the walk restarts.
+  std::optional<uint64_t> next_ip;
+  if (instr.branch_taken && !std::empty(model.targets)) {
+    std::vector<uint64_t> weights;
+    std::transform(std::begin(model.targets), std::end(model.targets), std::back_inserter(weights), [](const auto& x) { return x.second; });
+    next_ip = model.targets.at(std::discrete_distribution<std::size_t>{std::begin(weights), std::end(weights)}(rng)).first;
+  } else if (!instr.branch_taken) {
+    next_ip = model.fallthrough;
+  }
+
+  auto next = index_of.find(next_ip.value_or(profile.first_ip));
+  if (next == std::end(index_of)) {
+    next = index_of.find(profile.first_ip);
+  }
+  current = next != std::end(index_of) ? next->second : 0;
+
+  ++instr_count;
+  return instr;
+}
@@ -0,0 +1,113 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include "environment.h"
+#include "operable.h"
+
+namespace
+{
+struct recording_operable : champsim::operable {
+  std::vector<int>* log;
+  int id;
+
+  recording_operable(champsim::chrono::picoseconds period, std::vector<int>* log_, int id_) : operable(period), log(log_), id(id_) {}
+
+  long operate() final
+  {
+    log->push_back(id);
+    return 1;
+  }
+};
+
+struct other_operable : recording_operable {
+  using recording_operable::recording_operable;
+};
+} // namespace
+
+TEST_CASE("Statically ordered operables operate in the same order as sorted operables")
+{
+  std::vector<int> static_log{};
+  std::vector<int> dynamic_log{};
+
+  std::vector<champsim::chrono::picoseconds> periods{champsim::chrono::picoseconds{300}, champsim::chrono::picoseconds{200},
+                                                     champsim::chrono::picoseconds{250}, champsim::chrono::picoseconds{200}};
+
+  recording_operable sa{periods.at(0), &static_log, 0};
+  other_operable sb{periods.at(1), &static_log, 1};
+  recording_operable sc{periods.at(2), &static_log, 2};
+  other_operable sd{periods.at(3), &static_log, 3};
+  champsim::operable_tuple<recording_operable, other_operable, recording_operable, other_operable> components{std::tie(sa, sb, sc, sd)};
+
+  recording_operable da{periods.at(0), &dynamic_log, 0};
+  recording_operable db{periods.at(1), &dynamic_log, 1};
+  recording_operable dc{periods.at(2), &dynamic_log, 2};
+  recording_operable dd{periods.at(3), &dynamic_log, 3};
+  champsim::chrono::clock static_clock{};
+  champsim::chrono::clock dynamic_clock{};
+  long static_progress{0};
+  long dynamic_progress{0};
+  for (int i = 0; i < 1000; ++i) {
+    static_clock.tick(champsim::chrono::picoseconds{200});
+    static_progress += components.operate_on(static_clock);
+
+    dynamic_clock.tick(champsim::chrono::picoseconds{200});
+    std::vector<std::reference_wrapper<champsim::operable>> operables{da, db, dc, dd};
+    std::sort(std::begin(operables), std::end(operables),
+              [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+    for (champsim::operable& op : operables) {
+      dynamic_progress += op.operate_on(dynamic_clock);
+    }
+  }
+
+  REQUIRE(static_progress == dynamic_progress);
+  REQUIRE_THAT(static_log, Catch::Matchers::RangeEquals(dynamic_log));
+}
+
+TEST_CASE("Statically ordered operables operate in the same order as sorted operables when the sort is not stable")
+{
+  constexpr std::size_t num_operables = 24;
+  std::vector<int> static_log{};
+  std::vector<int> dynamic_log{};
+
+  std::vector<recording_operable> static_operables{};
+  std::vector<recording_operable> dynamic_operables{};
+  for (std::size_t i = 0; i < num_operables; ++i) {
+    champsim::chrono::picoseconds period{200 + 50 * static_cast<long>(i % 4)};
+    static_operables.emplace_back(period, &static_log, static_cast<int>(i));
+    dynamic_operables.emplace_back(period, &dynamic_log, static_cast<int>(i));
+  }
+  champsim::operable_tuple components{champsim::tie_front<num_operables>(static_operables)};
+
+  champsim::chrono::clock static_clock{};
+  champsim::chrono::clock dynamic_clock{};
+  for (int i = 0; i < 1000; ++i) {
+    static_clock.tick(champsim::chrono::picoseconds{200});
+    components.operate_on(static_clock);
+
+    dynamic_clock.tick(champsim::chrono::picoseconds{200});
+    std::vector<std::reference_wrapper<champsim::operable>> operables{std::begin(dynamic_operables), std::end(dynamic_operables)};
+    std::sort(std::begin(operables), std::end(operables),
+              [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+    for (champsim::operable& op : operables) {
+      op.operate_on(dynamic_clock);
+    }
+  }
+
+  REQUIRE_THAT(static_log, Catch::Matchers::RangeEquals(dynamic_log));
+}
+
+TEST_CASE("A statically dispatched operable catches up to the clock")
+{
+  std::vector<int> log{};
+  recording_operable uut{champsim::chrono::picoseconds{100}, &log, 0};
+
+  champsim::chrono::clock global_clock{};
+  global_clock.tick(champsim::chrono::picoseconds{450});
+
+  REQUIRE(champsim::operate_on(uut, global_clock) == 5);
+  REQUIRE(std::size(log) == 5);
+  REQUIRE(uut.current_time == champsim::chrono::clock::time_point{} + champsim::chrono::picoseconds{500});
+}
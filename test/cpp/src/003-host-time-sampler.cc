@@ -0,0 +1,167 @@
+#include <catch.hpp>
+#include <chrono>
+#include <vector>
+
+#include "host_profile.h"
+#include "stats_printer.h"
+
+TEST_CASE("The host time sampler times one call in every period")
+{
+  champsim::host_time_sampler uut{};
+  for (uint64_t i = 0; i < 10 * champsim::host_time_sampler::period + 1; ++i) {
+    REQUIRE(uut.measure([i] { return i; }) == i);
+  }
+
+  REQUIRE(uut.calls == 10 * champsim::host_time_sampler::period + 1);
+  REQUIRE(uut.samples == 10);
+}
+
+TEST_CASE("The host time sampler scales its samples to the number of calls")
+{
+  champsim::host_time_sampler uut{};
+  uut.calls = 640;
+  uut.samples = 10;
+  uut.sampled = std::chrono::milliseconds{5};
+
+  REQUIRE(uut.estimate().count() == Approx(0.32));
+}
+
+TEST_CASE("An unsampled host time sampler estimates zero")
+{
+  champsim::host_time_sampler uut{};
+  uut.measure([] { return 0; });
+  REQUIRE(uut.estimate().count() == 0);
+}
+
+TEST_CASE("Samplers in lockstep can be subtracted to find the time outside the inner call")
+{
+  champsim::host_time_sampler outer{};
+  champsim::host_time_sampler inner{};
+  for (uint64_t i = 0; i < champsim::host_time_sampler::period; ++i) {
+    outer.measure([&inner] { return inner.measure([] { return 0; }); });
+  }
+
+  REQUIRE(outer.samples == 1);
+  REQUIRE(inner.samples == 1);
+  REQUIRE(outer.sampled >= inner.sampled);
+}
+
+TEST_CASE("The host profile reports simulation speed")
+{
+  champsim::host_profile_stats given{};
+  given.elapsed = std::chrono::duration<double>{2};
+  given.instructions = 100000;
+  given.components.push_back({"cpu0", std::chrono::duration<double>{0.5}, {}});
+
+  REQUIRE(given.kips() == Approx(50));
+
+  std::vector<std::string> expected{"Simulation speed: 50 KIPS elapsed: 2 s", "cpu0 host time: 0.5 s (25%)"};
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("The host profile prints counters if they are available")
+{
+  champsim::host_profile_stats given{};
+  given.elapsed = std::chrono::duration<double>{2};
+  given.counters_available = true;
+  given.components.push_back({"cpu0", std::chrono::duration<double>{0.5}, {2000, 3000, 10, 20}});
+
+  std::vector<std::string> expected{"Simulation speed: 0 KIPS elapsed: 2 s", "cpu0 host time: 0.5 s (25%)",
+                                    "cpu0 host cycles: 2000 instructions: 3000 IPC: 1.5 LLC misses: 10 branch misses: 20"};
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("A closed perf counter group reads zero")
+{
+  champsim::perf_counter_group uut{};
+  REQUIRE_FALSE(uut.is_open());
+
+  auto counts = uut.read();
+  REQUIRE(counts.cycles == 0);
+  REQUIRE(counts.instructions == 0);
+  REQUIRE(counts.llc_misses == 0);
+  REQUIRE(counts.branch_misses == 0);
+}
+
+TEST_CASE("A perf counter group either counts or explains why it cannot")
+{
+  champsim::perf_counter_group uut{};
+  auto reason = uut.open();
+  if (reason.empty()) {
+    REQUIRE(uut.is_open());
+    auto before = uut.read();
+    volatile uint64_t sink = 0;
+    for (uint64_t i = 0; i < 100000; ++i) {
+      sink = sink + i;
+    }
+    auto after = uut.read();
+    REQUIRE(after.instructions > before.instructions);
+  } else {
+    REQUIRE_FALSE(uut.is_open());
+    REQUIRE(uut.read().instructions == 0);
+  }
+
+  uut.close();
+  REQUIRE_FALSE(uut.is_open());
+}
+
+TEST_CASE("The host time sampler scales its counted events")
+{
+  champsim::host_time_sampler uut{};
+  uut.calls = 640;
+  uut.samples = 10;
+  uut.counted = {100, 200, 3, 4};
+
+  auto counts = uut.estimate_counts();
+  REQUIRE(counts.cycles == 6400);
+  REQUIRE(counts.instructions == 12800);
+  REQUIRE(counts.llc_misses == 192);
+  REQUIRE(counts.branch_misses == 256);
+}
+
+TEST_CASE("The exclusive host profile subtracts the scaled estimates of the inner samplers")
+{
+  champsim::host_time_sampler outer{};
+  outer.calls = 640;
+  outer.samples = 10;
+  outer.sampled = std::chrono::milliseconds{5};
+  outer.counted = {100, 200, 3, 4};
+
+  std::vector<champsim::host_time_sampler> inner(1);
+  inner.front().calls = 64;
+  inner.front().samples = 1;
+  inner.front().sampled = std::chrono::milliseconds{1};
+  inner.front().counted = {10, 20, 1, 1};
+
+  auto own = champsim::exclusive_host_profile("DRAM", outer, std::cbegin(inner), std::cend(inner));
+  REQUIRE(own.name == "DRAM");
+  REQUIRE(own.time.count() == Approx(0.256));
+  REQUIRE(own.counters.cycles == 5760);
+  REQUIRE(own.counters.instructions == 11520);
+  REQUIRE(own.counters.llc_misses == 128);
+  REQUIRE(own.counters.branch_misses == 192);
+}
+
+TEST_CASE("The exclusive host profile is clamped at zero when the inner estimates exceed the outer one")
+{
+  champsim::host_time_sampler outer{};
+  outer.calls = 64;
+  outer.samples = 1;
+  outer.sampled = std::chrono::microseconds{1};
+  outer.counted = {10, 10, 0, 0};
+
+  std::vector<champsim::host_time_sampler> inner(2);
+  for (auto& sampler : inner) {
+    sampler.calls = 64;
+    sampler.samples = 1;
+    sampler.sampled = std::chrono::microseconds{3};
+    sampler.counted = {30, 5, 1, 1};
+  }
+
+  auto own = champsim::exclusive_host_profile("DRAM", outer, std::cbegin(inner), std::cend(inner));
+  REQUIRE(own.time.count() == 0);
+  REQUIRE(own.counters.cycles == 0);
+  REQUIRE(own.counters.instructions == 0);
+  REQUIRE(own.counters.llc_misses == 0);
+  REQUIRE(own.counters.branch_misses == 0);
+}
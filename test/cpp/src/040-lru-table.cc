@@ -1,5 +1,7 @@
 #include <catch.hpp>
+#include <random>
 #include <type_traits>
+#include <vector>
 
 #include "address.h"
 #include "champsim.h"
@@ -290,3 +292,33 @@ TEMPLATE_TEST_CASE("A lru_table returns the evicted block on invalidation", "",
     }
   }
 }
+
+TEST_CASE("lru_table benchmark", "[.][bench]")
+{
+  // A table the size of a typical PSCL or BTB, probed with a mix of resident and non-resident keys
+  champsim::lru_table<::type_with_getters> uut{256, 8};
+  std::mt19937 rng{40};
+  std::vector<::type_with_getters> keys(1024);
+  for (auto& key : keys) {
+    key.value = static_cast<unsigned int>(rng() % 4096);
+  }
+  for (const auto& key : keys) {
+    uut.fill(key);
+  }
+
+  BENCHMARK("lru_table::check_hit() (1024 lookups)")
+  {
+    unsigned int result = 0;
+    for (const auto& key : keys) {
+      result += uut.check_hit(key).has_value() ? 1u : 0u;
+    }
+    return result;
+  };
+
+  BENCHMARK("lru_table::fill() (1024 fills)")
+  {
+    for (const auto& key : keys) {
+      uut.fill(key);
+    }
+  };
+}
@@ -1,6 +1,12 @@
 #include <catch.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
 
+#include "access_type.h"
 #include "event_counter.h"
+#include "instruction.h"
+#include "util/to_underlying.h"
 
 TEST_CASE("An event counter can allocate")
 {
@@ -69,3 +75,89 @@ TEST_CASE("Two event counters can be subtracted")
   rhs.set(key, rhs_value);
   REQUIRE((lhs - rhs).at(key) == lhs_value - rhs_value);
 }
+
+TEST_CASE("A dense event counter can increment")
+{
+  champsim::stats::dense_event_counter<std::pair<access_type, std::size_t>, champsim::to_underlying(access_type::NUM_TYPES)> uut{};
+  constexpr std::pair key{access_type::WRITE, std::size_t{3}};
+  uut.increment(key);
+  REQUIRE(uut.at(key) == 1);
+  uut.increment(key);
+  REQUIRE(uut.at(key) == 2);
+  REQUIRE(uut.total() == 2);
+}
+
+TEST_CASE("A dense event counter gives a substitute value for an index it has not counted")
+{
+  champsim::stats::dense_event_counter<std::pair<access_type, std::size_t>, champsim::to_underlying(access_type::NUM_TYPES)> uut{};
+  uut.increment({access_type::LOAD, 2});
+  REQUIRE(uut.value_or({access_type::LOAD, 1}, 3) == 3);
+  REQUIRE(uut.value_or({access_type::LOAD, 5}, 3) == 3);
+  REQUIRE(uut.value_or({access_type::RFO, 2}, 3) == 0);
+}
+
+TEST_CASE("A dense event counter lists every key of the indices it has counted")
+{
+  champsim::stats::dense_event_counter<std::pair<access_type, std::size_t>, champsim::to_underlying(access_type::NUM_TYPES)> uut{};
+  uut.increment({access_type::PREFETCH, 2});
+  auto keys = uut.get_keys();
+  REQUIRE(std::size(keys) == champsim::to_underlying(access_type::NUM_TYPES));
+  REQUIRE(std::all_of(std::begin(keys), std::end(keys), [](auto key) { return key.second == 2; }));
+  REQUIRE(std::is_sorted(std::begin(keys), std::end(keys)));
+}
+
+TEST_CASE("A dense event counter can be keyed by an unscoped enumeration")
+{
+  champsim::stats::dense_event_counter<branch_type, champsim::to_underlying(NOT_BRANCH) + 1> uut{};
+  uut.increment(BRANCH_RETURN);
+  uut.set(NOT_BRANCH, 5);
+  REQUIRE(uut.value_or(BRANCH_RETURN, 0) == 1);
+  REQUIRE(uut.value_or(NOT_BRANCH, 0) == 5);
+  REQUIRE(uut.total() == 6);
+}
+
+TEST_CASE("Two dense event counters can be added and subtracted")
+{
+  champsim::stats::dense_event_counter<std::pair<access_type, std::size_t>, champsim::to_underlying(access_type::NUM_TYPES)> lhs{};
+  champsim::stats::dense_event_counter<std::pair<access_type, std::size_t>, champsim::to_underlying(access_type::NUM_TYPES)> rhs{};
+  constexpr std::pair key{access_type::LOAD, std::size_t{1}};
+  lhs.set(key, 100);
+  rhs.set(key, 20);
+  REQUIRE((lhs + rhs).at(key) == 120);
+  REQUIRE((lhs - rhs).at(key) == 80);
+}
+
+TEST_CASE("event_counter benchmark", "[.][bench]")
+{
+  // The key type of the cache hit and miss counters, with one key per access type on each of eight cores
+  champsim::stats::event_counter<std::pair<access_type, std::size_t>> uut{};
+  std::mt19937 rng{70};
+  std::vector<std::pair<access_type, std::size_t>> keys(1024);
+  for (auto& key : keys) {
+    key = {static_cast<access_type>(rng() % champsim::to_underlying(access_type::NUM_TYPES)), rng() % 8};
+  }
+
+  BENCHMARK("event_counter::increment() (1024 increments)")
+  {
+    for (const auto& key : keys) {
+      uut.increment(key);
+    }
+  };
+}
+
+TEST_CASE("dense_event_counter benchmark", "[.][bench]")
+{
+  champsim::stats::dense_event_counter<std::pair<access_type, std::size_t>, champsim::to_underlying(access_type::NUM_TYPES)> uut{};
+  std::mt19937 rng{70};
+  std::vector<std::pair<access_type, std::size_t>> keys(1024);
+  for (auto& key : keys) {
+    key = {static_cast<access_type>(rng() % champsim::to_underlying(access_type::NUM_TYPES)), rng() % 8};
+  }
+
+  BENCHMARK("dense_event_counter::increment() (1024 increments)")
+  {
+    for (const auto& key : keys) {
+      uut.increment(key);
+    }
+  };
+}
@@ -0,0 +1,88 @@
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "interval_stats.h"
+
+namespace
+{
+champsim::interval_stats snapshot(std::string phase, uint64_t index, long long instrs, long load_hits)
+{
+  champsim::interval_stats result{std::move(phase), false, index, {}, {}, {}};
+
+  auto& cpu = result.cpus.emplace_back();
+  cpu.begin_instrs = 1000;
+  cpu.end_instrs = 1000 + instrs;
+  cpu.begin_cycles = 2000;
+  cpu.end_cycles = 2000 + 2 * instrs;
+
+  auto& cache = result.caches.emplace_back();
+  cache.name = "test_cache";
+  cache.hits.set({access_type::LOAD, 0}, load_hits);
+
+  auto& chan = result.dram_channels.emplace_back();
+  chan.RQ_ROW_BUFFER_HIT = static_cast<unsigned>(load_hits);
+
+  return result;
+}
+
+std::vector<nlohmann::json> write(const std::vector<champsim::interval_stats>& snapshots)
+{
+  std::stringstream stream;
+  {
+    champsim::interval_writer uut{stream};
+    for (const auto& x : snapshots) {
+      uut.push(x);
+    }
+  }
+
+  std::vector<nlohmann::json> lines;
+  for (std::string line; std::getline(stream, line);) {
+    lines.push_back(nlohmann::json::parse(line));
+  }
+  return lines;
+}
+} // namespace
+
+TEST_CASE("The difference of two interval snapshots holds the events between them")
+{
+  auto diff = snapshot("Simulation", 1, 300, 50) - snapshot("Simulation", 0, 100, 20);
+
+  REQUIRE(diff.cpus.at(0).instrs() == 200);
+  REQUIRE(diff.cpus.at(0).cycles() == 400);
+  REQUIRE(diff.caches.at(0).name == "test_cache");
+  REQUIRE(diff.caches.at(0).hits.value_or({access_type::LOAD, 0}, 0) == 30);
+  REQUIRE(diff.dram_channels.at(0).RQ_ROW_BUFFER_HIT == 30);
+}
+
+TEST_CASE("An interval writer writes one line for each snapshot")
+{
+  auto lines = write({snapshot("Simulation", 0, 100, 20), snapshot("Simulation", 1, 300, 50), snapshot("Simulation", 2, 350, 55)});
+
+  REQUIRE(std::size(lines) == 3);
+  for (std::size_t i = 0; i < std::size(lines); ++i) {
+    REQUIRE(lines.at(i).at("name") == "Simulation");
+    REQUIRE(lines.at(i).at("interval") == i);
+  }
+}
+
+TEST_CASE("An interval writer writes the difference from the previous snapshot")
+{
+  auto lines = write({snapshot("Simulation", 0, 100, 20), snapshot("Simulation", 1, 300, 50)});
+
+  REQUIRE(lines.at(0).at("sim").at("cores").at(0).at("instructions") == 100);
+  REQUIRE(lines.at(1).at("sim").at("cores").at(0).at("instructions") == 200);
+  REQUIRE(lines.at(1).at("sim").at("cores").at(0).at("cycles") == 400);
+  REQUIRE(lines.at(1).at("sim").at("test_cache").at("LOAD").at("hit").at(0) == 30);
+}
+
+TEST_CASE("An interval writer restarts its differences at each phase")
+{
+  auto lines = write({snapshot("Warmup", 0, 100, 20), snapshot("Simulation", 0, 150, 25)});
+
+  REQUIRE(lines.at(1).at("name") == "Simulation");
+  REQUIRE(lines.at(1).at("sim").at("cores").at(0).at("instructions") == 150);
+  REQUIRE(lines.at(1).at("sim").at("test_cache").at("LOAD").at("hit").at(0) == 25);
+}
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <catch.hpp>
+#include <random>
+#include <vector>
+
+#include "ip_attribution.h"
+
+TEST_CASE("A disabled IP attribution table records nothing")
+{
+  champsim::stats::ip_attribution uut{};
+  uut.record_miss(champsim::address{0x400000});
+  uut.record_useless_prefetch(champsim::address{0x400000});
+
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE(uut.top().empty());
+}
+
+TEST_CASE("An IP attribution table counts each kind of event for an address")
+{
+  champsim::stats::ip_attribution uut{4};
+  const champsim::address ip{0x400000};
+  uut.record_miss(ip);
+  uut.record_miss(ip);
+  uut.record_late_prefetch(ip);
+  uut.record_useless_prefetch(ip);
+  uut.record_miss_latency(ip, 10);
+  uut.record_miss_latency(ip, 30);
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 1);
+  REQUIRE(top.front().ip == ip);
+  REQUIRE(top.front().events == 4);
+  REQUIRE(top.front().error == 0);
+  REQUIRE(top.front().misses == 2);
+  REQUIRE(top.front().late_prefetches == 1);
+  REQUIRE(top.front().useless_prefetches == 1);
+  REQUIRE(top.front().average_miss_latency() == 20);
+}
+
+TEST_CASE("An IP attribution table counts untriggered useless prefetches apart from any address")
+{
+  champsim::stats::ip_attribution uut{4};
+  uut.record_untriggered_useless_prefetch();
+  uut.record_untriggered_useless_prefetch();
+
+  REQUIRE(uut.top().empty());
+  REQUIRE(uut.untriggered_useless_prefetches() == 2);
+
+  auto after = uut;
+  after.record_untriggered_useless_prefetch();
+  REQUIRE((after - uut).untriggered_useless_prefetches() == 1);
+}
+
+TEST_CASE("An IP attribution table reports no miss latency for an address with only prefetch events")
+{
+  champsim::stats::ip_attribution uut{4};
+  const champsim::address ip{0x400000};
+  uut.record_late_prefetch(ip);
+  uut.record_useless_prefetch(ip);
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 1);
+  REQUIRE(top.front().miss_latency_samples == 0);
+  REQUIRE(top.front().average_miss_latency() == 0);
+}
+
+TEST_CASE("An IP attribution table counts untriggered late prefetches apart from any address")
+{
+  champsim::stats::ip_attribution uut{4};
+  uut.record_untriggered_late_prefetch();
+
+  REQUIRE(uut.top().empty());
+  REQUIRE(uut.untriggered_late_prefetches() == 1);
+
+  auto after = uut;
+  after.record_untriggered_late_prefetch();
+  REQUIRE((after - uut).untriggered_late_prefetches() == 1);
+}
+
+TEST_CASE("An IP attribution table does not record latencies for untracked addresses")
+{
+  champsim::stats::ip_attribution uut{4};
+  uut.record_miss_latency(champsim::address{0x400000}, 10);
+
+  REQUIRE(uut.top().empty());
+}
+
+TEST_CASE("An IP attribution table lists the addresses with the most events first")
+{
+  champsim::stats::ip_attribution uut{4};
+  for (uint64_t ip = 1; ip <= 4; ++ip) {
+    for (uint64_t i = 0; i < ip; ++i) {
+      uut.record_miss(champsim::address{ip});
+    }
+  }
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 4);
+  for (std::size_t i = 0; i < std::size(top); ++i) {
+    REQUIRE(top.at(i).ip == champsim::address{4 - i});
+  }
+}
+
+TEST_CASE("A full IP attribution table replaces the address with the fewest events")
+{
+  champsim::stats::ip_attribution uut{2};
+  for (int i = 0; i < 5; ++i) {
+    uut.record_miss(champsim::address{0x10});
+  }
+  uut.record_miss(champsim::address{0x20});
+  uut.record_miss(champsim::address{0x30});
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 2);
+  REQUIRE(top.at(0).ip == champsim::address{0x10});
+  REQUIRE(top.at(0).events == 5);
+  REQUIRE(top.at(1).ip == champsim::address{0x30});
+  REQUIRE(top.at(1).events == 2);
+  REQUIRE(top.at(1).error == 1);
+  REQUIRE(top.at(1).misses == 1);
+}
+
+TEST_CASE("An IP attribution table keeps the heavy hitters of a skewed stream")
+{
+  champsim::stats::ip_attribution uut{8};
+  for (uint64_t i = 0; i < 10000; ++i) {
+    uut.record_miss(champsim::address{(i % 4 == 0) ? 0x1000 : (0x2000 + i)}); // one address in four, and a long tail of addresses seen once
+  }
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 8);
+  REQUIRE(top.front().ip == champsim::address{0x1000});
+  REQUIRE(top.front().misses == 2500);
+}
+
+TEST_CASE("A full IP attribution table replaces the same address as a scan for the fewest events")
+{
+  struct reference_entry {
+    uint64_t ip;
+    long events;
+    long error;
+  };
+  constexpr std::size_t capacity = 16;
+  std::vector<reference_entry> reference{};
+
+  champsim::stats::ip_attribution uut{capacity};
+  std::mt19937_64 rng{};
+  std::geometric_distribution<uint64_t> dist{0.05};
+  for (int i = 0; i < 20000; ++i) {
+    const auto ip = dist(rng);
+    uut.record_miss(champsim::address{ip});
+
+    auto found = std::find_if(std::begin(reference), std::end(reference), [ip](const auto& x) { return x.ip == ip; });
+    if (found == std::end(reference) && std::size(reference) < capacity) {
+      found = reference.insert(std::end(reference), {ip, 0, 0});
+    } else if (found == std::end(reference)) {
+      found = std::min_element(std::begin(reference), std::end(reference), [](const auto& x, const auto& y) { return x.events < y.events; });
+      *found = {ip, found->events, found->events};
+    }
+    ++found->events;
+  }
+
+  std::sort(std::begin(reference), std::end(reference), [](const auto& x, const auto& y) { return x.events > y.events || (x.events == y.events && x.ip < y.ip); });
+  auto top = uut.top();
+  REQUIRE(std::size(top) == std::size(reference));
+  for (std::size_t i = 0; i < std::size(top); ++i) {
+    CHECK(top.at(i).ip == champsim::address{reference.at(i).ip});
+    CHECK(top.at(i).events == reference.at(i).events);
+    CHECK(top.at(i).error == reference.at(i).error);
+  }
+}
+
+TEST_CASE("The difference of two IP attribution tables holds the events between them")
+{
+  champsim::stats::ip_attribution before{4};
+  before.record_miss(champsim::address{0x10});
+
+  auto after = before;
+  after.record_miss(champsim::address{0x10});
+  after.record_miss(champsim::address{0x10});
+  after.record_useless_prefetch(champsim::address{0x20});
+
+  auto top = (after - before).top();
+  REQUIRE(std::size(top) == 2);
+  REQUIRE(top.at(0).ip == champsim::address{0x10});
+  REQUIRE(top.at(0).misses == 2);
+  REQUIRE(top.at(1).ip == champsim::address{0x20});
+  REQUIRE(top.at(1).useless_prefetches == 1);
+}
@@ -0,0 +1,104 @@
+#include <catch.hpp>
+#include <utility>
+#include <vector>
+
+#include "latency_histogram.h"
+
+TEST_CASE("Small latencies have buckets of their own")
+{
+  for (uint64_t value = 0; value < (1u << champsim::stats::latency_histogram::precision_bits); ++value) {
+    auto index = champsim::stats::latency_histogram::bucket_index(value);
+    REQUIRE(champsim::stats::latency_histogram::bucket_lower_bound(index) == value);
+    REQUIRE(champsim::stats::latency_histogram::bucket_upper_bound(index) == value);
+  }
+}
+
+TEST_CASE("Latency histogram buckets cover every value in order")
+{
+  uint64_t expected_lower = 0;
+  for (std::size_t index = 0; index < 200; ++index) {
+    auto lower = champsim::stats::latency_histogram::bucket_lower_bound(index);
+    auto upper = champsim::stats::latency_histogram::bucket_upper_bound(index);
+    REQUIRE(lower == expected_lower);
+    REQUIRE(champsim::stats::latency_histogram::bucket_index(lower) == index);
+    REQUIRE(champsim::stats::latency_histogram::bucket_index(upper) == index);
+    expected_lower = upper + 1;
+  }
+}
+
+TEST_CASE("Latency histogram buckets are within the precision of their values")
+{
+  for (uint64_t value : {9ull, 100ull, 1000ull, 123456ull, 1ull << 40}) {
+    auto index = champsim::stats::latency_histogram::bucket_index(value);
+    auto width = champsim::stats::latency_histogram::bucket_upper_bound(index) - champsim::stats::latency_histogram::bucket_lower_bound(index) + 1;
+    REQUIRE(width * (1u << champsim::stats::latency_histogram::precision_bits) <= value);
+  }
+}
+
+TEST_CASE("A latency histogram reports its count and mean")
+{
+  champsim::stats::latency_histogram uut;
+  uut.record(10);
+  uut.record(20);
+  uut.record(-5);
+
+  REQUIRE(uut.count() == 3);
+  REQUIRE(uut.sum() == 30);
+  REQUIRE(uut.mean() == 10);
+}
+
+TEST_CASE("A latency histogram reports percentiles")
+{
+  champsim::stats::latency_histogram uut;
+  for (long i = 0; i < 99; ++i) {
+    uut.record(5);
+  }
+  uut.record(1000);
+
+  REQUIRE(uut.percentile(50) == 5);
+  REQUIRE(uut.percentile(99) == 5);
+  REQUIRE(uut.percentile(99.9) >= 1000);
+  REQUIRE(uut.percentile(99.9) < 1000 + 1000 / 8);
+  REQUIRE(uut.max() == uut.percentile(99.9));
+}
+
+TEST_CASE("An empty latency histogram reports zero percentiles")
+{
+  champsim::stats::latency_histogram uut;
+  REQUIRE(uut.percentile(50) == 0);
+  REQUIRE(uut.max() == 0);
+}
+
+TEST_CASE("Latency histograms can be merged and subtracted")
+{
+  champsim::stats::latency_histogram lhs;
+  lhs.record(5);
+  lhs.record(300);
+
+  champsim::stats::latency_histogram rhs;
+  rhs.record(5);
+  rhs.record(70000);
+
+  auto sum = lhs + rhs;
+  REQUIRE(sum.count() == 4);
+  REQUIRE(sum.value_or(champsim::stats::latency_histogram::bucket_index(5), 0) == 2);
+  REQUIRE(sum.max() >= 70000);
+
+  auto difference = sum - rhs;
+  REQUIRE(difference.count() == 2);
+  REQUIRE(difference.sum() == 305);
+  REQUIRE(difference.value_or(champsim::stats::latency_histogram::bucket_index(5), 0) == 1);
+  REQUIRE(difference.value_or(champsim::stats::latency_histogram::bucket_index(70000), 0) == 0);
+  REQUIRE(difference.max() == champsim::stats::latency_histogram::bucket_upper_bound(champsim::stats::latency_histogram::bucket_index(300)));
+}
+
+TEST_CASE("A latency histogram can be read in power-of-two buckets")
+{
+  champsim::stats::latency_histogram uut;
+  for (long latency : {0, 1, 3, 64, 70, 127, 128, 100000}) {
+    uut.record(latency);
+  }
+
+  std::vector<std::pair<uint64_t, long>> expected{{0, 1}, {1, 1}, {2, 1}, {64, 3}, {128, 1}, {65536, 1}};
+  REQUIRE(uut.power_of_two_buckets() == expected);
+}
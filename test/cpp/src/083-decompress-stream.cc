@@ -1,4 +1,5 @@
 #include <catch.hpp>
+#include <sstream>
 
 #include "inf_stream.h"
 
@@ -108,3 +109,24 @@ TEST_CASE("An inf_stream can inflate a bz2-compressed text")
   comp_stream.read(inflated, static_cast<std::streamsize>(std::size(plaintext)));
   REQUIRE_THAT(std::string{inflated}, Catch::Matchers::Equals(plaintext));
 }
+
+TEMPLATE_TEST_CASE("A def_ostream produces text that an inf_stream can inflate", "", champsim::decomp_tags::gzip_tag_t<>, champsim::decomp_tags::lzma_tag_t<>,
+                   champsim::decomp_tags::bzip2_tag_t)
+{
+  champsim::def_ostream<TestType, std::ostringstream> def_stream{std::ostringstream{}};
+
+  STATIC_REQUIRE(std::is_move_constructible<decltype(def_stream)>::value);
+  STATIC_REQUIRE(std::is_move_assignable<decltype(def_stream)>::value);
+
+  // Write in two pieces, so that the stream must continue after the first
+  auto split = static_cast<std::streamsize>(std::size(plaintext) / 2);
+  def_stream.write(std::data(plaintext), split);
+  def_stream.write(std::data(plaintext) + split, static_cast<std::streamsize>(std::size(plaintext)) - split);
+  def_stream.close();
+  REQUIRE_FALSE(def_stream.fail());
+
+  champsim::inf_istream<TestType, std::istringstream> comp_stream{std::istringstream{def_stream.underlying->str()}};
+  char inflated[1000] = {};
+  comp_stream.read(inflated, static_cast<std::streamsize>(std::size(plaintext)));
+  REQUIRE_THAT(std::string{inflated}, Catch::Matchers::Equals(plaintext));
+}
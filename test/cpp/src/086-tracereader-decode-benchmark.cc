@@ -0,0 +1,138 @@
+#include <catch.hpp>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <bzlib.h>
+#include <lzma.h>
+#include <zlib.h>
+
+#include "inf_stream.h"
+#include "tracereader.h"
+
+namespace
+{
+constexpr std::size_t trace_length = 4096;
+
+// A trace with a mix of ALU, branch, and memory instructions
+std::string synthetic_trace()
+{
+  std::mt19937_64 rng{86};
+  std::vector<input_instr> instrs(trace_length);
+  uint64_t ip = 0x400000;
+  for (auto& instr : instrs) {
+    instr = input_instr{};
+    instr.ip = ip;
+    instr.destination_registers[0] = static_cast<unsigned char>(1 + rng() % 32);
+    instr.source_registers[0] = static_cast<unsigned char>(1 + rng() % 32);
+    if (rng() % 4 == 0) {
+      instr.source_memory[0] = 0x10000000 + (rng() % 65536) * 8;
+    }
+    if (rng() % 8 == 0) {
+      instr.is_branch = true;
+      instr.branch_taken = (rng() % 2 == 0);
+    }
+    ip += 4;
+  }
+
+  std::string result(std::size(instrs) * sizeof(input_instr), '\0');
+  std::memcpy(std::data(result), std::data(instrs), std::size(result));
+  return result;
+}
+
+std::string gzip_compress(const std::string& plain)
+{
+  z_stream strm{};
+  deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  std::string result(deflateBound(&strm, static_cast<uLong>(std::size(plain))), '\0');
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(std::data(plain)));
+  strm.avail_in = static_cast<uInt>(std::size(plain));
+  strm.next_out = reinterpret_cast<Bytef*>(std::data(result));
+  strm.avail_out = static_cast<uInt>(std::size(result));
+  deflate(&strm, Z_FINISH);
+  result.resize(strm.total_out);
+  deflateEnd(&strm);
+  return result;
+}
+
+std::string xz_compress(const std::string& plain)
+{
+  std::string result(lzma_stream_buffer_bound(std::size(plain)), '\0');
+  std::size_t out_pos = 0;
+  lzma_easy_buffer_encode(LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64, nullptr, reinterpret_cast<const uint8_t*>(std::data(plain)), std::size(plain),
+                          reinterpret_cast<uint8_t*>(std::data(result)), &out_pos, std::size(result));
+  result.resize(out_pos);
+  return result;
+}
+
+std::string bzip2_compress(const std::string& plain)
+{
+  std::string result(std::size(plain) + std::size(plain) / 100 + 600, '\0');
+  auto out_size = static_cast<unsigned>(std::size(result));
+  BZ2_bzBuffToBuffCompress(std::data(result), &out_size, const_cast<char*>(std::data(plain)), static_cast<unsigned>(std::size(plain)), 9, 0, 0);
+  result.resize(out_size);
+  return result;
+}
+
+// Each run decodes the whole trace with a freshly constructed reader, so that every run sees the same input
+template <typename Stream, typename MakeStream>
+void decode_benchmark(std::string name, MakeStream make_stream)
+{
+  BENCHMARK_ADVANCED(std::move(name))(Catch::Benchmark::Chronometer meter)
+  {
+    std::deque<champsim::bulk_tracereader<input_instr, Stream>> readers;
+    for (int i = 0; i < meter.runs(); ++i) {
+      readers.emplace_back(uint8_t{0}, make_stream());
+    }
+
+    meter.measure([&](int i) {
+      auto& reader = readers.at(static_cast<std::size_t>(i));
+      uint64_t result = 0;
+      for (std::size_t j = 0; j < trace_length; ++j) {
+        result ^= reader().ip.template to<uint64_t>();
+      }
+      return result;
+    });
+  };
+}
+} // namespace
+
+TEST_CASE("bulk_tracereader decode benchmark", "[.][bench]")
+{
+  const auto plain = synthetic_trace();
+  const auto gzip = gzip_compress(plain);
+  const auto xz = xz_compress(plain);
+  const auto bzip2 = bzip2_compress(plain);
+
+  decode_benchmark<std::istringstream>("bulk_tracereader decode uncompressed (4096 instructions)", [&] { return std::istringstream{plain}; });
+
+  using gzip_stream = champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>, std::istringstream>;
+  decode_benchmark<gzip_stream>("bulk_tracereader decode gzip (4096 instructions)", [&] { return gzip_stream{std::istringstream{gzip}}; });
+
+  using xz_stream = champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>, std::istringstream>;
+  decode_benchmark<xz_stream>("bulk_tracereader decode xz (4096 instructions)", [&] { return xz_stream{std::istringstream{xz}}; });
+
+  using bzip2_stream = champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t, std::istringstream>;
+  decode_benchmark<bzip2_stream>("bulk_tracereader decode bzip2 (4096 instructions)", [&] { return bzip2_stream{std::istringstream{bzip2}}; });
+}
+
+TEST_CASE("The decode benchmark traces round-trip through each compression")
+{
+  const auto plain = synthetic_trace();
+
+  using gzip_stream = champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>, std::istringstream>;
+  using xz_stream = champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>, std::istringstream>;
+  using bzip2_stream = champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t, std::istringstream>;
+
+  champsim::bulk_tracereader<input_instr, std::istringstream> expected{0, std::istringstream{plain}};
+  champsim::bulk_tracereader<input_instr, gzip_stream> gzip_reader{0, gzip_stream{std::istringstream{gzip_compress(plain)}}};
+  champsim::bulk_tracereader<input_instr, xz_stream> xz_reader{0, xz_stream{std::istringstream{xz_compress(plain)}}};
+  champsim::bulk_tracereader<input_instr, bzip2_stream> bzip2_reader{0, bzip2_stream{std::istringstream{bzip2_compress(plain)}}};
+
+  for (std::size_t i = 0; i < trace_length; ++i) {
+    auto ip = expected().ip;
+    REQUIRE(gzip_reader().ip == ip);
+    REQUIRE(xz_reader().ip == ip);
+    REQUIRE(bzip2_reader().ip == ip);
+  }
+}
@@ -0,0 +1,152 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#include "trace_generator.h"
+
+namespace
+{
+bool is_memory_free(const input_instr& instr)
+{
+  return std::all_of(std::begin(instr.source_memory), std::end(instr.source_memory), [](auto x) { return x == 0; })
+         && std::all_of(std::begin(instr.destination_memory), std::end(instr.destination_memory), [](auto x) { return x == 0; });
+}
+} // namespace
+
+TEST_CASE("A trace generator is reproducible from its seed")
+{
+  champsim::trace_generator_spec spec;
+  spec.seed = 87;
+  champsim::trace_generator first{spec};
+  champsim::trace_generator second{spec};
+
+  for (int i = 0; i < 10000; ++i) {
+    auto lhs = first();
+    auto rhs = second();
+    REQUIRE(lhs.ip == rhs.ip);
+    REQUIRE(lhs.branch_taken == rhs.branch_taken);
+    REQUIRE(lhs.source_memory[0] == rhs.source_memory[0]);
+    REQUIRE(lhs.destination_memory[0] == rhs.destination_memory[0]);
+  }
+}
+
+TEST_CASE("A trace generator follows its own branches")
+{
+  champsim::trace_generator_spec spec;
+  spec.branch_fraction = 0.3;
+  spec.branch_predictability = 0.7;
+  champsim::trace_generator uut{spec};
+
+  auto prev = uut();
+  for (int i = 0; i < 10000; ++i) {
+    auto next = uut();
+    if (!prev.branch_taken) {
+      auto wraps = (prev.ip + 4 == spec.code_base + spec.code_footprint);
+      REQUIRE(next.ip == (wraps ? spec.code_base : prev.ip + 4));
+    }
+    REQUIRE(next.ip >= spec.code_base);
+    REQUIRE(next.ip < spec.code_base + spec.code_footprint);
+    prev = next;
+  }
+}
+
+TEST_CASE("A trace generator gives each IP a fixed kind")
+{
+  champsim::trace_generator_spec spec;
+  champsim::trace_generator uut{spec};
+
+  std::map<unsigned long long, std::pair<bool, bool>> kinds; // is_branch, accesses memory
+  for (int i = 0; i < 100000; ++i) {
+    auto instr = uut();
+    auto kind = std::pair{instr.is_branch != 0, !is_memory_free(instr)};
+    auto [it, inserted] = kinds.try_emplace(instr.ip, kind);
+    REQUIRE(it->second == kind);
+  }
+}
+
+TEST_CASE("A trace generator keeps to its instruction mix")
+{
+  // Without branches, the program runs straight through, so that one pass sees each slot once
+  champsim::trace_generator_spec spec;
+  spec.code_footprint = 1 << 18;
+  spec.load_fraction = 0.3;
+  spec.store_fraction = 0.1;
+  spec.branch_fraction = 0;
+  champsim::trace_generator uut{spec};
+
+  constexpr int count = (1 << 18) / 4;
+  int loads = 0;
+  int stores = 0;
+  for (int i = 0; i < count; ++i) {
+    auto instr = uut();
+    loads += (instr.source_memory[0] != 0);
+    stores += (instr.destination_memory[0] != 0);
+  }
+
+  REQUIRE(loads == Approx(0.3 * count).epsilon(0.05));
+  REQUIRE(stores == Approx(0.1 * count).epsilon(0.05));
+}
+
+TEST_CASE("A trace generator keeps memory accesses within the data streams")
+{
+  champsim::trace_generator_spec spec;
+  spec.streams = {{champsim::trace_generator_spec::stream_kind::stride, 0x10000000, 1 << 16, 64, 1},
+                  {champsim::trace_generator_spec::stream_kind::pointer_chase, 0x20000000, 1 << 16, 0, 1},
+                  {champsim::trace_generator_spec::stream_kind::random, 0x30000000, 1 << 16, 0, 1}};
+  champsim::trace_generator uut{spec};
+
+  for (int i = 0; i < 100000; ++i) {
+    auto instr = uut();
+    for (auto addr : {instr.source_memory[0], instr.destination_memory[0]}) {
+      if (addr != 0) {
+        auto in_stream = [addr](const auto& stream) { return addr >= stream.base && addr < stream.base + stream.footprint; };
+        REQUIRE(std::any_of(std::begin(spec.streams), std::end(spec.streams), in_stream));
+      }
+    }
+  }
+}
+
+TEST_CASE("A pointer-chase stream visits every block before repeating")
+{
+  champsim::trace_generator_spec spec;
+  spec.load_fraction = 1;
+  spec.store_fraction = 0;
+  spec.branch_fraction = 0;
+  spec.streams = {{champsim::trace_generator_spec::stream_kind::pointer_chase, 0x20000000, 1 << 16, 0, 1}};
+  champsim::trace_generator uut{spec};
+
+  std::set<unsigned long long> visited;
+  for (int i = 0; i < (1 << 16) / 64; ++i) {
+    visited.insert(uut().source_memory[0]);
+  }
+  REQUIRE(std::size(visited) == (1 << 16) / 64);
+}
+
+TEST_CASE("A trace generator moves between its phases")
+{
+  champsim::trace_generator_spec first;
+  first.length = 100;
+  first.code_base = 0x400000;
+  auto second = first;
+  second.code_base = 0x800000;
+  champsim::trace_generator uut{{first, second}};
+
+  for (int repeat = 0; repeat < 2; ++repeat) {
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(uut().ip < 0x800000);
+    }
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(uut().ip >= 0x800000);
+    }
+  }
+}
+
+TEST_CASE("A trace generator rejects an impossible mix")
+{
+  champsim::trace_generator_spec spec;
+  spec.load_fraction = 0.6;
+  spec.store_fraction = 0.6;
+  REQUIRE_THROWS_AS(champsim::trace_generator{spec}, std::invalid_argument);
+}
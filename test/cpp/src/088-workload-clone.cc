@@ -0,0 +1,232 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include "trace_generator.h"
+#include "workload_clone.h"
+
+namespace
+{
+input_instr load(unsigned long long ip, unsigned long long address)
+{
+  input_instr instr{};
+  instr.ip = ip;
+  instr.destination_registers[0] = 1;
+  instr.source_memory[0] = address;
+  return instr;
+}
+
+input_instr conditional(unsigned long long ip, bool taken)
+{
+  input_instr instr{};
+  instr.ip = ip;
+  instr.is_branch = true;
+  instr.branch_taken = taken;
+  instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+  instr.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+  instr.source_registers[1] = champsim::REG_FLAGS;
+  return instr;
+}
+
+const champsim::workload_profile::ip_model& model_of(const champsim::workload_profile& profile, unsigned long long ip)
+{
+  auto found = std::find_if(std::begin(profile.ips), std::end(profile.ips), [ip](const auto& model) { return model.ip == ip; });
+  REQUIRE(found != std::end(profile.ips));
+  return *found;
+}
+} // namespace
+
+TEST_CASE("A workload profiler records the strides of each IP")
+{
+  champsim::workload_profiler uut;
+  for (unsigned long long i = 0; i < 100; ++i) {
+    uut(ooo_model_instr{0, load(0x1000, 0x10000000 + 64 * i)});
+  }
+
+  auto model = model_of(uut.profile(), 0x1000);
+  REQUIRE(model.count == 100);
+  REQUIRE(model.loads == 100);
+  REQUIRE(model.stores == 0);
+  REQUIRE(model.strides == std::vector<std::pair<int64_t, uint64_t>>{{64, 99}});
+  REQUIRE(model.other_strides == 0);
+  REQUIRE(model.reuse.back() == 100); // every block is touched once
+}
+
+TEST_CASE("A workload profiler records reuse distances")
+{
+  champsim::workload_profiler uut;
+  for (int i = 0; i < 50; ++i) {
+    uut(ooo_model_instr{0, load(0x1000, 0x10000000)});
+    uut(ooo_model_instr{0, load(0x1004, 0x20000000)});
+  }
+
+  auto profile = uut.profile();
+  for (auto ip : {0x1000, 0x1004}) {
+    auto model = model_of(profile, ip);
+    REQUIRE(model.reuse.at(1) == 49); // each block is revisited after two accesses
+    REQUIRE(model.reuse.back() == 1);
+  }
+}
+
+TEST_CASE("A workload profiler records dependency distances")
+{
+  input_instr producer{};
+  producer.ip = 0x1000;
+  producer.destination_registers[0] = 3;
+  input_instr consumer{};
+  consumer.ip = 0x1004;
+  consumer.source_registers[0] = 3;
+
+  champsim::workload_profiler uut;
+  uut(ooo_model_instr{0, producer});
+  uut(ooo_model_instr{0, consumer});
+
+  auto profile = uut.profile();
+  REQUIRE(model_of(profile, 0x1000).dependency.back() == 1);
+  REQUIRE(model_of(profile, 0x1004).dependency.front() == 1);
+}
+
+TEST_CASE("A workload profiler records branch transitions and successors")
+{
+  champsim::workload_profiler uut;
+  for (int i = 0; i < 100; ++i) {
+    uut(ooo_model_instr{0, conditional(0x1000, i % 2 == 0)});
+    uut(ooo_model_instr{0, load(0x1000 + ((i % 2 == 0) ? 0x100 : 4), 0x10000000)});
+  }
+
+  auto model = model_of(uut.profile(), 0x1000);
+  REQUIRE(model.branch == BRANCH_CONDITIONAL);
+  REQUIRE(model.taken == 50);
+  REQUIRE(model.after_taken == 50);
+  REQUIRE(model.taken_after_taken == 0);
+  REQUIRE(model.taken_after_not_taken == 49);
+  REQUIRE(model.targets == std::vector<std::pair<uint64_t, uint64_t>>{{0x1100, 50}});
+  REQUIRE(model.fallthrough == 0x1004);
+}
+
+TEST_CASE("A workload profile survives a round trip through JSON")
+{
+  champsim::trace_generator_spec spec;
+  champsim::trace_generator generator{spec};
+  champsim::workload_profiler profiler;
+  for (int i = 0; i < 10000; ++i) {
+    profiler(ooo_model_instr{0, generator()});
+  }
+
+  auto profile = profiler.profile();
+  std::stringstream stream;
+  champsim::write_workload_profile(stream, profile);
+  auto reread = champsim::read_workload_profile(stream);
+
+  REQUIRE(reread.instructions == profile.instructions);
+  REQUIRE(reread.first_ip == profile.first_ip);
+  REQUIRE(std::size(reread.ips) == std::size(profile.ips));
+  for (std::size_t i = 0; i < std::size(profile.ips); ++i) {
+    const auto& lhs = reread.ips.at(i);
+    const auto& rhs = profile.ips.at(i);
+    REQUIRE(lhs.ip == rhs.ip);
+    REQUIRE(lhs.count == rhs.count);
+    REQUIRE(lhs.branch == rhs.branch);
+    REQUIRE(lhs.strides == rhs.strides);
+    REQUIRE(lhs.reuse == rhs.reuse);
+    REQUIRE(lhs.dependency == rhs.dependency);
+    REQUIRE(lhs.targets == rhs.targets);
+    REQUIRE(lhs.fallthrough == rhs.fallthrough);
+  }
+}
+
+TEST_CASE("A clone keeps to the instruction mix and branch bias of its profile")
+{
+  // With only conditional branches, the generated program is itself a Markov chain over its IPs, as the clone is
+  champsim::trace_generator_spec spec;
+  spec.branch_fraction = 0.1;
+  spec.direct_jump_weight = 0;
+  spec.indirect_weight = 0;
+  spec.call_weight = 0;
+  spec.return_weight = 0;
+  spec.branch_predictability = 0.8;
+  champsim::trace_generator generator{spec};
+  champsim::workload_profiler profiler;
+  constexpr int count = 200000;
+  for (int i = 0; i < count; ++i) {
+    profiler(ooo_model_instr{0, generator()});
+  }
+  auto profile = profiler.profile();
+
+  uint64_t loads = 0;
+  uint64_t stores = 0;
+  uint64_t branches = 0;
+  uint64_t taken = 0;
+  for (const auto& model : profile.ips) {
+    loads += model.loads;
+    stores += model.stores;
+    branches += (model.branch != NOT_BRANCH) ? model.count : 0;
+    taken += model.taken;
+  }
+
+  champsim::clone_generator uut{profile, 88};
+  std::set<unsigned long long> profiled_ips;
+  std::transform(std::begin(profile.ips), std::end(profile.ips), std::inserter(profiled_ips, std::end(profiled_ips)), [](const auto& x) { return x.ip; });
+
+  uint64_t clone_loads = 0;
+  uint64_t clone_stores = 0;
+  uint64_t clone_branches = 0;
+  uint64_t clone_taken = 0;
+  for (int i = 0; i < count; ++i) {
+    auto instr = uut();
+    REQUIRE(profiled_ips.count(instr.ip) == 1);
+    clone_loads += (instr.source_memory[0] != 0);
+    clone_stores += (instr.destination_memory[0] != 0);
+    clone_branches += instr.is_branch;
+    clone_taken += instr.branch_taken;
+  }
+
+  REQUIRE(clone_loads == Approx(loads).epsilon(0.1));
+  REQUIRE(clone_stores == Approx(stores).epsilon(0.1));
+  REQUIRE(clone_branches == Approx(branches).epsilon(0.1));
+  REQUIRE(clone_taken == Approx(taken).epsilon(0.1));
+}
+
+TEST_CASE("A clone reproduces the strides of its profile")
+{
+  champsim::workload_profiler profiler;
+  for (unsigned long long i = 0; i < 1000; ++i) {
+    profiler(ooo_model_instr{0, load(0x1000, 0x10000000 + 128 * i)});
+  }
+
+  champsim::clone_generator uut{profiler.profile()};
+  auto previous = uut();
+  for (int i = 0; i < 1000; ++i) {
+    auto next = uut();
+    REQUIRE(next.ip == 0x1000);
+    REQUIRE(next.source_memory[0] == previous.source_memory[0] + 128);
+    previous = next;
+  }
+}
+
+TEST_CASE("A clone is reproducible from its seed")
+{
+  champsim::trace_generator generator{champsim::trace_generator_spec{}};
+  champsim::workload_profiler profiler;
+  for (int i = 0; i < 10000; ++i) {
+    profiler(ooo_model_instr{0, generator()});
+  }
+
+  champsim::clone_generator first{profiler.profile(), 5};
+  champsim::clone_generator second{profiler.profile(), 5};
+  for (int i = 0; i < 10000; ++i) {
+    auto lhs = first();
+    auto rhs = second();
+    REQUIRE(lhs.ip == rhs.ip);
+    REQUIRE(lhs.branch_taken == rhs.branch_taken);
+    REQUIRE(lhs.source_memory[0] == rhs.source_memory[0]);
+    REQUIRE(lhs.destination_memory[0] == rhs.destination_memory[0]);
+  }
+}
+
+TEST_CASE("A clone generator rejects an empty profile")
+{
+  REQUIRE_THROWS_AS(champsim::clone_generator{champsim::workload_profile{}}, std::invalid_argument);
+}
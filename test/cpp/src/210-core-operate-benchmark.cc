@@ -0,0 +1,75 @@
+#include <catch.hpp>
+
+#include "instruction.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+// Independent chains of register dependences, with an optional load in every other instruction
+ooo_model_instr synthetic_instruction(uint64_t n, bool load_heavy)
+{
+  input_instr i{};
+  i.ip = 0x400000 + 4 * n;
+  i.destination_registers[0] = static_cast<unsigned char>(1 + n % 16);
+  i.source_registers[0] = static_cast<unsigned char>(1 + (n + 8) % 16);
+  if (load_heavy && (n % 2 == 0)) {
+    i.source_memory[0] = 0x10000000 + (n % 4096) * BLOCK_SIZE;
+  }
+
+  ooo_model_instr result{0, i};
+  result.instr_id = n;
+  return result;
+}
+
+struct core_operate_fixture {
+  do_nothing_MRC mock_L1I, mock_L1D;
+  O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+  bool load_heavy;
+  uint64_t next_instr = 1;
+
+  explicit core_operate_fixture(bool load) : load_heavy(load) { uut.warmup = false; }
+
+  void retire(long long count)
+  {
+    const auto target = uut.num_retired + count;
+    while (uut.num_retired < target) {
+      while (std::size(uut.IFETCH_BUFFER) < uut.IFETCH_BUFFER_SIZE) {
+        uut.IFETCH_BUFFER.push_back(synthetic_instruction(next_instr++, load_heavy));
+      }
+
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}}) {
+        op->_operate();
+      }
+
+      mock_L1I.addresses.clear();
+      mock_L1D.addresses.clear();
+    }
+  }
+};
+
+constexpr long long instructions_per_run = 1024;
+} // namespace
+
+TEST_CASE("O3_CPU::operate() benchmark", "[.][bench]")
+{
+  BENCHMARK_ADVANCED("O3_CPU::operate() ALU-only (1024 instructions)")(Catch::Benchmark::Chronometer meter)
+  {
+    core_operate_fixture fixture{false};
+    fixture.retire(instructions_per_run);
+    meter.measure([&] {
+      fixture.retire(instructions_per_run);
+      return fixture.uut.num_retired;
+    });
+  };
+
+  BENCHMARK_ADVANCED("O3_CPU::operate() load-heavy (1024 instructions)")(Catch::Benchmark::Chronometer meter)
+  {
+    core_operate_fixture fixture{true};
+    fixture.retire(instructions_per_run);
+    meter.measure([&] {
+      fixture.retire(instructions_per_run);
+      return fixture.uut.num_retired;
+    });
+  };
+}
@@ -0,0 +1,94 @@
+#include <catch.hpp>
+#include <random>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+// A cache whose upper level is a bare channel, so that the benchmark does not also measure a mock producer's bookkeeping
+struct cache_operate_fixture {
+  do_nothing_MRC mock_ll;
+  champsim::channel upper{};
+  CACHE uut;
+  uint64_t next_id = 1;
+
+  explicit cache_operate_fixture(std::string name)
+      : uut{champsim::cache_builder{champsim::defaults::default_l1d}.name(std::move(name)).upper_levels({&upper}).lower_level(&mock_ll.queues)}
+  {
+    for (champsim::operable* elem : std::array<champsim::operable*, 2>{{&uut, &mock_ll}}) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+  }
+
+  void cycle(champsim::address addr)
+  {
+    champsim::channel::request_type pkt;
+    pkt.address = addr;
+    pkt.v_address = addr;
+    pkt.instr_id = next_id++;
+    pkt.cpu = 0;
+    pkt.type = access_type::LOAD;
+    upper.add_rq(pkt);
+
+    uut._operate();
+    mock_ll._operate();
+
+    upper.returned.clear();
+    mock_ll.addresses.clear();
+  }
+};
+
+constexpr uint64_t cycles_per_run = 1024;
+} // namespace
+
+TEST_CASE("CACHE::operate() benchmark", "[.][bench]")
+{
+  BENCHMARK_ADVANCED("CACHE::operate() hit-heavy (1024 cycles)")(Catch::Benchmark::Chronometer meter)
+  {
+    // 256 blocks fit comfortably in the 64-set, 12-way cache
+    cache_operate_fixture fixture{"409-uut-hit"};
+    auto address_of = [](uint64_t i) { return champsim::address{0x10000000 + (i % 256) * BLOCK_SIZE}; };
+    for (uint64_t i = 0; i < 4 * cycles_per_run; ++i) {
+      fixture.cycle(address_of(i));
+    }
+
+    uint64_t i = 0;
+    meter.measure([&] {
+      for (auto end = i + cycles_per_run; i < end; ++i) {
+        fixture.cycle(address_of(i));
+      }
+      return fixture.uut.current_time;
+    });
+  };
+
+  BENCHMARK_ADVANCED("CACHE::operate() miss-heavy (1024 cycles)")(Catch::Benchmark::Chronometer meter)
+  {
+    cache_operate_fixture fixture{"409-uut-miss"};
+    std::mt19937_64 rng{409};
+    std::uniform_int_distribution<uint64_t> block_dist{0, (uint64_t{1} << 32) - 1};
+
+    meter.measure([&] {
+      for (uint64_t i = 0; i < cycles_per_run; ++i) {
+        fixture.cycle(champsim::address{block_dist(rng) * BLOCK_SIZE});
+      }
+      return fixture.uut.current_time;
+    });
+  };
+
+  BENCHMARK_ADVANCED("CACHE::operate() streaming (1024 cycles)")(Catch::Benchmark::Chronometer meter)
+  {
+    cache_operate_fixture fixture{"409-uut-stream"};
+    uint64_t next_block = 0;
+
+    meter.measure([&] {
+      for (uint64_t i = 0; i < cycles_per_run; ++i) {
+        fixture.cycle(champsim::address{0x10000000 + (next_block++) * BLOCK_SIZE});
+      }
+      return fixture.uut.current_time;
+    });
+  };
+}
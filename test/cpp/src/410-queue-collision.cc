@@ -321,3 +321,44 @@ SCENARIO("Translating cache queues forward RQ virtual to physical RQ")
     }
   }
 }
+
+SCENARIO("Cache queues merge with the oldest remaining packet after the front is consumed")
+{
+  GIVEN("A read queue with two checked packets")
+  {
+    champsim::address address{0xdeadbeef};
+    champsim::address other_address{0xcafebabe};
+    champsim::channel uut{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+
+    issue(uut, address, issue_rq<decltype(uut)>);
+    issue(uut, other_address, issue_rq<decltype(uut)>);
+    uut.check_collision();
+
+    WHEN("The first packet is consumed and a packet with its address is sent")
+    {
+      uut.RQ.pop_front();
+      issue(uut, address, issue_rq<decltype(uut)>);
+      uut.check_collision();
+
+      THEN("The packets are not merged")
+      {
+        CHECK(uut.rq_occupancy() == 2);
+        CHECK(uut.sim_stats.RQ_MERGED == 0);
+      }
+
+      AND_WHEN("A packet with the address of the remaining packet is sent")
+      {
+        issue(uut, other_address, issue_rq<decltype(uut)>);
+        uut.check_collision();
+
+        THEN("The packet is merged with the remaining packet")
+        {
+          REQUIRE(uut.rq_occupancy() == 2);
+          CHECK(uut.RQ.front().address == other_address);
+          CHECK(uut.RQ.back().address == address);
+          CHECK(uut.sim_stats.RQ_MERGED == 1);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,95 @@
+#include <catch.hpp>
+#include <filesystem>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "cache.h"
+#include "cache_checkpoint.h"
+#include "defaults.hpp"
+#include "environment.h"
+#include "mocks.hpp"
+
+namespace
+{
+// An environment holding only a cache, which is all that the checkpoint needs
+struct cache_only_environment final : champsim::environment {
+  CACHE& cache;
+
+  explicit cache_only_environment(CACHE& c) : cache(c) {}
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::ref(cache)}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+  MEMORY_CONTROLLER& dram_view() final { throw std::logic_error{"This environment has no memory controller"}; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {std::ref<champsim::operable>(cache)}; }
+};
+
+// Fill every way of every set
+std::vector<CACHE::checkpoint_entry> full_contents(const CACHE& cache)
+{
+  std::vector<CACHE::checkpoint_entry> result;
+  for (long set = 0; set < cache.NUM_SET; ++set) {
+    for (long way = 0; way < cache.NUM_WAY; ++way) {
+      CACHE::checkpoint_entry entry{set, way, {}};
+      entry.block.valid = true;
+      entry.block.address = champsim::address{static_cast<uint64_t>((way + 1) * cache.NUM_SET + set) * BLOCK_SIZE};
+      result.push_back(entry);
+    }
+  }
+  return result;
+}
+} // namespace
+
+SCENARIO("A cache checkpoint restores the saved contents")
+{
+  GIVEN("A cache with every block valid")
+  {
+    do_nothing_MRC mock_ll;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}.name("416-uut").sets(64).lower_level(&mock_ll.queues)};
+    uut.initialize();
+    uut.restore_checkpoint(full_contents(uut));
+    cache_only_environment env{uut};
+    const auto path = std::filesystem::temp_directory_path() / "416-cache-checkpoint.txt";
+
+    WHEN("The checkpoint is saved, the cache is cleared, and the checkpoint is loaded")
+    {
+      champsim::save_cache_checkpoint(env, path);
+      uut.restore_checkpoint({});
+      REQUIRE(std::empty(uut.checkpoint_contents()));
+      champsim::load_cache_checkpoint(env, path);
+
+      THEN("The contents match")
+      {
+        auto expected = full_contents(uut);
+        auto actual = uut.checkpoint_contents();
+        REQUIRE(std::size(actual) == std::size(expected));
+        for (std::size_t i = 0; i < std::size(expected); ++i) {
+          REQUIRE(actual.at(i).set == expected.at(i).set);
+          REQUIRE(actual.at(i).way == expected.at(i).way);
+          REQUIRE(actual.at(i).block.address == expected.at(i).block.address);
+        }
+      }
+    }
+
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("Cache checkpoint benchmark", "[.][bench]")
+{
+  do_nothing_MRC mock_ll;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.name("416-uut").sets(2048).lower_level(&mock_ll.queues)};
+  uut.initialize();
+  const auto contents = full_contents(uut);
+  uut.restore_checkpoint(contents);
+  cache_only_environment env{uut};
+  const auto path = std::filesystem::temp_directory_path() / "416-cache-checkpoint-benchmark.txt";
+  const auto label = fmt::format("({} blocks)", std::size(contents));
+
+  BENCHMARK("save_cache_checkpoint() " + label) { champsim::save_cache_checkpoint(env, path); };
+
+  champsim::save_cache_checkpoint(env, path);
+  BENCHMARK("load_cache_checkpoint() " + label) { champsim::load_cache_checkpoint(env, path); };
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "modules.h"
+
+namespace
+{
+constexpr champsim::address prefetching_ip{0x400000};
+constexpr champsim::address demand_ip{0x500000};
+} // namespace
+
+struct next_page_on_ip : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool, bool, access_type, uint32_t metadata_in)
+  {
+    if (ip == ::prefetching_ip) {
+      prefetch_line(champsim::address{addr.to<uint64_t>() + 0x1000}, true, metadata_in);
+    }
+    return metadata_in;
+  }
+
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in) { return metadata_in; }
+};
+
+struct next_page_on_fill : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address, champsim::address, bool, bool, access_type, uint32_t metadata_in) { return metadata_in; }
+
+  uint32_t prefetcher_cache_fill(champsim::address addr, long, long, uint8_t prefetch, champsim::address, uint32_t metadata_in)
+  {
+    if (!prefetch) {
+      prefetch_line(champsim::address{addr.to<uint64_t>() + 0x1000}, true, metadata_in);
+    }
+    return metadata_in;
+  }
+};
+
+SCENARIO("A cache attributes misses and useless prefetches to instruction addresses")
+{
+  GIVEN("An empty cache that attributes events to instruction addresses")
+  {
+    constexpr auto hit_latency = 4;
+    constexpr auto fill_latency = 3;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("427-uut")
+                  .sets(1)
+                  .ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)
+                  .fill_latency(fill_latency)
+                  .ip_attribution(4)
+                  .prefetcher<next_page_on_ip>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    for (auto i = 0; i < 10; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    WHEN("A load from the prefetching instruction misses")
+    {
+      decltype(mock_ul)::request_type test_a;
+      test_a.address = champsim::address{0xdeadbeef};
+      test_a.ip = prefetching_ip;
+      test_a.cpu = 0;
+      test_a.type = access_type::LOAD;
+      test_a.instr_id = 1;
+
+      auto test_a_result = mock_ul.issue(test_a);
+
+      for (auto i = 0; i < 4 * (fill_latency + hit_latency); ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The miss is attributed to the instruction")
+      {
+        CHECK(test_a_result);
+        auto top = uut.sim_stats.top_ips.top();
+        REQUIRE(std::size(top) == 1);
+        REQUIRE(top.front().ip == prefetching_ip);
+        REQUIRE(top.front().misses == 1);
+        REQUIRE(top.front().miss_latency_samples == 1);
+      }
+
+      AND_WHEN("A load from another instruction evicts the prefetched block")
+      {
+        decltype(mock_ul)::request_type test_b;
+        test_b.address = champsim::address{0xcafebabe};
+        test_b.ip = demand_ip;
+        test_b.cpu = 0;
+        test_b.type = access_type::LOAD;
+        test_b.instr_id = 2;
+
+        auto test_b_result = mock_ul.issue(test_b);
+
+        for (auto i = 0; i < 4 * (fill_latency + hit_latency); ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        THEN("The useless prefetch is attributed to the instruction that issued it")
+        {
+          CHECK(test_b_result);
+          REQUIRE(uut.sim_stats.pf_useless == 1);
+
+          auto top = uut.sim_stats.top_ips.top();
+          REQUIRE(std::size(top) == 2);
+          REQUIRE(top.at(0).ip == prefetching_ip);
+          REQUIRE(top.at(0).misses == 1);
+          REQUIRE(top.at(0).useless_prefetches == 1);
+          REQUIRE(top.at(1).ip == demand_ip);
+          REQUIRE(top.at(1).misses == 1);
+          REQUIRE(top.at(1).useless_prefetches == 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A cache does not attribute useless prefetches that no instruction issued")
+{
+  GIVEN("An empty cache whose prefetcher issues prefetches when blocks are filled")
+  {
+    constexpr auto hit_latency = 4;
+    constexpr auto fill_latency = 3;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("427-uut-fill")
+                  .sets(1)
+                  .ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)
+                  .fill_latency(fill_latency)
+                  .ip_attribution(4)
+                  .prefetcher<next_page_on_fill>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    for (auto i = 0; i < 10; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    WHEN("Two loads miss, and the second evicts the block prefetched on the first fill")
+    {
+      decltype(mock_ul)::request_type test_a;
+      test_a.address = champsim::address{0xdeadbeef};
+      test_a.ip = prefetching_ip;
+      test_a.cpu = 0;
+      test_a.type = access_type::LOAD;
+      test_a.instr_id = 1;
+      mock_ul.issue(test_a);
+
+      for (auto i = 0; i < 4 * (fill_latency + hit_latency); ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      decltype(mock_ul)::request_type test_b;
+      test_b.address = champsim::address{0xcafebabe};
+      test_b.ip = demand_ip;
+      test_b.cpu = 0;
+      test_b.type = access_type::LOAD;
+      test_b.instr_id = 2;
+      mock_ul.issue(test_b);
+
+      for (auto i = 0; i < 4 * (fill_latency + hit_latency); ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The useless prefetch is counted as untriggered, and not attributed to any address")
+      {
+        REQUIRE(uut.sim_stats.pf_useless == 1);
+        REQUIRE(uut.sim_stats.top_ips.untriggered_useless_prefetches() == 1);
+
+        auto top = uut.sim_stats.top_ips.top();
+        REQUIRE(std::none_of(std::begin(top), std::end(top), [](const auto& entry) { return entry.useless_prefetches > 0; }));
+        REQUIRE(std::none_of(std::begin(top), std::end(top), [](const auto& entry) { return entry.ip == champsim::address{}; }));
+      }
+    }
+  }
+}
+
+SCENARIO("A cache attributes late prefetches to the instruction that issued them")
+{
+  GIVEN("An empty cache whose lower level holds its misses in flight")
+  {
+    constexpr auto hit_latency = 4;
+    constexpr auto fill_latency = 3;
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("427-uut-late")
+                  .sets(1)
+                  .ways(1)
+                  .mshr_size(2)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)
+                  .fill_latency(fill_latency)
+                  .ip_attribution(4)
+                  .prefetcher<next_page_on_ip>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    for (auto i = 0; i < 10; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    WHEN("A load from another instruction requests a block while its prefetch is in flight")
+    {
+      decltype(mock_ul)::request_type test_a;
+      test_a.address = champsim::address{0xdeadbeef};
+      test_a.ip = prefetching_ip;
+      test_a.cpu = 0;
+      test_a.type = access_type::LOAD;
+      test_a.instr_id = 1;
+      mock_ul.issue(test_a);
+
+      for (auto i = 0; i < 4 * (fill_latency + hit_latency); ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      decltype(mock_ul)::request_type test_b;
+      test_b.address = champsim::address{0xdeadbeef + 0x1000};
+      test_b.ip = demand_ip;
+      test_b.cpu = 0;
+      test_b.type = access_type::LOAD;
+      test_b.instr_id = 2;
+      mock_ul.issue(test_b);
+
+      for (auto i = 0; i < 4 * (fill_latency + hit_latency); ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The late prefetch is attributed to the instruction that issued the prefetch")
+      {
+        REQUIRE(uut.sim_stats.pf_useful == 1);
+        REQUIRE(uut.sim_stats.top_ips.untriggered_late_prefetches() == 0);
+
+        auto top = uut.sim_stats.top_ips.top();
+        auto prefetcher_entry = std::find_if(std::begin(top), std::end(top), [](const auto& entry) { return entry.ip == prefetching_ip; });
+        REQUIRE(prefetcher_entry != std::end(top));
+        REQUIRE(prefetcher_entry->late_prefetches == 1);
+        REQUIRE(std::none_of(std::begin(top), std::end(top), [](const auto& entry) { return entry.ip == demand_ip && entry.late_prefetches > 0; }));
+      }
+    }
+  }
+}
@@ -3,6 +3,7 @@
 
 #include "cache.h"
 #include "defaults.hpp"
+#include "instruction.h"
 #include "mocks.hpp"
 
 namespace
@@ -43,8 +44,46 @@ struct dual_interface : champsim::modules::prefetcher {
     return metadata_in;
   }
 };
+
+struct cycle_and_branch_hooks : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  long cycles = 0;
+  long branches = 0;
+
+  void prefetcher_cycle_operate() { ++cycles; }
+  void prefetcher_branch_operate(champsim::address, uint8_t, champsim::address) { ++branches; }
+};
 } // namespace
 
+TEST_CASE("A cache calls the cycle and branch hooks only if one of its prefetchers has them")
+{
+  CACHE::prefetcher_module_model<::dual_interface> without_hooks{nullptr};
+  REQUIRE_FALSE(without_hooks.calls_cycle_operate);
+  REQUIRE_FALSE(without_hooks.calls_branch_operate);
+
+  CACHE::prefetcher_module_model<::dual_interface, ::cycle_and_branch_hooks> with_hooks{nullptr};
+  REQUIRE(with_hooks.calls_cycle_operate);
+  REQUIRE(with_hooks.calls_branch_operate);
+
+  do_nothing_MRC mock_ll;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l1i}
+                .name("430-uut-hooks")
+                .lower_level(&mock_ll.queues)
+                .prefetcher<::cycle_and_branch_hooks>()};
+  uut.initialize();
+  uut.begin_phase();
+
+  for (int i = 0; i < 10; ++i) {
+    uut._operate();
+  }
+  uut.impl_prefetcher_branch_operate(champsim::address{0x400000}, BRANCH_CONDITIONAL, champsim::address{0x400100});
+
+  const auto& hooks = std::get<0>(static_cast<CACHE::prefetcher_module_model<::cycle_and_branch_hooks>&>(*uut.pref_module_pimpl).intern_);
+  REQUIRE(hooks.cycles == 10);
+  REQUIRE(hooks.branches == 1);
+}
+
 SCENARIO("The prefetcher interface prefers one that uses champsim::address")
 {
   using namespace std::literals;
@@ -0,0 +1,129 @@
+#include <catch.hpp>
+#include <map>
+#include <stdexcept>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "module_registry.h"
+
+namespace
+{
+std::map<CACHE*, int> operate_discerner;
+
+template <int ID>
+struct marking_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address, champsim::address, uint8_t, bool, access_type, uint32_t metadata_in)
+  {
+    ::operate_discerner[intern_] = ID;
+    return metadata_in;
+  }
+
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in) { return metadata_in; }
+};
+
+struct fixed_victim : champsim::modules::replacement {
+  using replacement::replacement;
+
+  long find_victim(uint32_t, uint64_t, long, const CACHE::BLOCK*, champsim::address, champsim::address, access_type) { return 0; }
+  void update_replacement_state(uint32_t, long, long, champsim::address, champsim::address, access_type, bool) {}
+};
+
+champsim::module_registry test_registry()
+{
+  champsim::module_registry registry;
+  registry.add_prefetcher<marking_prefetcher<1>>("first");
+  registry.add_prefetcher<marking_prefetcher<2>>("second");
+  registry.add_replacement<fixed_victim>("fixed");
+  return registry;
+}
+} // namespace
+
+SCENARIO("A prefetcher selected at runtime replaces the configured one")
+{
+  GIVEN("A cache configured with one prefetcher")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("cpu0_L1D")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::marking_prefetcher<1>>()};
+
+    WHEN("The other prefetcher is selected by the kind of cache")
+    {
+      champsim::select_modules(::test_registry(), {std::ref(uut)}, R"({"L1D": {"prefetcher": "second"}})");
+
+      std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+      for (auto elem : elements) {
+        elem->initialize();
+        elem->warmup = false;
+        elem->begin_phase();
+      }
+
+      ::operate_discerner.insert_or_assign(&uut, 0);
+
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      auto test_result = mock_ul.issue(test);
+      REQUIRE(test_result);
+
+      for (auto i = 0; i < 100; ++i) {
+        for (auto elem : elements) {
+          elem->_operate();
+        }
+      }
+
+      THEN("The selected prefetcher is called") { REQUIRE(::operate_discerner.at(&uut) == 2); }
+    }
+  }
+}
+
+TEST_CASE("A module selection may name a cache exactly")
+{
+  do_nothing_MRC mock_ll;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").lower_level(&mock_ll.queues)};
+  REQUIRE_NOTHROW(champsim::select_modules(::test_registry(), {std::ref(uut)}, R"({"LLC": {"replacement": "fixed", "prefetcher": "first"}})"));
+}
+
+TEST_CASE("A module selection is rejected if it cannot be applied")
+{
+  do_nothing_MRC mock_ll;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").lower_level(&mock_ll.queues)};
+  auto registry = ::test_registry();
+
+  SECTION("The selection is not valid JSON")
+  {
+    REQUIRE_THROWS_AS(champsim::select_modules(registry, {std::ref(uut)}, R"({"LLC": {"prefetcher": "first")"), std::invalid_argument);
+  }
+
+  SECTION("The selection is not a JSON object")
+  {
+    REQUIRE_THROWS_AS(champsim::select_modules(registry, {std::ref(uut)}, R"(["LLC"])"), std::invalid_argument);
+  }
+
+  SECTION("The module is not registered") { REQUIRE_THROWS_AS(champsim::select_modules(registry, {std::ref(uut)}, R"({"LLC": {"prefetcher": "third"}})"), std::invalid_argument); }
+
+  SECTION("The module is registered as the other kind")
+  {
+    REQUIRE_THROWS_AS(champsim::select_modules(registry, {std::ref(uut)}, R"({"LLC": {"replacement": "first"}})"), std::invalid_argument);
+  }
+
+  SECTION("No cache has the name") { REQUIRE_THROWS_AS(champsim::select_modules(registry, {std::ref(uut)}, R"({"L2C": {"prefetcher": "first"}})"), std::invalid_argument); }
+
+  SECTION("A cache is named only in part") { REQUIRE_THROWS_AS(champsim::select_modules(registry, {std::ref(uut)}, R"({"C": {"prefetcher": "first"}})"), std::invalid_argument); }
+
+  SECTION("Something other than a module is selected")
+  {
+    REQUIRE_THROWS_AS(champsim::select_modules(registry, {std::ref(uut)}, R"({"LLC": {"sets": "first"}})"), std::invalid_argument);
+  }
+
+  SECTION("The registry is empty")
+  {
+    REQUIRE_THROWS_AS(champsim::select_modules(champsim::module_registry{}, {std::ref(uut)}, R"({"LLC": {"prefetcher": "first"}})"), std::invalid_argument);
+  }
+}
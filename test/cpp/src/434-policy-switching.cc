@@ -0,0 +1,174 @@
+#include <catch.hpp>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "environment.h"
+#include "mocks.hpp"
+#include "module_registry.h"
+#include "phase_info.h"
+#include "policy_control.h"
+
+namespace
+{
+std::map<CACHE*, int> prefetcher_initializations;
+std::map<CACHE*, int> replacement_initializations;
+std::map<CACHE*, int> replacement_fills;
+
+struct counting_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  void prefetcher_initialize() { ++::prefetcher_initializations[intern_]; }
+  uint32_t prefetcher_cache_operate(champsim::address, champsim::address, uint8_t, bool, access_type, uint32_t metadata_in) { return metadata_in; }
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in) { return metadata_in; }
+};
+
+struct counting_replacement : champsim::modules::replacement {
+  using replacement::replacement;
+
+  void initialize_replacement() { ++::replacement_initializations[intern_]; }
+  long find_victim(uint32_t, uint64_t, long, const CACHE::BLOCK*, champsim::address, champsim::address, access_type) { return 0; }
+  void update_replacement_state(uint32_t, long, long, champsim::address, champsim::address, access_type, bool) {}
+  void replacement_cache_fill(uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type) { ++::replacement_fills[intern_]; }
+};
+
+struct cache_only_environment final : champsim::environment {
+  CACHE& cache;
+
+  explicit cache_only_environment(CACHE& c) : cache(c) {}
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::ref(cache)}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+  MEMORY_CONTROLLER& dram_view() final { throw std::logic_error{"This environment has no memory controller"}; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {std::ref<champsim::operable>(cache)}; }
+};
+
+champsim::module_registry test_registry()
+{
+  champsim::module_registry registry;
+  registry.add_prefetcher<counting_prefetcher>("counting");
+  registry.add_replacement<counting_replacement>("counting");
+  return registry;
+}
+
+// Fill the first way of every set
+void fill_first_ways(CACHE& cache)
+{
+  std::vector<CACHE::checkpoint_entry> contents;
+  for (long set = 0; set < cache.NUM_SET; ++set) {
+    CACHE::checkpoint_entry entry{set, 0, {}};
+    entry.block.valid = true;
+    entry.block.address = champsim::address{static_cast<uint64_t>(cache.NUM_SET + set) * BLOCK_SIZE};
+    contents.push_back(entry);
+  }
+  cache.restore_checkpoint(contents);
+}
+} // namespace
+
+SCENARIO("A running cache can switch its replacement policy and keep its contents")
+{
+  GIVEN("A cache with some valid blocks")
+  {
+    do_nothing_MRC mock_ll;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").sets(64).lower_level(&mock_ll.queues)};
+    uut.initialize();
+    ::fill_first_ways(uut);
+    const auto before = uut.checkpoint_contents();
+
+    WHEN("The replacement policy is switched")
+    {
+      ::replacement_initializations.insert_or_assign(&uut, 0);
+      ::replacement_fills.insert_or_assign(&uut, 0);
+      ::test_registry().switch_replacement(uut, "counting");
+
+      THEN("The contents are unchanged")
+      {
+        auto after = uut.checkpoint_contents();
+        REQUIRE(std::size(after) == std::size(before));
+        for (std::size_t i = 0; i < std::size(before); ++i) {
+          REQUIRE(after.at(i).block.address == before.at(i).block.address);
+        }
+      }
+
+      THEN("The new policy is initialized, then told of each valid block")
+      {
+        REQUIRE(::replacement_initializations.at(&uut) == 1);
+        REQUIRE(::replacement_fills.at(&uut) == uut.NUM_SET);
+      }
+    }
+
+    WHEN("The prefetcher is switched")
+    {
+      ::prefetcher_initializations.insert_or_assign(&uut, 0);
+      ::test_registry().switch_prefetcher(uut, "counting");
+
+      THEN("The new prefetcher is initialized") { REQUIRE(::prefetcher_initializations.at(&uut) == 1); }
+    }
+  }
+}
+
+SCENARIO("A policy controller takes commands between phases")
+{
+  GIVEN("A controller of a running cache")
+  {
+    do_nothing_MRC mock_ll;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").sets(64).lower_level(&mock_ll.queues)};
+    uut.initialize();
+    cache_only_environment env{uut};
+
+    champsim::phase_stats stats;
+    stats.name = "434-phase";
+
+    WHEN("The controller is told to switch a module, then continue")
+    {
+      std::istringstream commands{"{\"LLC\": {\"replacement\": \"counting\"}}\ncontinue\n"};
+      std::ostringstream replies;
+      champsim::policy_controller uut_controller{commands, replies, ::test_registry()};
+      ::replacement_initializations.insert_or_assign(&uut, 0);
+
+      auto go_on = uut_controller.phase_complete(env, stats);
+
+      THEN("The simulation continues") { REQUIRE(go_on); }
+
+      THEN("The module is switched") { REQUIRE(::replacement_initializations.at(&uut) == 1); }
+
+      THEN("The statistics of the phase are written, then the switch is acknowledged")
+      {
+        std::istringstream lines{replies.str()};
+        std::string stats_line;
+        std::string reply_line;
+        std::getline(lines, stats_line);
+        std::getline(lines, reply_line);
+        REQUIRE(stats_line.find("434-phase") != std::string::npos);
+        REQUIRE(reply_line == "{\"ok\":true}");
+      }
+    }
+
+    WHEN("The controller is given a selection it cannot apply")
+    {
+      std::istringstream commands{"{\"LLC\": {\"replacement\": \"missing\"}}\nstop\n"};
+      std::ostringstream replies;
+      champsim::policy_controller uut_controller{commands, replies, ::test_registry()};
+
+      auto go_on = uut_controller.phase_complete(env, stats);
+
+      THEN("The error is reported and the next command is read")
+      {
+        REQUIRE(replies.str().find("\"error\"") != std::string::npos);
+        REQUIRE_FALSE(go_on);
+      }
+    }
+
+    WHEN("The commands end")
+    {
+      std::istringstream commands{""};
+      std::ostringstream replies;
+      champsim::policy_controller uut_controller{commands, replies, ::test_registry()};
+
+      THEN("The simulation stops") { REQUIRE_FALSE(uut_controller.phase_complete(env, stats)); }
+    }
+  }
+}
@@ -0,0 +1,137 @@
+#include <catch.hpp>
+#include <stdexcept>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "environment.h"
+#include "geometry_overrides.h"
+#include "mocks.hpp"
+
+namespace
+{
+struct cache_only_environment final : champsim::environment {
+  CACHE& cache;
+
+  explicit cache_only_environment(CACHE& c) : cache(c) {}
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::ref(cache)}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+  MEMORY_CONTROLLER& dram_view() final { throw std::logic_error{"This environment has no memory controller"}; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {std::ref<champsim::operable>(cache)}; }
+};
+} // namespace
+
+SCENARIO("An override replaces the configured geometry of a cache")
+{
+  GIVEN("A cache builder with a configured geometry")
+  {
+    do_nothing_MRC mock_ll;
+    auto builder = champsim::cache_builder{champsim::defaults::default_l2c}.name("cpu0_L2C").sets(1024).ways(8).latency(10).lower_level(&mock_ll.queues);
+
+    WHEN("The sets and latency of every core's cache of that kind are overridden")
+    {
+      champsim::geometry_overrides overrides;
+      overrides.add("L2C.sets=4096");
+      overrides.add_json(R"({"L2C": {"latency": 20}})");
+      CACHE uut{overrides.apply("cpu0_L2C", builder)};
+
+      THEN("The cache has the overridden sets") { REQUIRE(uut.NUM_SET == 4096); }
+      THEN("The cache keeps the configured ways") { REQUIRE(uut.NUM_WAY == 8); }
+      THEN("The cache has the overridden latency") { REQUIRE(uut.HIT_LATENCY + uut.FILL_LATENCY == 20 * uut.clock_period); }
+    }
+
+    WHEN("Another cache is overridden")
+    {
+      champsim::geometry_overrides overrides;
+      overrides.add("LLC.sets=4096");
+      CACHE uut{overrides.apply("cpu0_L2C", builder)};
+
+      THEN("The cache keeps the configured sets") { REQUIRE(uut.NUM_SET == 1024); }
+    }
+
+    WHEN("The same parameter is overridden twice")
+    {
+      champsim::geometry_overrides overrides;
+      overrides.add("L2C.ways=4");
+      overrides.add("cpu0_L2C.ways=16");
+      CACHE uut{overrides.apply("cpu0_L2C", builder)};
+
+      THEN("The later override takes precedence") { REQUIRE(uut.NUM_WAY == 16); }
+    }
+  }
+}
+
+TEST_CASE("An override replaces the configured parameters of a core")
+{
+  champsim::geometry_overrides overrides;
+  overrides.add("ooo_cpu.rob_size=512");
+  overrides.add("cpu1.lq_size=64");
+
+  auto builder = overrides.apply("cpu0", champsim::core_builder{champsim::defaults::default_core}.rob_size(352).lq_size(128));
+  REQUIRE(builder.m_rob_size == 512);
+  REQUIRE(builder.m_lq_size == 128);
+}
+
+TEST_CASE("An override replaces a parameter of the memory controller")
+{
+  champsim::geometry_overrides overrides;
+  overrides.add("DRAM.tRP=30");
+  REQUIRE(overrides.value("DRAM", "tRP", 24) == 30);
+  REQUIRE(overrides.value("DRAM", "tCAS", 24) == 24);
+}
+
+TEST_CASE("A malformed override is rejected")
+{
+  champsim::geometry_overrides overrides;
+
+  SECTION("The override has no component") { REQUIRE_THROWS_AS(overrides.add("sets=4096"), std::invalid_argument); }
+  SECTION("The override has no value") { REQUIRE_THROWS_AS(overrides.add("LLC.sets"), std::invalid_argument); }
+  SECTION("The value is not a number") { REQUIRE_THROWS_AS(overrides.add("LLC.sets=many"), std::invalid_argument); }
+  SECTION("The value is negative") { REQUIRE_THROWS_AS(overrides.add("LLC.sets=-1"), std::invalid_argument); }
+  SECTION("A structure is overridden with no entries") { REQUIRE_THROWS_AS(overrides.add("LLC.ways=0"), std::invalid_argument); }
+  SECTION("The number of sets is not a power of two") { REQUIRE_THROWS_AS(overrides.add("LLC.sets=3000"), std::invalid_argument); }
+  SECTION("The number of sets in JSON is not a power of two") { REQUIRE_THROWS_AS(overrides.add_json(R"({"LLC": {"sets": 48}})"), std::invalid_argument); }
+  SECTION("No component has the parameter") { REQUIRE_THROWS_AS(overrides.add("LLC.color=4"), std::invalid_argument); }
+  SECTION("The JSON is not keyed by component") { REQUIRE_THROWS_AS(overrides.add_json(R"({"LLC": 4096})"), std::invalid_argument); }
+
+  REQUIRE(overrides.empty());
+}
+
+TEST_CASE("Overrides are validated against the components of the environment")
+{
+  do_nothing_MRC mock_ll;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").lower_level(&mock_ll.queues)};
+  cache_only_environment env{uut};
+  champsim::geometry_overrides overrides;
+
+  SECTION("A cache parameter of a cache is accepted")
+  {
+    overrides.add("LLC.sets=4096");
+    REQUIRE_NOTHROW(overrides.validate(env, "DRAM"));
+  }
+
+  SECTION("A parameter of the memory controller is accepted")
+  {
+    overrides.add("DRAM.tRP=30");
+    REQUIRE_NOTHROW(overrides.validate(env, "DRAM"));
+  }
+
+  SECTION("The memory controller is named by its configured name")
+  {
+    overrides.add("MEM.tRP=30");
+    REQUIRE_NOTHROW(overrides.validate(env, "MEM"));
+  }
+
+  SECTION("No component has the name")
+  {
+    overrides.add("L2C.sets=4096");
+    REQUIRE_THROWS_AS(overrides.validate(env, "DRAM"), std::invalid_argument);
+  }
+
+  SECTION("The parameter belongs to another kind of component")
+  {
+    overrides.add("LLC.rob_size=512");
+    REQUIRE_THROWS_AS(overrides.validate(env, "DRAM"), std::invalid_argument);
+  }
+}
@@ -0,0 +1,189 @@
+#include <array>
+#include <catch.hpp>
+
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "mocks.hpp"
+#include "ptw.h"
+#include "vmem.h"
+
+SCENARIO("The page table walker counts its walks")
+{
+  GIVEN("A 5-level virtual memory")
+  {
+    constexpr std::size_t levels = 5;
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+    VirtualMemory vmem{champsim::data::bytes{1 << 12}, levels, champsim::chrono::nanoseconds{640}, dram};
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    PageTableWalker uut{champsim::ptw_builder{champsim::defaults::default_ptw}
+                            .name("604-uut")
+                            .clock_period(champsim::chrono::picoseconds{3200})
+                            .upper_levels({&mock_ul.queues})
+                            .lower_level(&mock_ll.queues)
+                            .virtual_memory(&vmem)
+                            .set_occupancy_stats()};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ul, &uut, &mock_ll}};
+
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("The PTW receives a request")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.v_address = test.address;
+      test.cpu = 0;
+
+      auto test_result = mock_ul.issue(test);
+      REQUIRE(test_result);
+
+      for (auto i = 0; i < 10000; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The walk is recorded with its depth and latency")
+      {
+        REQUIRE(uut.sim_stats.name == "604-uut");
+        REQUIRE(uut.sim_stats.walks == 1);
+        REQUIRE(uut.sim_stats.walk_depth.value_or(levels, 0) == 1);
+        REQUIRE(uut.sim_stats.walk_depth.total() == 1);
+        REQUIRE(uut.sim_stats.walk_latency.count() == 1);
+        REQUIRE(uut.sim_stats.total_walk_latency_cycles > 0);
+        REQUIRE(uut.sim_stats.total_walk_latency_cycles <= mock_ul.packets.back().return_time - mock_ul.packets.back().issue_time);
+        REQUIRE(uut.sim_stats.concurrent_walks.value_or(0, 0) == 1);
+      }
+
+      THEN("Every PSCL misses")
+      {
+        for (auto level : {2u, 3u, 4u, 5u}) {
+          CHECK(uut.sim_stats.pscl_hits.value_or(level, 0) == 0);
+          CHECK(uut.sim_stats.pscl_misses.value_or(level, 0) == 1);
+        }
+      }
+
+      THEN("The MSHR occupancy is counted every cycle")
+      {
+        REQUIRE(uut.sim_stats.occupancy_stats);
+        REQUIRE(uut.sim_stats.cycles == 10000);
+        REQUIRE(uut.sim_stats.total_mshr_occupancy > 0);
+      }
+
+      AND_WHEN("The PTW receives a request to a neighboring page")
+      {
+        decltype(mock_ul)::request_type neighbor;
+        neighbor.address = champsim::address{0xdeadbeef + (1 << 12)};
+        neighbor.v_address = neighbor.address;
+        neighbor.cpu = 0;
+
+        auto neighbor_result = mock_ul.issue(neighbor);
+        REQUIRE(neighbor_result);
+
+        for (auto i = 0; i < 10000; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        THEN("The second walk hits in the PSCLs and is shorter")
+        {
+          REQUIRE(uut.sim_stats.walks == 2);
+          REQUIRE(uut.sim_stats.pscl_hits.total() > 0);
+          REQUIRE(uut.sim_stats.walk_depth.total() == 2);
+          REQUIRE(uut.sim_stats.walk_depth.value_or(levels, 0) == 1);
+        }
+      }
+    }
+
+    WHEN("The phase ends")
+    {
+      uut.sim_stats.walks = 7;
+      uut.end_phase(0);
+
+      THEN("The region of interest statistics are copied from the simulation statistics")
+      {
+        REQUIRE(uut.roi_stats.walks == 7);
+      }
+    }
+  }
+}
+
+SCENARIO("The page table walker does not count its occupancy by default")
+{
+  GIVEN("A page table walker without occupancy statistics")
+  {
+    constexpr std::size_t levels = 5;
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+    VirtualMemory vmem{champsim::data::bytes{1 << 12}, levels, champsim::chrono::nanoseconds{640}, dram};
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    PageTableWalker uut{champsim::ptw_builder{champsim::defaults::default_ptw}
+                            .name("604-uut")
+                            .clock_period(champsim::chrono::picoseconds{3200})
+                            .upper_levels({&mock_ul.queues})
+                            .lower_level(&mock_ll.queues)
+                            .virtual_memory(&vmem)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ul, &uut, &mock_ll}};
+
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("The PTW completes a walk")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.v_address = test.address;
+      test.cpu = 0;
+
+      auto test_result = mock_ul.issue(test);
+      REQUIRE(test_result);
+
+      for (auto i = 0; i < 10000; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The walk is recorded, but the walks in flight and the MSHR occupancy are not")
+      {
+        REQUIRE(uut.sim_stats.walks == 1);
+        REQUIRE_FALSE(uut.sim_stats.occupancy_stats);
+        REQUIRE(uut.sim_stats.concurrent_walks.total() == 0);
+        REQUIRE(uut.sim_stats.total_mshr_occupancy == 0);
+        REQUIRE(uut.sim_stats.cycles == 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include "ptw_stats.h"
+#include "stats_printer.h"
+
+TEST_CASE("An empty PTW stats prints zero")
+{
+  ptw_stats given{};
+  given.name = "test_ptw";
+
+  std::vector<std::string> expected{"test_ptw WALKS:          0 AVERAGE WALK LATENCY: - cycles AVERAGE MSHR OCCUPANCY: -"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("The PTW averages are printed")
+{
+  ptw_stats given{};
+  given.name = "test_ptw";
+  given.walks = 4;
+  given.total_walk_latency_cycles = 400;
+  given.total_mshr_occupancy = 30;
+  given.cycles = 20;
+
+  std::vector<std::string> expected{"test_ptw WALKS:          4 AVERAGE WALK LATENCY: 100 cycles AVERAGE MSHR OCCUPANCY: 1.5"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("The PSCL counters are printed from the highest level")
+{
+  ptw_stats given{};
+  given.name = "test_ptw";
+  given.pscl_hits.set(2, 10);
+  given.pscl_misses.set(2, 5);
+  given.pscl_misses.set(3, 15);
+
+  std::vector<std::string> expected{"test_ptw WALKS:          0 AVERAGE WALK LATENCY: - cycles AVERAGE MSHR OCCUPANCY: -",
+                                    "test_ptw PSCL3 HIT:          0 MISS:         15", "test_ptw PSCL2 HIT:         10 MISS:          5"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("The PTW histograms are printed")
+{
+  ptw_stats given{};
+  given.name = "test_ptw";
+  given.walk_depth.set(3, 2);
+  given.walk_latency.record(0);
+  for (long latency : {64, 70, 80, 100, 120, 127}) {
+    given.walk_latency.record(latency);
+  }
+  given.concurrent_walks.set(1, 4);
+
+  std::vector<std::string> expected{"test_ptw WALKS:          0 AVERAGE WALK LATENCY: - cycles AVERAGE MSHR OCCUPANCY: -",
+                                    "test_ptw WALK DEPTH 3:          2",
+                                    "test_ptw WALK LATENCY [0, 1):          1",
+                                    "test_ptw WALK LATENCY [64, 128):          6",
+                                    "test_ptw CONCURRENT WALKS 1:          4"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
@@ -2,6 +2,7 @@
 #include <catch.hpp>
 #include <cfenv>
 #include <cmath>
+#include <random>
 
 #include "defaults.hpp"
 #include "dram_controller.h"
@@ -11,16 +12,12 @@ std::vector<uint64_t> dram_test(MEMORY_CONTROLLER* uut, std::vector<champsim::ch
 {
   auto start_time = uut->current_time;
 
-  auto ins_begin = std::begin(uut->channels[0].RQ);
   // load requests into controller
-  std::transform(std::cbegin(*packet_stream), std::cend(*packet_stream), std::cbegin(*arriv_time), ins_begin,
-                 [period = uut->clock_period, start_time](auto pkt, uint64_t cycle) {
-                   auto r_pkt = DRAM_CHANNEL::request_type{pkt};
-                   r_pkt.forward_checked = false;
-                   r_pkt.scheduled = false;
-                   r_pkt.ready_time = start_time + cycle * period;
-                   return r_pkt;
-                 });
+  for (std::size_t i = 0; i < std::size(*packet_stream); ++i) {
+    auto r_pkt = DRAM_CHANNEL::request_type{packet_stream->at(i)};
+    r_pkt.ready_time = start_time + arriv_time->at(i) * uut->clock_period;
+    REQUIRE(uut->channels[0].add_rq(r_pkt));
+  }
 
   // carry out operates, record request scheduling order
   std::vector<bool> last_scheduled(packet_stream->size(), false);
@@ -180,3 +177,39 @@ SCENARIO("A series of reads arrive at the memory controller and are reordered")
     }
   }
 }
+
+TEST_CASE("DRAM_CHANNEL::schedule_packet() benchmark", "[.][bench]")
+{
+  auto mapper = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, 8, 1, 4, 4, 1024, 2, 65536);
+  DRAM_CHANNEL uut{champsim::chrono::picoseconds{1000},
+                   champsim::chrono::picoseconds{2000},
+                   std::size_t{2},
+                   std::size_t{2},
+                   std::size_t{4},
+                   std::size_t{4},
+                   champsim::chrono::microseconds{64},
+                   8,
+                   champsim::data::bytes{8},
+                   64,
+                   64,
+                   mapper};
+
+  // A full read queue spread across every bank
+  std::mt19937_64 rng{701};
+  for (std::size_t i = 0; i < std::size(uut.RQ); ++i) {
+    champsim::channel::request_type pkt;
+    pkt.address = champsim::address{rng()};
+    DRAM_CHANNEL::request_type r_pkt{pkt};
+    r_pkt.ready_time = uut.current_time;
+    REQUIRE(uut.add_rq(r_pkt));
+  }
+
+  BENCHMARK("DRAM_CHANNEL::schedule_packet() (1024 schedules)")
+  {
+    long result = 0;
+    for (int i = 0; i < 1024; ++i) {
+      result += std::distance(std::begin(uut.RQ), uut.schedule_packet());
+    }
+    return result;
+  };
+}
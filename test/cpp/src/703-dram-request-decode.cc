@@ -0,0 +1,37 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+TEST_CASE("A DRAM channel decodes the bank coordinates of a request when it is enqueued")
+{
+  auto ranks = GENERATE(as<std::size_t>{}, 1, 2);
+  auto bankgroups = GENERATE(as<std::size_t>{}, 2, 4);
+  auto banks = GENERATE(as<std::size_t>{}, 2, 4);
+  auto address = GENERATE(as<uint64_t>{}, 0x0, 0x1a40, 0xdeadbeef, 0x12345678c0);
+
+  auto mapper = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, 8, 1, bankgroups, banks, 128, ranks, 65536);
+  DRAM_CHANNEL uut{champsim::chrono::picoseconds{1},
+                   champsim::chrono::picoseconds{2},
+                   std::size_t{1},
+                   std::size_t{1},
+                   std::size_t{1},
+                   std::size_t{1},
+                   champsim::chrono::microseconds{1},
+                   1,
+                   champsim::data::bytes{8},
+                   4,
+                   4,
+                   mapper};
+
+  champsim::channel::request_type pkt;
+  pkt.address = champsim::address{address};
+  REQUIRE(uut.add_rq(DRAM_CHANNEL::request_type{pkt}));
+
+  const auto& entry = uut.RQ.front();
+  REQUIRE(entry.has_value());
+  CHECK(entry->bank_index == uut.bank_request_index(pkt.address));
+  CHECK(entry->bankgroup_index == uut.bankgroup_request_index(pkt.address));
+  CHECK(entry->row == mapper.get_row(pkt.address));
+  CHECK(entry->column == mapper.get_column(pkt.address));
+  CHECK(uut.RQ_ready.at(entry->bank_index).size() == 1);
+}
@@ -0,0 +1,243 @@
+#include <catch.hpp>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "dram_controller.h"
+#include "host_profile.h"
+
+namespace
+{
+DRAM_CHANNEL make_channel(const DRAM_ADDRESS_MAPPING& mapper)
+{
+  return DRAM_CHANNEL{champsim::chrono::picoseconds{1000},
+                      champsim::chrono::picoseconds{2000},
+                      std::size_t{2},
+                      std::size_t{2},
+                      std::size_t{4},
+                      std::size_t{4},
+                      champsim::chrono::microseconds{64},
+                      8,
+                      champsim::data::bytes{8},
+                      4,
+                      4,
+                      mapper};
+}
+
+struct stream_result {
+  std::vector<std::pair<uint64_t, champsim::chrono::clock::time_point>> responses{};
+  std::vector<long> progress{};
+  std::vector<dram_stats> stats{};
+  uint64_t channel_cycles_operated = 0;
+};
+
+// Send the same pseudo-random stream of reads and writes to a memory controller, and record when each response returns
+stream_result run_request_stream(bool skip_idle_cycles)
+{
+  champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+  MEMORY_CONTROLLER uut{champsim::chrono::picoseconds{1000},
+                        champsim::chrono::picoseconds{2000},
+                        std::size_t{2},
+                        std::size_t{2},
+                        std::size_t{4},
+                        std::size_t{4},
+                        champsim::chrono::microseconds{64},
+                        {&ul},
+                        8,
+                        8,
+                        2,
+                        champsim::data::bytes{8},
+                        65536,
+                        128,
+                        1,
+                        2,
+                        2,
+                        8};
+  uut.set_idle_skipping(skip_idle_cycles);
+  uut.warmup = false;
+  uut.begin_phase();
+
+  stream_result result{};
+  std::mt19937_64 rng{};
+  for (int cycle = 0; cycle < 40000; ++cycle) {
+    // Bursts of requests to a few rows, so that there are row hits, row conflicts, and full queues
+    if (cycle % 256 < 16) {
+      champsim::channel::request_type pkt;
+      pkt.address = champsim::address{rng() & 0xffc0};
+      if (rng() % 4 == 0) {
+        pkt.response_requested = false;
+        ul.add_wq(pkt);
+      } else {
+        ul.add_rq(pkt);
+      }
+    }
+
+    result.progress.push_back(uut._operate());
+    for (const auto& response : ul.returned) {
+      result.responses.emplace_back(response.address.to<uint64_t>(), uut.current_time);
+    }
+    ul.returned.clear();
+  }
+
+  for (const auto& chan : uut.channels) {
+    result.stats.push_back(chan.sim_stats);
+    result.channel_cycles_operated += chan.host_time.calls;
+  }
+  return result;
+}
+} // namespace
+
+SCENARIO("An idle DRAM channel waits for its next refresh")
+{
+  GIVEN("A DRAM channel that has been operated once")
+  {
+    auto mapper = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, 8, 1, 2, 2, 128, 1, 65536);
+    auto uut = make_channel(mapper);
+    uut.warmup = false;
+    uut._operate();
+
+    THEN("The next event is the next refresh") { REQUIRE(uut.next_event_time() == uut.last_refresh + uut.tREF); }
+
+    WHEN("A request is enqueued")
+    {
+      champsim::channel::request_type pkt;
+      pkt.address = champsim::address{0xdeadbeef};
+      DRAM_CHANNEL::request_type r_pkt{pkt};
+      r_pkt.ready_time = uut.current_time;
+      REQUIRE(uut.add_rq(r_pkt));
+
+      THEN("The next event is immediate") { REQUIRE(uut.next_event_time() <= uut.current_time); }
+
+      AND_WHEN("The channel is operated")
+      {
+        uut._operate();
+
+        THEN("The next event is when the bank is ready")
+        {
+          const auto& b_req = uut.bank_request.at(uut.bank_request_index(pkt.address));
+          REQUIRE(b_req.valid);
+          REQUIRE(uut.next_event_time() == b_req.ready_time);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Skipping idle DRAM channel cycles does not change the simulation")
+{
+  GIVEN("A memory controller that skips idle channel cycles and one that operates every cycle")
+  {
+    auto skipped = run_request_stream(true);
+    auto polled = run_request_stream(false);
+
+    THEN("Fewer channel cycles are operated") { REQUIRE(skipped.channel_cycles_operated < polled.channel_cycles_operated); }
+
+    THEN("The responses return at the same times")
+    {
+      REQUIRE_FALSE(std::empty(polled.responses));
+      REQUIRE(skipped.responses == polled.responses);
+    }
+
+    THEN("The same progress is reported every cycle") { REQUIRE(skipped.progress == polled.progress); }
+
+    THEN("The channel statistics are the same")
+    {
+      REQUIRE(std::size(skipped.stats) == std::size(polled.stats));
+      for (std::size_t i = 0; i < std::size(polled.stats); ++i) {
+        const auto& lhs = skipped.stats.at(i);
+        const auto& rhs = polled.stats.at(i);
+        CHECK(lhs.dbus_cycle_congested == rhs.dbus_cycle_congested);
+        CHECK(lhs.dbus_count_congested == rhs.dbus_count_congested);
+        CHECK(lhs.refresh_cycles == rhs.refresh_cycles);
+        CHECK(lhs.WQ_ROW_BUFFER_HIT == rhs.WQ_ROW_BUFFER_HIT);
+        CHECK(lhs.WQ_ROW_BUFFER_MISS == rhs.WQ_ROW_BUFFER_MISS);
+        CHECK(lhs.RQ_ROW_BUFFER_HIT == rhs.RQ_ROW_BUFFER_HIT);
+        CHECK(lhs.RQ_ROW_BUFFER_MISS == rhs.RQ_ROW_BUFFER_MISS);
+        CHECK(lhs.WQ_FULL == rhs.WQ_FULL);
+        CHECK(lhs.read_latency.count() == rhs.read_latency.count());
+        CHECK(lhs.read_latency.sum() == rhs.read_latency.sum());
+      }
+    }
+  }
+}
+
+SCENARIO("The memory controller's own host time excludes its channels without going negative")
+{
+  GIVEN("A memory controller that skips idle channel cycles and rarely receives a request")
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    MEMORY_CONTROLLER uut{champsim::chrono::picoseconds{1000},
+                          champsim::chrono::picoseconds{2000},
+                          std::size_t{2},
+                          std::size_t{2},
+                          std::size_t{4},
+                          std::size_t{4},
+                          champsim::chrono::microseconds{64},
+                          {&ul},
+                          8,
+                          8,
+                          2,
+                          champsim::data::bytes{8},
+                          65536,
+                          128,
+                          1,
+                          2,
+                          2,
+                          8};
+    uut.set_idle_skipping(true);
+    uut.warmup = false;
+    uut.begin_phase();
+
+    auto& counters = champsim::perf_counter_group::instance();
+    const bool counters_were_open = counters.is_open();
+    if (!counters_were_open) {
+      counters.open();
+    }
+
+    std::mt19937_64 rng{};
+    for (int cycle = 0; cycle < 200000; ++cycle) {
+      if (cycle % 4096 == 0) {
+        champsim::channel::request_type pkt;
+        pkt.address = champsim::address{rng() & 0xffc0};
+        ul.add_rq(pkt);
+      }
+      uut._operate();
+      ul.returned.clear();
+    }
+
+    if (!counters_were_open) {
+      counters.close();
+    }
+
+    WHEN("The controller's own time is estimated")
+    {
+      std::vector<champsim::host_time_sampler> channel_samplers{};
+      for (const auto& chan : uut.channels) {
+        channel_samplers.push_back(chan.host_time);
+      }
+      auto own = champsim::exclusive_host_profile("DRAM", uut.host_time, std::cbegin(channel_samplers), std::cend(channel_samplers));
+
+      THEN("The channels were operated on fewer cycles than the controller")
+      {
+        for (const auto& sampler : channel_samplers) {
+          REQUIRE(sampler.calls < uut.host_time.calls);
+        }
+      }
+
+      THEN("The time is not negative and is no more than the controller's")
+      {
+        REQUIRE(own.time.count() >= 0);
+        REQUIRE(own.time <= uut.host_time.estimate());
+      }
+
+      THEN("The counters do not wrap")
+      {
+        auto total = uut.host_time.estimate_counts();
+        REQUIRE(own.counters.cycles <= total.cycles);
+        REQUIRE(own.counters.instructions <= total.instructions);
+        REQUIRE(own.counters.llc_misses <= total.llc_misses);
+        REQUIRE(own.counters.branch_misses <= total.branch_misses);
+      }
+    }
+  }
+}
@@ -0,0 +1,191 @@
+#include <catch.hpp>
+#include <sstream>
+
+#include "dram_controller.h"
+#include "dram_replay.h"
+
+TEST_CASE("DRAM request records survive a round trip through a stream")
+{
+  std::vector<champsim::dram_request_record> records{{champsim::chrono::picoseconds{0}, false, champsim::address{0xdeadbeef}},
+                                                     {champsim::chrono::picoseconds{625}, true, champsim::address{0xcafebabe}}};
+
+  std::stringstream stream;
+  for (const auto& record : records) {
+    champsim::write_dram_record(stream, record);
+  }
+
+  auto result = champsim::read_dram_records(stream);
+  REQUIRE(std::size(result) == std::size(records));
+  for (std::size_t i = 0; i < std::size(records); ++i) {
+    CHECK(result.at(i).arrival == records.at(i).arrival);
+    CHECK(result.at(i).is_write == records.at(i).is_write);
+    CHECK(result.at(i).address == records.at(i).address);
+  }
+}
+
+TEST_CASE("A DRAM capture records its block size")
+{
+  std::stringstream stream;
+  champsim::write_dram_capture_header(stream, 128);
+  champsim::write_dram_record(stream, {champsim::chrono::picoseconds{0}, false, champsim::address{0xdeadbeef}});
+
+  auto result = champsim::read_dram_capture(stream);
+  CHECK(result.block_size == 128);
+  CHECK(std::size(result.records) == 1);
+}
+
+TEST_CASE("A DRAM replay with a different block size is rejected")
+{
+  champsim::dram_replay_config config;
+  config.block_size = 2 * BLOCK_SIZE;
+  REQUIRE_THROWS_AS(champsim::replay_dram({}, config, {}), std::invalid_argument);
+}
+
+TEST_CASE("A malformed DRAM request record is rejected")
+{
+  std::stringstream stream{"100 X 0x40\n"};
+  REQUIRE_THROWS_AS(champsim::read_dram_records(stream), std::invalid_argument);
+}
+
+SCENARIO("The memory controller captures the requests it accepts")
+{
+  GIVEN("A memory controller with a capture stream")
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    MEMORY_CONTROLLER uut{champsim::chrono::picoseconds{3200},
+                          champsim::chrono::picoseconds{6400},
+                          std::size_t{18},
+                          std::size_t{18},
+                          std::size_t{18},
+                          std::size_t{38},
+                          champsim::chrono::microseconds{64000},
+                          {&ul},
+                          64,
+                          64,
+                          1,
+                          champsim::data::bytes{8},
+                          65536,
+                          1024,
+                          1,
+                          8,
+                          4,
+                          8192};
+    std::stringstream capture;
+    uut.set_capture(&capture);
+    uut.warmup = false;
+
+    WHEN("A read and a write are sent to the controller")
+    {
+      champsim::channel::request_type read;
+      read.address = champsim::address{0xdeadbeef};
+      ul.add_rq(read);
+
+      champsim::channel::request_type write;
+      write.address = champsim::address{0xcafebabe};
+      write.response_requested = false;
+      ul.add_wq(write);
+
+      uut._operate();
+
+      THEN("Both requests are recorded at the controller's time")
+      {
+        auto [block_size, records] = champsim::read_dram_capture(capture);
+        CHECK(block_size == BLOCK_SIZE);
+        REQUIRE(std::size(records) == 2);
+        CHECK(records.front().address == read.address);
+        CHECK_FALSE(records.front().is_write);
+        CHECK(records.back().address == write.address);
+        CHECK(records.back().is_write);
+        CHECK(records.front().arrival == uut.current_time.time_since_epoch());
+      }
+    }
+
+    WHEN("A request is sent to the controller during warmup")
+    {
+      uut.warmup = true;
+      champsim::channel::request_type read;
+      read.address = champsim::address{0xdeadbeef};
+      ul.add_rq(read);
+
+      uut._operate();
+
+      THEN("The request is not recorded") { REQUIRE(std::empty(champsim::read_dram_records(capture))); }
+    }
+  }
+}
+
+SCENARIO("A captured request stream can be replayed")
+{
+  GIVEN("A stream of reads and writes")
+  {
+    std::vector<champsim::dram_request_record> records;
+    for (uint64_t i = 0; i < 64; ++i) {
+      records.push_back({champsim::chrono::picoseconds{static_cast<long>(i) * 1250}, (i % 4) == 3, champsim::address{i * 0x1040}});
+    }
+
+    WHEN("The stream is replayed open-loop")
+    {
+      auto result = champsim::replay_dram(records, {}, {});
+
+      THEN("Every request is accounted for")
+      {
+        CHECK(result.reads == 48);
+        CHECK(result.writes == 16);
+        CHECK(result.p50_latency > champsim::chrono::picoseconds{});
+        CHECK(result.p50_latency <= result.p99_latency);
+        CHECK(result.p99_latency <= result.max_latency);
+        CHECK(result.bandwidth_gbps() > 0);
+      }
+
+      AND_WHEN("The stream is replayed closed-loop with one outstanding read")
+      {
+        champsim::dram_replay_options options;
+        options.closed_loop = true;
+        options.max_outstanding = 1;
+        auto closed_result = champsim::replay_dram(records, {}, options);
+
+        THEN("The replay takes longer")
+        {
+          CHECK(closed_result.reads == result.reads);
+          CHECK(closed_result.elapsed > result.elapsed);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A read that waits for the memory controller is timed from when it was offered")
+{
+  GIVEN("A memory controller with room for one read, and two reads to the same block")
+  {
+    std::vector<champsim::dram_request_record> records{{champsim::chrono::picoseconds{0}, false, champsim::address{0x1000}},
+                                                       {champsim::chrono::picoseconds{0}, false, champsim::address{0x1000}}};
+    champsim::dram_replay_config config;
+    config.rq_size = 1;
+
+    WHEN("The stream is replayed")
+    {
+      auto result = champsim::replay_dram(records, config, {});
+
+      THEN("The second read is not completed by the first read's response")
+      {
+        CHECK(result.reads == 2);
+        CHECK(result.max_latency > result.p50_latency);
+      }
+    }
+
+    WHEN("The stream is replayed closed-loop with both reads in flight")
+    {
+      champsim::dram_replay_options options;
+      options.closed_loop = true;
+      options.max_outstanding = 2;
+      auto result = champsim::replay_dram(records, config, options);
+
+      THEN("The second read is not completed by the first read's response")
+      {
+        CHECK(result.reads == 2);
+        CHECK(result.max_latency > result.p50_latency);
+      }
+    }
+  }
+}
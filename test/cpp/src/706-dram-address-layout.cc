@@ -0,0 +1,216 @@
+#include <catch.hpp>
+#include <random>
+#include <vector>
+
+#include "dram_controller.h"
+
+namespace
+{
+// The decode as performed with the extent slicer, which the layout must reproduce
+struct sliced_fields {
+  unsigned long channel, rank, bankgroup, bank, row, column;
+};
+
+sliced_fields slice_reference(const DRAM_ADDRESS_MAPPING& mapping, champsim::address address)
+{
+  const auto& slicer = mapping.address_slicer;
+  auto fields = slicer(address);
+  unsigned long c_bits = champsim::size(get<DRAM_ADDRESS_MAPPING::SLICER_CHANNEL_IDX>(slicer));
+  unsigned long bg_bits = champsim::size(get<DRAM_ADDRESS_MAPPING::SLICER_BANKGROUP_IDX>(slicer));
+  unsigned long bk_bits = champsim::size(get<DRAM_ADDRESS_MAPPING::SLICER_BANK_IDX>(slicer));
+
+  sliced_fields result{};
+  result.channel = mapping.swizzle_bits(address, 1, champsim::data::bits{0},
+                                        std::get<DRAM_ADDRESS_MAPPING::SLICER_CHANNEL_IDX>(fields).to<unsigned long>(), c_bits);
+  result.bankgroup = mapping.swizzle_bits(address, bg_bits + bk_bits, champsim::data::bits{0},
+                                          std::get<DRAM_ADDRESS_MAPPING::SLICER_BANKGROUP_IDX>(fields).to<unsigned long>(), bg_bits);
+  result.bank = mapping.swizzle_bits(address, bg_bits + bk_bits, champsim::data::bits{bg_bits},
+                                     std::get<DRAM_ADDRESS_MAPPING::SLICER_BANK_IDX>(fields).to<unsigned long>(), bk_bits);
+  result.rank = std::get<DRAM_ADDRESS_MAPPING::SLICER_RANK_IDX>(fields).to<unsigned long>();
+  result.row = std::get<DRAM_ADDRESS_MAPPING::SLICER_ROW_IDX>(fields).to<unsigned long>();
+  result.column = std::get<DRAM_ADDRESS_MAPPING::SLICER_COLUMN_IDX>(fields).to<unsigned long>();
+  return result;
+}
+
+template <std::size_t CHANNELS, std::size_t BANKGROUPS, std::size_t BANKS, std::size_t COLUMNS, std::size_t RANKS, std::size_t ROWS>
+void check_static_layout()
+{
+  using static_type = champsim::static_dram_address_mapping<8, 8, CHANNELS, BANKGROUPS, BANKS, COLUMNS, RANKS, ROWS>;
+  auto uut = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, 8, CHANNELS, BANKGROUPS, BANKS, COLUMNS, RANKS, ROWS);
+  REQUIRE(static_type::layout == DRAM_ADDRESS_MAPPING::make_layout(uut.address_slicer));
+
+  std::mt19937_64 rng{CHANNELS * BANKGROUPS * BANKS * RANKS * COLUMNS * ROWS};
+  for (int i = 0; i < 256; ++i) {
+    champsim::address addr{rng()};
+    auto expected = slice_reference(uut, addr);
+
+    INFO("address: " << addr.to<uint64_t>());
+    CHECK(static_type::channel(addr.to<uint64_t>()) == expected.channel);
+    CHECK(static_type::rank(addr.to<uint64_t>()) == expected.rank);
+    CHECK(static_type::bankgroup(addr.to<uint64_t>()) == expected.bankgroup);
+    CHECK(static_type::bank(addr.to<uint64_t>()) == expected.bank);
+    CHECK(static_type::row(addr.to<uint64_t>()) == expected.row);
+    CHECK(static_type::column(addr.to<uint64_t>()) == expected.column);
+  }
+}
+} // namespace
+
+TEST_CASE("The DRAM address layout decodes the same fields as the slicer")
+{
+  auto channels = GENERATE(as<std::size_t>{}, 1, 2, 8);
+  auto bankgroups = GENERATE(as<std::size_t>{}, 1, 2, 8);
+  auto banks = GENERATE(as<std::size_t>{}, 2, 4);
+  auto ranks = GENERATE(as<std::size_t>{}, 1, 4);
+  auto columns = GENERATE(as<std::size_t>{}, 128, 1024);
+  auto rows = GENERATE(as<std::size_t>{}, 2, 1024, 65536, 1ull << 31);
+  auto uut = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, 8, channels, bankgroups, banks, columns, ranks, rows);
+
+  std::mt19937_64 rng{channels * bankgroups * banks * ranks * columns * rows};
+  for (int i = 0; i < 256; ++i) {
+    champsim::address addr{rng()};
+    auto expected = slice_reference(uut, addr);
+
+    INFO("address: " << addr.to<uint64_t>());
+    CHECK(uut.get_channel(addr) == expected.channel);
+    CHECK(uut.get_rank(addr) == expected.rank);
+    CHECK(uut.get_bankgroup(addr) == expected.bankgroup);
+    CHECK(uut.get_bank(addr) == expected.bank);
+    CHECK(uut.get_row(addr) == expected.row);
+    CHECK(uut.get_column(addr) == expected.column);
+  }
+}
+
+TEST_CASE("The compile-time DRAM address layout decodes the same fields as the slicer")
+{
+  using static_type = champsim::static_dram_address_mapping<8, 8, 2, 8, 4, 1024, 1, 65536>;
+  STATIC_REQUIRE(static_type::layout.fields.at(champsim::dram_address_layout::OFFSET_IDX).width == 6);
+  STATIC_REQUIRE(static_type::layout.fields.at(champsim::dram_address_layout::CHANNEL_IDX).width == 1);
+  STATIC_REQUIRE(static_type::layout.fields.at(champsim::dram_address_layout::ROW_IDX).width == 16);
+
+  check_static_layout<2, 8, 4, 1024, 1, 65536>();
+  check_static_layout<1, 1, 2, 128, 1, 2>();
+  check_static_layout<8, 2, 4, 128, 4, 1024>();
+  check_static_layout<8, 8, 2, 1024, 4, (1ull << 31)>();
+}
+
+TEST_CASE("A memory controller given the compile-time decoder decodes like one that computes it")
+{
+  using static_type = champsim::static_dram_address_mapping<8, 64 / 8, 2, 8, 4, 1024, 1, 65536>;
+  MEMORY_CONTROLLER runtime{champsim::chrono::picoseconds{3200},
+                            champsim::chrono::picoseconds{6400},
+                            24,
+                            24,
+                            24,
+                            52,
+                            champsim::chrono::microseconds{32000},
+                            {},
+                            64,
+                            64,
+                            2,
+                            champsim::data::bytes{8},
+                            65536,
+                            1024,
+                            1,
+                            8,
+                            4,
+                            8192};
+  MEMORY_CONTROLLER precomputed{champsim::chrono::picoseconds{3200},
+                                champsim::chrono::picoseconds{6400},
+                                24,
+                                24,
+                                24,
+                                52,
+                                champsim::chrono::microseconds{32000},
+                                {},
+                                64,
+                                64,
+                                2,
+                                champsim::data::bytes{8},
+                                65536,
+                                1024,
+                                1,
+                                8,
+                                4,
+                                8192,
+                                static_type::decoder};
+
+  const auto& precomputed_mapping = precomputed.channels.at(0).address_mapping;
+  const auto& runtime_mapping = runtime.channels.at(0).address_mapping;
+  REQUIRE(precomputed_mapping.decoder.layout == runtime_mapping.decoder.layout);
+  REQUIRE(precomputed_mapping.decoder.function == &static_type::decode);
+  REQUIRE(runtime_mapping.decoder.function == &champsim::dram_address_decoder::decode_runtime);
+
+  std::mt19937_64 rng{};
+  for (int i = 0; i < 256; ++i) {
+    champsim::address addr{rng()};
+    INFO("address: " << addr.to<uint64_t>());
+    CHECK(precomputed_mapping.get_channel(addr) == runtime_mapping.get_channel(addr));
+    CHECK(precomputed_mapping.get_rank(addr) == runtime_mapping.get_rank(addr));
+    CHECK(precomputed_mapping.get_bankgroup(addr) == runtime_mapping.get_bankgroup(addr));
+    CHECK(precomputed_mapping.get_bank(addr) == runtime_mapping.get_bank(addr));
+    CHECK(precomputed_mapping.get_row(addr) == runtime_mapping.get_row(addr));
+    CHECK(precomputed_mapping.get_column(addr) == runtime_mapping.get_column(addr));
+  }
+}
+
+TEST_CASE("DRAM address decode benchmark", "[.][bench]")
+{
+  auto uut = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, 8, 2, 8, 4, 1024, 1, 65536);
+  std::mt19937_64 rng{};
+  std::vector<champsim::address> addresses{};
+  for (int i = 0; i < 1024; ++i) {
+    addresses.emplace_back(rng());
+  }
+
+  BENCHMARK("Decoding with the slicer")
+  {
+    unsigned long result{};
+    for (auto addr : addresses) {
+      auto fields = slice_reference(uut, addr);
+      result ^= fields.channel ^ fields.bankgroup ^ fields.bank ^ fields.row ^ fields.column;
+    }
+    return result;
+  };
+
+  BENCHMARK("Decoding with the runtime layout")
+  {
+    unsigned long result{};
+    for (auto addr : addresses) {
+      result ^= uut.get_channel(addr) ^ uut.get_bankgroup(addr) ^ uut.get_bank(addr) ^ uut.get_row(addr) ^ uut.get_column(addr);
+    }
+    return result;
+  };
+
+  BENCHMARK("Decoding with the runtime decoder")
+  {
+    unsigned long result{};
+    for (auto addr : addresses) {
+      auto fields = uut.decode(addr);
+      result ^= fields.channel ^ fields.bankgroup ^ fields.bank ^ fields.row ^ fields.column;
+    }
+    return result;
+  };
+
+  auto static_uut = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, 8, 2, 8, 4, 1024, 1, 65536,
+                                         champsim::static_dram_address_mapping<8, 8, 2, 8, 4, 1024, 1, 65536>::decoder);
+  BENCHMARK("Decoding with the compile-time decoder")
+  {
+    unsigned long result{};
+    for (auto addr : addresses) {
+      auto fields = static_uut.decode(addr);
+      result ^= fields.channel ^ fields.bankgroup ^ fields.bank ^ fields.row ^ fields.column;
+    }
+    return result;
+  };
+
+  BENCHMARK("Decoding with the compile-time layout")
+  {
+    using static_type = champsim::static_dram_address_mapping<8, 8, 2, 8, 4, 1024, 1, 65536>;
+    unsigned long result{};
+    for (auto addr : addresses) {
+      auto raw = addr.to<uint64_t>();
+      result ^= static_type::channel(raw) ^ static_type::bankgroup(raw) ^ static_type::bank(raw) ^ static_type::row(raw) ^ static_type::column(raw);
+    }
+    return result;
+  };
+}
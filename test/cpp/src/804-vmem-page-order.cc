@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <catch.hpp>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include "dram_controller.h"
+#include "util/permutation.h"
+#include "vmem.h"
+
+TEST_CASE("A keyed permutation visits every element exactly once")
+{
+  auto size = GENERATE(as<uint64_t>{}, 1, 2, 3, 17, 1000, 4096, 65537);
+  auto seed = GENERATE(as<uint64_t>{}, 0, 1, 0xdeadbeef);
+  champsim::keyed_permutation uut{size, seed};
+
+  std::vector<uint64_t> seen{};
+  for (uint64_t i = 0; i < size; ++i) {
+    seen.push_back(uut(i));
+  }
+  std::sort(std::begin(seen), std::end(seen));
+
+  std::vector<uint64_t> expected(size);
+  std::iota(std::begin(expected), std::end(expected), 0);
+  REQUIRE(seen == expected);
+}
+
+TEST_CASE("A keyed permutation depends only on its seed")
+{
+  champsim::keyed_permutation a{100000, 1};
+  champsim::keyed_permutation b{100000, 1};
+  champsim::keyed_permutation c{100000, 2};
+
+  std::vector<uint64_t> a_seq, b_seq, c_seq;
+  for (uint64_t i = 0; i < 64; ++i) {
+    a_seq.push_back(a(i));
+    b_seq.push_back(b(i));
+    c_seq.push_back(c(i));
+  }
+
+  CHECK(a_seq == b_seq);
+  CHECK(a_seq != c_seq);
+}
+
+SCENARIO("The virtual memory assigns physical pages in a reproducible order")
+{
+  GIVEN("Two virtual memories with the same seed")
+  {
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+    VirtualMemory uut_a{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, 42};
+    VirtualMemory uut_b{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, 42};
+    VirtualMemory uut_unshuffled{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram};
+    auto original_size = uut_a.available_ppages();
+
+    WHEN("Each translates the same pages")
+    {
+      std::vector<champsim::page_number> pages_a, pages_b, pages_unshuffled;
+      for (uint64_t i = 0; i < 256; ++i) {
+        pages_a.push_back(uut_a.va_to_pa(0, champsim::page_number{i}).first);
+        pages_b.push_back(uut_b.va_to_pa(0, champsim::page_number{i}).first);
+        pages_unshuffled.push_back(uut_unshuffled.va_to_pa(0, champsim::page_number{i}).first);
+      }
+
+      THEN("The assignments are the same") { REQUIRE(pages_a == pages_b); }
+
+      THEN("The assignments are distinct")
+      {
+        std::set<champsim::page_number> unique{std::begin(pages_a), std::end(pages_a)};
+        REQUIRE(std::size(unique) == std::size(pages_a));
+      }
+
+      THEN("The assignments are shuffled") { REQUIRE(pages_a != pages_unshuffled); }
+
+      THEN("The pages are removed from the available pages") { REQUIRE(uut_a.available_ppages() == original_size - 256); }
+    }
+  }
+}
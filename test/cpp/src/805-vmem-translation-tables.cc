@@ -0,0 +1,152 @@
+#include <catch.hpp>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "dram_controller.h"
+#include "util/open_addressing_map.h"
+#include "vmem.h"
+
+TEST_CASE("An open addressing map keeps the first value inserted for a key")
+{
+  champsim::open_addressing_map uut{4};
+
+  auto [first, first_inserted] = uut.try_emplace(0xdead, 1);
+  CHECK(first_inserted);
+  CHECK(first == 1);
+
+  auto [second, second_inserted] = uut.try_emplace(0xdead, 2);
+  CHECK_FALSE(second_inserted);
+  CHECK(second == 1);
+  CHECK(uut.size() == 1);
+}
+
+TEST_CASE("An open addressing map makes a value only when it inserts one")
+{
+  champsim::open_addressing_map uut{4};
+  int calls = 0;
+  auto make_value = [&calls] {
+    ++calls;
+    return uint64_t{1};
+  };
+
+  auto [first, first_inserted] = uut.try_emplace_with(0xdead, make_value);
+  CHECK(first_inserted);
+  CHECK(first == 1);
+  CHECK(calls == 1);
+
+  auto [second, second_inserted] = uut.try_emplace_with(0xdead, make_value);
+  CHECK_FALSE(second_inserted);
+  CHECK(second == 1);
+  CHECK(calls == 1);
+}
+
+TEST_CASE("An open addressing map keeps its entries when it grows")
+{
+  champsim::open_addressing_map uut{4};
+  std::mt19937_64 rng{};
+  std::vector<uint64_t> keys{};
+  for (uint64_t i = 0; i < 10000; ++i) {
+    keys.push_back(rng() >> 1);
+    uut.try_emplace(keys.back(), i);
+  }
+
+  REQUIRE(uut.capacity() >= 2 * uut.size());
+  for (uint64_t i = 0; i < std::size(keys); ++i) {
+    auto found = uut.find(keys.at(i));
+    REQUIRE(found != nullptr);
+    CHECK(*found == i);
+  }
+  CHECK(uut.find(0xdeadbeef) == nullptr);
+}
+
+SCENARIO("The virtual memory keeps separate translations for each address space")
+{
+  GIVEN("A virtual memory")
+  {
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+    VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram};
+    const champsim::page_number vpage{0xdeadbeef};
+
+    WHEN("Two address spaces translate the same page")
+    {
+      auto [ppage_a, delay_a] = uut.va_to_pa(0, vpage);
+      auto [ppage_b, delay_b] = uut.va_to_pa(3, vpage);
+
+      THEN("Both fault") { REQUIRE((delay_a > champsim::chrono::clock::duration::zero() && delay_b > champsim::chrono::clock::duration::zero())); }
+
+      THEN("They receive different pages") { REQUIRE(ppage_a != ppage_b); }
+
+      AND_WHEN("The first address space translates the page again")
+      {
+        auto [ppage_again, delay_again] = uut.va_to_pa(0, vpage);
+
+        THEN("The translation does not fault") { REQUIRE(delay_again == champsim::chrono::clock::duration::zero()); }
+
+        THEN("The translation is unchanged") { REQUIRE(ppage_again == ppage_a); }
+      }
+    }
+
+    WHEN("Two pages that share an upper-level page table entry are walked")
+    {
+      auto [pte_a, delay_a] = uut.get_pte_pa(0, vpage, 3);
+      auto [pte_b, delay_b] = uut.get_pte_pa(0, vpage + 1, 3);
+
+      THEN("The second walk does not fault") { REQUIRE(delay_b == champsim::chrono::clock::duration::zero()); }
+
+      THEN("The walks read the same entry") { REQUIRE(pte_a == pte_b); }
+    }
+  }
+}
+
+TEST_CASE("Translation table benchmark", "[.][bench]")
+{
+  std::mt19937_64 rng{};
+  std::vector<uint64_t> vpages{};
+  for (int i = 0; i < 16384; ++i) {
+    vpages.push_back(rng() >> 28);
+  }
+
+  BENCHMARK("Translating with a std::map")
+  {
+    std::map<std::pair<uint32_t, uint64_t>, uint64_t> table{};
+    uint64_t next{};
+    for (auto vpage : vpages) {
+      next += table.try_emplace({0, vpage}, next).second ? 1 : 0;
+    }
+    for (auto vpage : vpages) {
+      next += table.find({0, vpage})->second;
+    }
+    return next;
+  };
+
+  BENCHMARK("Translating with an open addressing map")
+  {
+    champsim::open_addressing_map table{};
+    uint64_t next{};
+    for (auto vpage : vpages) {
+      next += table.try_emplace(vpage, next).second ? 1 : 0;
+    }
+    for (auto vpage : vpages) {
+      next += *table.find(vpage);
+    }
+    return next;
+  };
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <array>
+#include <catch.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "mocks.hpp"
+#include "ptw.h"
+#include "vmem.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_dram(std::size_t rows = 1024)
+{
+  return MEMORY_CONTROLLER{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           rows,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+}
+
+champsim::large_page_policy policy_of(champsim::data::bytes size)
+{
+  champsim::large_page_policy policy{};
+  policy.page_size = size;
+  return policy;
+}
+} // namespace
+
+SCENARIO("The virtual memory can back regions with large pages")
+{
+  GIVEN("A virtual memory with 2 MiB pages")
+  {
+    auto dram = make_dram();
+    VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, {}, policy_of(champsim::data::bytes{1 << 21})};
+    const champsim::page_number vpage{0x12345};
+
+    THEN("Translations end at the first level") { REQUIRE(uut.leaf_level(0, vpage) == 1); }
+
+    WHEN("Two pages in the same region are translated")
+    {
+      auto [ppage_a, delay_a] = uut.va_to_pa(0, vpage);
+      auto [ppage_b, delay_b] = uut.va_to_pa(0, vpage + 1);
+
+      THEN("Only the first faults")
+      {
+        CHECK(delay_a > champsim::chrono::clock::duration::zero());
+        CHECK(delay_b == champsim::chrono::clock::duration::zero());
+      }
+
+      THEN("The physical pages are contiguous") { REQUIRE(ppage_b == ppage_a + 1); }
+
+      THEN("The frame is aligned to the large page size") { REQUIRE((ppage_a.to<uint64_t>() - 0x145) % 512 == 0); }
+    }
+  }
+
+  GIVEN("A virtual memory with 1 GiB pages")
+  {
+    auto dram = make_dram(8192); // large enough to reserve a 1 GiB frame
+    VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, {}, policy_of(champsim::data::bytes{1 << 30})};
+
+    THEN("Translations end at the second level") { REQUIRE(uut.leaf_level(0, champsim::page_number{0x12345}) == 2); }
+  }
+
+  GIVEN("A large page size that does not match a page table level")
+  {
+    auto dram = make_dram();
+
+    THEN("The virtual memory cannot be constructed")
+    {
+      REQUIRE_THROWS_AS((VirtualMemory{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, {}, policy_of(champsim::data::bytes{1 << 20})}),
+                        std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("Large pages can be limited to some address spaces and ranges")
+{
+  GIVEN("A policy for one address space and one range")
+  {
+    auto dram = make_dram();
+    auto policy = policy_of(champsim::data::bytes{1 << 21});
+    policy.asids = {0};
+    policy.ranges = {{champsim::address{0x4000'0000}, champsim::address{0x8000'0000}}};
+    VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, {}, policy};
+
+    THEN("Pages in the range use large pages") { REQUIRE(uut.leaf_level(0, champsim::page_number{champsim::address{0x4010'0000}}) == 1); }
+
+    THEN("Pages outside the range use base pages") { REQUIRE(uut.leaf_level(0, champsim::page_number{champsim::address{0x8010'0000}}) == 0); }
+
+    THEN("Other address spaces use base pages") { REQUIRE(uut.leaf_level(1, champsim::page_number{champsim::address{0x4010'0000}}) == 0); }
+  }
+}
+
+SCENARIO("Regions are promoted to large pages after enough pages are touched")
+{
+  GIVEN("A policy with a promotion threshold of 4")
+  {
+    auto dram = make_dram();
+    auto policy = policy_of(champsim::data::bytes{1 << 21});
+    policy.promotion_threshold = 4;
+    VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, {}, policy};
+    const champsim::page_number vpage{0x12340};
+
+    WHEN("Three pages of a region are touched")
+    {
+      std::vector<champsim::page_number> base_pages{};
+      for (int i = 0; i < 3; ++i) {
+        base_pages.push_back(uut.va_to_pa(0, vpage + i).first);
+      }
+
+      THEN("The region uses base pages") { REQUIRE(uut.leaf_level(0, vpage + 4) == 0); }
+
+      AND_WHEN("A fourth page is touched")
+      {
+        auto fourth_page = uut.va_to_pa(0, vpage + 3).first;
+
+        THEN("The rest of the region uses a large page") { REQUIRE(uut.leaf_level(0, vpage + 4) == 1); }
+
+        THEN("Later translations are contiguous") { REQUIRE(uut.va_to_pa(0, vpage + 5).first == uut.va_to_pa(0, vpage + 4).first + 1); }
+
+        THEN("The pages translated before the promotion keep their physical pages")
+        {
+          for (int i = 0; i < 3; ++i) {
+            CHECK(uut.va_to_pa(0, vpage + i).first == base_pages.at(static_cast<std::size_t>(i)));
+            CHECK(uut.leaf_level(0, vpage + i) == 0);
+          }
+          CHECK(uut.va_to_pa(0, vpage + 3).first == fourth_page);
+          CHECK(uut.leaf_level(0, vpage + 3) == 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Large frames are set aside from physical memory")
+{
+  GIVEN("A randomized virtual memory with a promotion threshold of 4")
+  {
+    auto dram = make_dram();
+    auto policy = policy_of(champsim::data::bytes{1 << 21});
+    policy.asids = {0};
+    policy.promotion_threshold = 4;
+    VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, 1, policy};
+    const champsim::page_number vpage{0x12340};
+
+    WHEN("Many base pages are allocated before a region is promoted")
+    {
+      std::vector<champsim::page_number> base_pages{};
+      const auto num_base_pages = uut.available_ppages() / 4;
+      for (std::size_t i = 0; i < num_base_pages; ++i) {
+        base_pages.push_back(uut.va_to_pa(1, champsim::page_number{i}).first);
+      }
+      std::sort(std::begin(base_pages), std::end(base_pages));
+
+      for (int i = 0; i < 4; ++i) {
+        uut.va_to_pa(0, vpage + i);
+      }
+      REQUIRE(uut.leaf_level(0, vpage + 4) == 1);
+
+      THEN("The large frame holds none of the base pages")
+      {
+        const auto region_begin = champsim::page_number{(vpage.to<uint64_t>() / 512) * 512};
+        std::size_t shared_pages = 0;
+        for (int i = 0; i < 512; ++i) {
+          auto ppage = uut.va_to_pa(0, region_begin + i).first;
+          if (std::binary_search(std::begin(base_pages), std::end(base_pages), ppage)) {
+            ++shared_pages;
+          }
+        }
+        REQUIRE(shared_pages == 0);
+      }
+    }
+  }
+
+  GIVEN("A virtual memory that reserves one large page")
+  {
+    auto dram = make_dram();
+    auto policy = policy_of(champsim::data::bytes{1 << 21});
+    policy.reserved = champsim::data::bytes{1 << 21};
+    VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, {}, policy};
+    const champsim::page_number vpage{0x12345};
+    const champsim::page_number other_vpage{0x22345};
+
+    WHEN("One region is touched")
+    {
+      uut.va_to_pa(0, vpage);
+
+      THEN("It uses the large page") { REQUIRE(uut.leaf_level(0, vpage) == 1); }
+
+      THEN("Other regions use base pages")
+      {
+        REQUIRE(uut.leaf_level(0, other_vpage) == 0);
+        auto [ppage_a, delay_a] = uut.va_to_pa(0, other_vpage);
+        auto [ppage_b, delay_b] = uut.va_to_pa(0, other_vpage + 1);
+        CHECK(delay_a > champsim::chrono::clock::duration::zero());
+        CHECK(delay_b > champsim::chrono::clock::duration::zero());
+      }
+    }
+  }
+
+  GIVEN("A reservation as large as physical memory")
+  {
+    auto dram = make_dram();
+    auto policy = policy_of(champsim::data::bytes{1 << 21});
+    policy.reserved = champsim::data::bytes{dram.size()};
+
+    THEN("The virtual memory cannot be constructed")
+    {
+      REQUIRE_THROWS_AS((VirtualMemory{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, {}, policy}), std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("Walks for large pages end early")
+{
+  GIVEN("A 5-level virtual memory with 2 MiB pages")
+  {
+    constexpr std::size_t levels = 5;
+    auto dram = make_dram();
+    VirtualMemory vmem{champsim::data::bytes{1 << 12}, levels, champsim::chrono::nanoseconds{640}, dram, {}, policy_of(champsim::data::bytes{1 << 21})};
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    PageTableWalker uut{champsim::ptw_builder{champsim::defaults::default_ptw}
+                            .name("806-uut")
+                            .clock_period(champsim::chrono::picoseconds{3200})
+                            .upper_levels({&mock_ul.queues})
+                            .lower_level(&mock_ll.queues)
+                            .virtual_memory(&vmem)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ul, &uut, &mock_ll}};
+
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("The PTW receives a request")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.v_address = test.address;
+      test.cpu = 0;
+
+      auto test_result = mock_ul.issue(test);
+      REQUIRE(test_result);
+
+      for (auto i = 0; i < 10000; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The last level is not read")
+      {
+        REQUIRE(mock_ll.packet_count() == levels - 1);
+        REQUIRE(mock_ul.packets.back().return_time > 0);
+      }
+
+      THEN("The large page was mapped by the walk")
+      {
+        auto [ppage, delay] = vmem.va_to_pa(0, champsim::page_number{test.address});
+        REQUIRE(delay == champsim::chrono::clock::duration::zero());
+      }
+    }
+  }
+}
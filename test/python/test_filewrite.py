@@ -1,7 +1,9 @@
+import os
 import unittest
 import operator
 
 import config.filewrite
+import config.parse
 
 class FilesAreDifferentTests(unittest.TestCase):
     def test_identical(self):
@@ -76,3 +78,27 @@ class FragmentTests(unittest.TestCase):
         a_frag = config.filewrite.Fragment(a_parts)
         b_frag = config.filewrite.Fragment(b_parts)
         self.assertEqual(list(iter(config.filewrite.Fragment.join(a_frag, b_frag))), expected)
+
+class FragmentFromConfigTests(unittest.TestCase):
+    @staticmethod
+    def instantiation_dirs(frag):
+        return {os.path.dirname(fname) for fname,_ in frag if os.path.basename(fname).startswith('core_inst')}
+
+    def test_configurations_write_separate_instantiation_files(self):
+        a_frag = config.filewrite.Fragment.from_config(config.parse.parse_config({'executable_name': 'a', 'LLC': {'sets': 2048}}), objdir_name='obj')
+        b_frag = config.filewrite.Fragment.from_config(config.parse.parse_config({'executable_name': 'b', 'LLC': {'sets': 4096}}), objdir_name='obj')
+
+        a_dirs = self.instantiation_dirs(a_frag)
+        b_dirs = self.instantiation_dirs(b_frag)
+        self.assertEqual(len(a_dirs), 1)
+        self.assertEqual(len(b_dirs), 1)
+        self.assertNotEqual(a_dirs, b_dirs)
+        self.assertEqual(len(self.instantiation_dirs(config.filewrite.Fragment.join(a_frag, b_frag))), 2)
+
+    def test_instantiation_files_do_not_move_when_reconfigured(self):
+        parsed = config.parse.parse_config({'executable_name': 'a'})
+        self.assertEqual(parsed[2], sorted(parsed[2])) # The modules are listed in the same order by every process
+
+        first = config.filewrite.Fragment.from_config(parsed, objdir_name='obj')
+        second = config.filewrite.Fragment.from_config(config.parse.parse_config({'executable_name': 'a'}), objdir_name='obj')
+        self.assertEqual(self.instantiation_dirs(first), self.instantiation_dirs(second))
@@ -209,6 +209,10 @@ class PageTableWalkerBuilderTests(unittest.TestCase):
     def test_pscl5(self):
         self.get_element_diff(['.add_pscl(5, 1, 2)'], pscl5_set=1, pscl5_way=2)
 
+    def test_occupancy_stats(self):
+        self.get_element_diff(['.set_occupancy_stats()'], occupancy_stats=True)
+        self.get_element_diff(['.reset_occupancy_stats()'], occupancy_stats=False)
+
     def test_pscl4(self):
         self.get_element_diff(['.add_pscl(4, 1, 2)'], pscl4_set=1, pscl4_way=2)
 
@@ -304,3 +308,34 @@ class GetQueueInfoTests(unittest.TestCase):
             { 'is_good_boy': False }
         ]
         self.assertEqual(expected, evaluated)
+
+class GetRuntimeModuleRegistryTests(unittest.TestCase):
+    def test_modules_are_registered_by_directory_name(self):
+        given_modules = [
+            ('pref', { 'name': 'prefetcher_Dnext_line', 'path': 'prefetcher/next_line', 'class': 'next_line' }),
+            ('repl', { 'name': 'replacement_Dlru', 'path': 'replacement/lru', 'class': 'lru' })
+        ]
+        evaluated = list(config.instantiation_file.get_runtime_module_registry('env', given_modules))
+        self.assertIn('retval.add_prefetcher<class next_line>("next_line");', map(str.strip, evaluated))
+        self.assertIn('retval.add_replacement<class lru>("lru");', map(str.strip, evaluated))
+
+    def test_registry_is_absent_without_runtime_modules(self):
+        evaluated = list(config.instantiation_file.get_instantiation_header(1, 1, 1, { 'block_size': 64, 'page_size': 4096 }, build_id='abc'))
+        self.assertNotIn('runtime_modules', ''.join(evaluated))
+
+class GetOverriddenBuilderTests(unittest.TestCase):
+    def test_builder_is_wrapped_by_name(self):
+        evaluated = list(config.instantiation_file.get_overridden_builder('LLC', ['champsim::cache_builder{}', '.sets(64)']))
+        self.assertEqual(evaluated[0], 'overrides.apply("LLC",')
+        self.assertEqual(evaluated[-1].strip(), '.sets(64))')
+
+    def test_overridden_value_names_its_component(self):
+        self.assertEqual(config.instantiation_file.get_overridden_value('DRAM', 'tRP', 24), 'overrides.value("DRAM", "tRP", 24)')
+
+    def test_environment_takes_overrides(self):
+        evaluated = list(config.instantiation_file.get_instantiation_header(1, 1, 1, { 'block_size': 64, 'page_size': 4096 }, build_id='abc'))
+        self.assertIn('explicit generated_environment(const champsim::geometry_overrides& overrides = {});', map(str.strip, evaluated))
+
+    def test_environment_names_its_memory_controller(self):
+        evaluated = list(config.instantiation_file.get_instantiation_header(1, 1, 1, { 'block_size': 64, 'page_size': 4096 }, build_id='abc', dram_name='MEM'))
+        self.assertIn('constexpr static std::string_view dram_name{"MEM"};', map(str.strip, evaluated))
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""
+Summarize the benchmarks in a Catch2 XML report as JSON.
+
+Each benchmark names the number of items it processes per run in a trailing parenthetical, as in "lru_table::fill() (1024 fills)".
+The mean time per run is divided among those items to give the time per operation and the throughput.
+Benchmarks without a count are taken to process one item per run.
+"""
+
+import argparse
+import json
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+count_pattern = re.compile(r'\((\d+) [^)]*\)\s*$')
+
+def items_per_run(name):
+    match = count_pattern.search(name)
+    return int(match.group(1)) if match is not None else 1
+
+def summarize(root):
+    for test_case in root.iter('TestCase'):
+        for result in test_case.iter('BenchmarkResults'):
+            mean = result.find('mean')
+            stddev = result.find('standardDeviation')
+            items = items_per_run(result.get('name'))
+            mean_ns = float(mean.get('value'))
+            yield {
+                'test case': test_case.get('name'),
+                'name': result.get('name'),
+                'samples': int(result.get('samples')),
+                'iterations': int(result.get('iterations')),
+                'items per run': items,
+                'mean ns': mean_ns,
+                'mean ns lower bound': float(mean.get('lowerBound')),
+                'mean ns upper bound': float(mean.get('upperBound')),
+                'stddev ns': float(stddev.get('value')) if stddev is not None else None,
+                'ns/op': mean_ns / items,
+                'items/s': items * 1e9 / mean_ns if mean_ns > 0 else None
+            }
+
+def main():
+    parser = argparse.ArgumentParser(description='Summarize a Catch2 benchmark report')
+    parser.add_argument('report', help='The Catch2 XML report')
+    parser.add_argument('--json', default='-', help='The file to write the summary to. Defaults to stdout')
+    args = parser.parse_args()
+
+    results = list(summarize(ET.parse(args.report).getroot()))
+    for r in results:
+        print('{:<72} {:>12.2f} ns/op {:>14.4g} items/s'.format(r['name'], r['ns/op'], r['items/s'] or 0), file=sys.stderr)
+
+    if args.json == '-':
+        json.dump(results, sys.stdout, indent=2)
+        print()
+    else:
+        with open(args.json, 'wt') as wfp:
+            json.dump(results, wfp, indent=2)
+
+if __name__ == '__main__':
+    main()
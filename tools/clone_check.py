@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Check how well a statistical clone of a trace stands in for it.
+
+The trace is profiled with bin/workload_profiler over the region that the simulation covers, and a proxy trace is synthesized
+from the profile with `bin/trace_generator --clone`, shorter than the original by the given factor. Both are simulated with the
+same executable, the proxy over proportionally shorter warmup and simulation regions, and the cache MPKI, branch MPKI, and IPC
+of the two are reported along with the relative error of the proxy. The script fails if any error exceeds --max-error.
+"""
+
+import argparse
+import json
+import pathlib
+import subprocess
+import sys
+
+champsim_root = pathlib.Path(__file__).resolve().parent.parent
+
+def metrics(json_file, caches):
+    ''' The MPKI and IPC of the first core over the simulation phases of a run '''
+    with open(json_file) as rfp:
+        phases = [p['roi'] for p in json.load(rfp) if p['name'].startswith('Simulation')]
+
+    instructions = sum(p['cores'][0]['instructions'] for p in phases)
+    cycles = sum(p['cores'][0]['cycles'] for p in phases)
+    per_kilo = lambda x: 1000 * x / instructions if instructions > 0 else 0
+
+    result = {'IPC': instructions / cycles if cycles > 0 else 0}
+    result['branch MPKI'] = per_kilo(sum(sum(p['cores'][0]['mispredict'].values()) for p in phases))
+    for cache in caches:
+        misses = sum(p[cache][kind]['miss'][0] for p in phases for kind in ('LOAD', 'RFO', 'WRITE', 'TRANSLATION'))
+        result[f'{cache} MPKI'] = per_kilo(misses)
+    return result
+
+def simulate(executable, trace, warmup, simulation, json_file, flags=()):
+    subprocess.run([str(executable), *flags,
+        '--warmup-instructions', str(warmup),
+        '--simulation-instructions', str(simulation),
+        '--hide-heartbeat', '--json', str(json_file),
+        str(trace)
+    ], stdout=subprocess.DEVNULL, check=True)
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare a trace against its statistical clone')
+    parser.add_argument('trace', help='The trace to clone')
+    parser.add_argument('--executable', default=str(champsim_root / 'bin' / 'champsim'), help='The single-core ChampSim executable to compare with')
+    parser.add_argument('--work-dir', default='.', help='The directory to write the profile, proxy trace, and statistics into')
+    parser.add_argument('--reduction', type=int, default=10, help='How many times shorter the proxy is than the simulated region of the trace')
+    parser.add_argument('--warmup-instructions', type=int, default=10000000)
+    parser.add_argument('--simulation-instructions', type=int, default=100000000)
+    parser.add_argument('--seed', type=int, default=0, help='The seed of the proxy trace')
+    parser.add_argument('-c', '--cloudsuite', action='store_true', help='The trace is in the cloudsuite format')
+    parser.add_argument('--caches', nargs='+', default=['cpu0_L1D', 'cpu0_L2C', 'LLC'], help='The caches to report MPKI for')
+    parser.add_argument('--max-error', type=float, help='Fail if the relative error of any metric exceeds this')
+    args = parser.parse_args()
+
+    work_dir = pathlib.Path(args.work_dir)
+    work_dir.mkdir(parents=True, exist_ok=True)
+    stem = pathlib.Path(args.trace).name.split('.')[0]
+    profile = work_dir / f'{stem}.profile.json'
+    proxy = work_dir / f'{stem}.clone.champsimtrace.xz'
+
+    warmup, simulation = args.warmup_instructions, args.simulation_instructions
+    proxy_warmup, proxy_simulation = warmup // args.reduction, simulation // args.reduction
+    cloudsuite = ['--cloudsuite'] if args.cloudsuite else []
+
+    subprocess.run([str(champsim_root / 'bin' / 'workload_profiler'), *cloudsuite, '--length', str(warmup + simulation), args.trace, str(profile)], check=True)
+    subprocess.run([str(champsim_root / 'bin' / 'trace_generator'), '--clone', str(profile), '--seed', str(args.seed),
+        '--length', str(proxy_warmup + proxy_simulation), str(proxy)], check=True)
+
+    # The proxy is always written in the standard format
+    simulate(args.executable, args.trace, warmup, simulation, work_dir / f'{stem}.original.json', cloudsuite)
+    simulate(args.executable, proxy, proxy_warmup, proxy_simulation, work_dir / f'{stem}.clone.json')
+
+    original = metrics(work_dir / f'{stem}.original.json', args.caches)
+    clone = metrics(work_dir / f'{stem}.clone.json', args.caches)
+
+    failed = False
+    print(f'{"metric":<16} {"original":>10} {"clone":>10} {"error":>8}')
+    for name, value in original.items():
+        error = abs(clone[name] - value) / value if value > 0 else abs(clone[name])
+        failed = failed or (args.max_error is not None and error > args.max_error)
+        print(f'{name:<16} {value:>10.4f} {clone[name]:>10.4f} {error:>8.1%}')
+
+    with open(work_dir / f'{stem}.clone_check.json', 'wt') as wfp:
+        json.dump({'trace': args.trace, 'reduction': args.reduction, 'original': original, 'clone': clone}, wfp, indent=2)
+
+    if failed:
+        sys.exit(1)
+
+if __name__ == '__main__':
+    main()
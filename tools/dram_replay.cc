@@ -0,0 +1,187 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Replay a request stream captured with `champsim --dram-capture` against one or more memory controller configurations.
+ *
+ * The configuration file holds either a single object or a list of objects, with the same keys as the "physical_memory" section of a ChampSim
+ * configuration. A full ChampSim configuration may also be given, in which case its "physical_memory" section and its "block_size" are used.
+ *
+ * The replay is built for the default block and page sizes. Captures and configurations with another block size are rejected.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include "dram_replay.h"
+#include "util/bits.h" // for lg2
+
+const std::size_t NUM_CPUS = 1;
+const unsigned BLOCK_SIZE = 64;
+const unsigned PAGE_SIZE = 4096;
+const unsigned LOG2_BLOCK_SIZE = champsim::lg2(BLOCK_SIZE);
+const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
+
+namespace champsim
+{
+void from_json(const nlohmann::json& j, dram_replay_config& config)
+{
+  config.name = j.value("name", config.name);
+  config.data_rate = j.value("data_rate", config.data_rate);
+  config.frequency = j.value("frequency", config.data_rate / 2);
+  config.channels = j.value("channels", config.channels);
+  config.ranks = j.value("ranks", config.ranks);
+  config.bankgroups = j.value("bankgroups", config.bankgroups);
+  config.banks = j.value("banks", config.banks);
+  config.bank_rows = j.value("bank_rows", config.bank_rows);
+  config.bank_columns = j.value("bank_columns", config.bank_columns);
+  config.channel_width = j.value("channel_width", config.channel_width);
+  config.wq_size = j.value("wq_size", config.wq_size);
+  config.rq_size = j.value("rq_size", config.rq_size);
+  config.tRP = j.value("tRP", config.tRP);
+  config.tRCD = j.value("tRCD", config.tRCD);
+  config.tCAS = j.value("tCAS", config.tCAS);
+  config.tRAS = j.value("tRAS", config.tRAS);
+  config.refresh_period = j.value("refresh_period", config.refresh_period);
+  config.refreshes_per_period = j.value("refreshes_per_period", config.refreshes_per_period);
+  config.block_size = j.value("block_size", config.block_size);
+}
+
+void to_json(nlohmann::json& j, const dram_replay_result& result)
+{
+  auto to_ns = [](champsim::chrono::picoseconds x) { return std::chrono::duration<double, std::nano>{x}.count(); };
+
+  std::vector<nlohmann::json> channels;
+  std::transform(std::begin(result.channel_stats), std::end(result.channel_stats), std::back_inserter(channels), [](const dram_stats& stats) {
+    return nlohmann::json{{"RQ ROW_BUFFER_HIT", stats.RQ_ROW_BUFFER_HIT},   {"RQ ROW_BUFFER_MISS", stats.RQ_ROW_BUFFER_MISS},
+                          {"WQ ROW_BUFFER_HIT", stats.WQ_ROW_BUFFER_HIT},   {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
+                          {"WQ FULL", stats.WQ_FULL},                       {"REFRESHES", stats.refresh_cycles},
+                          {"DBUS_CONGESTED", stats.dbus_count_congested}};
+  });
+
+  j = nlohmann::json{{"name", result.name},
+                     {"reads", result.reads},
+                     {"writes", result.writes},
+                     {"elapsed_ns", to_ns(result.elapsed)},
+                     {"bandwidth_GBps", result.bandwidth_gbps()},
+                     {"read_latency_ns",
+                      {{"mean", to_ns(result.mean_latency)},
+                       {"p50", to_ns(result.p50_latency)},
+                       {"p95", to_ns(result.p95_latency)},
+                       {"p99", to_ns(result.p99_latency)},
+                       {"max", to_ns(result.max_latency)}}},
+                     {"channels", channels}};
+}
+} // namespace champsim
+
+int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
+{
+  CLI::App app{"Replay a captured DRAM request stream against memory controller configurations"};
+
+  std::string capture_name;
+  std::string config_name;
+  std::string json_file_name;
+  champsim::dram_replay_options options;
+  unsigned jobs = std::max(std::thread::hardware_concurrency(), 1u);
+
+  app.add_option("capture", capture_name, "The request stream written by --dram-capture")->required()->check(CLI::ExistingFile);
+  app.add_option("-c,--config", config_name, "A JSON file of memory controller configurations. If not specified, the defaults are used.")
+      ->check(CLI::ExistingFile);
+  app.add_flag("--closed-loop", options.closed_loop, "Pace requests by their recorded gaps and a limit on outstanding reads, rather than their arrival times");
+  app.add_option("--max-outstanding", options.max_outstanding, "The number of reads that may be in flight during closed-loop replay")
+      ->check(CLI::PositiveNumber);
+  app.add_option("-j,--jobs", jobs, "The number of configurations to replay in parallel")->check(CLI::PositiveNumber);
+  auto* json_option =
+      app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::vector<champsim::dram_replay_config> configs;
+  if (config_name.empty()) {
+    configs.emplace_back();
+  } else {
+    std::ifstream config_file{config_name};
+    auto config_json = nlohmann::json::parse(config_file);
+    if (config_json.is_object() && config_json.contains("physical_memory")) {
+      auto pmem_json = config_json.at("physical_memory");
+      if (config_json.contains("block_size") && pmem_json.is_object()) {
+        pmem_json["block_size"] = config_json.at("block_size");
+      }
+      config_json = pmem_json;
+    }
+
+    if (config_json.is_array()) {
+      configs = config_json.get<std::vector<champsim::dram_replay_config>>();
+    } else {
+      configs.push_back(config_json.get<champsim::dram_replay_config>());
+    }
+  }
+
+  for (const auto& config : configs) {
+    if (config.block_size != BLOCK_SIZE) {
+      fmt::print("ERROR: {} is configured with {} byte blocks, but dram_replay uses {} byte blocks\n", config.name, config.block_size, BLOCK_SIZE);
+      return 1;
+    }
+  }
+
+  std::ifstream capture_file{capture_name};
+  const auto capture = champsim::read_dram_capture(capture_file);
+  if (capture.block_size != 0 && capture.block_size != BLOCK_SIZE) {
+    fmt::print("ERROR: {} was captured with {} byte blocks, but dram_replay uses {} byte blocks\n", capture_name, capture.block_size, BLOCK_SIZE);
+    return 1;
+  }
+  const auto& records = capture.records;
+
+  // Each configuration has its own controller, so they are replayed independently
+  std::vector<champsim::dram_replay_result> results(std::size(configs));
+  std::atomic<std::size_t> next_config{0};
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < std::min<std::size_t>(jobs, std::size(configs)); ++i) {
+    workers.emplace_back([&]() {
+      for (auto idx = next_config++; idx < std::size(configs); idx = next_config++) {
+        results.at(idx) = champsim::replay_dram(records, configs.at(idx), options);
+      }
+    });
+  }
+  std::for_each(std::begin(workers), std::end(workers), [](auto& worker) { worker.join(); });
+
+  for (const auto& result : results) {
+    fmt::print("{} reads: {} writes: {} elapsed: {:.1f} ns bandwidth: {:.3f} GB/s\n", result.name, result.reads, result.writes,
+               std::chrono::duration<double, std::nano>{result.elapsed}.count(), result.bandwidth_gbps());
+    fmt::print("{} read latency (ns) mean: {:.1f} p50: {:.1f} p95: {:.1f} p99: {:.1f} max: {:.1f}\n", result.name,
+               std::chrono::duration<double, std::nano>{result.mean_latency}.count(), std::chrono::duration<double, std::nano>{result.p50_latency}.count(),
+               std::chrono::duration<double, std::nano>{result.p95_latency}.count(), std::chrono::duration<double, std::nano>{result.p99_latency}.count(),
+               std::chrono::duration<double, std::nano>{result.max_latency}.count());
+  }
+
+  if (json_option->count() > 0) {
+    if (json_file_name.empty()) {
+      std::cout << nlohmann::json(results).dump() << std::endl;
+    } else {
+      std::ofstream json_file{json_file_name};
+      json_file << nlohmann::json(results).dump() << std::endl;
+    }
+  }
+
+  return 0;
+}
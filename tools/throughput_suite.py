@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Measure end-to-end simulation throughput over a fixed set of configurations and synthetic traces.
+
+The traces are written by bin/trace_generator from the specifications in tools/trace_specs.
+Every combination of the RL action space is built for each core count in the suite, then run on each synthetic trace.
+For each run, the simulation speed (KIPS, from the host_profile of the simulation phases), the peak resident set size
+of the process, and the IPC of each core are recorded. When a baseline is given, the results are compared against it,
+and the script fails if any run is slower, uses more memory, or produces a different IPC, beyond the suite's tolerances.
+"""
+
+import argparse
+import copy
+import itertools
+import json
+import os
+import pathlib
+import subprocess
+import sys
+import time
+
+champsim_root = pathlib.Path(__file__).resolve().parent.parent
+trace_spec_dir = champsim_root / 'tools' / 'trace_specs'
+sys.path.insert(0, str(champsim_root))
+
+from rl_controller.action_space import load_action_space
+
+def set_path(config, path, value):
+    for key in path[:-1]:
+        config = config.setdefault(key, {})
+    config[path[-1]] = value
+
+def configurations(suite):
+    ''' Yield the name and configuration of each build in the suite '''
+    with open(champsim_root / suite['template_config']) as rfp:
+        template = json.load(rfp)
+    action_space, _, _ = load_action_space(champsim_root / suite['action_space'])
+    heads = list(action_space.heads.values())
+
+    for cores in suite['cores']:
+        for choices in itertools.product(*(head.choices for head in heads)):
+            name = '_'.join((f'{cores}core', *(f'{head.name}-{choice}' for head, choice in zip(heads, choices))))
+            config = copy.deepcopy(template)
+            config['num_cores'] = cores
+            config['executable_name'] = f'champsim_throughput_{name}'
+            for head, choice in zip(heads, choices):
+                set_path(config, head.path, choice)
+            yield name, config
+
+def build(configs, build_dir, jobs):
+    config_file = build_dir / 'configurations.json'
+    with open(config_file, 'wt') as wfp:
+        json.dump([config for _, config in configs], wfp, indent=2)
+    subprocess.run([str(champsim_root / 'config.sh'), str(config_file)], cwd=champsim_root, check=True)
+    subprocess.run(['make', f'-j{jobs}', 'all', 'trace_generator'], cwd=champsim_root, check=True)
+
+def traces(suite, build_dir):
+    ''' Write any synthetic traces that are not already present, and return their paths '''
+    result = {}
+    for pattern in suite['traces']:
+        fname = build_dir / f'{pattern}-{suite["trace_length"]}-{suite["trace_seed"]}.champsimtrace.xz'
+        if not fname.exists():
+            print('Writing trace', fname)
+            subprocess.run([str(champsim_root / 'bin' / 'trace_generator'),
+                '--spec', str(trace_spec_dir / f'{pattern}.json'),
+                '--length', str(suite['trace_length']),
+                '--seed', str(suite['trace_seed']),
+                str(fname)
+            ], check=True)
+        result[pattern] = fname
+    return result
+
+def run(executable, trace, cores, suite, json_file):
+    ''' Run one simulation and return its measurements '''
+    cmd = [str(executable),
+        '--warmup-instructions', str(suite['warmup_instructions']),
+        '--simulation-instructions', str(suite['simulation_instructions']),
+        '--hide-heartbeat', '--json', str(json_file),
+        *([str(trace)] * cores)
+    ]
+
+    start = time.monotonic()
+    with subprocess.Popen(cmd, stdout=subprocess.DEVNULL) as proc:
+        _, status, usage = os.wait4(proc.pid, 0)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+    wall = time.monotonic() - start
+    if proc.returncode != 0:
+        raise subprocess.CalledProcessError(proc.returncode, cmd)
+
+    with open(json_file) as rfp:
+        phases = [p for p in json.load(rfp) if p['name'].startswith('Simulation')]
+
+    elapsed = sum(p['host_profile']['elapsed seconds'] for p in phases)
+    instructions = [sum(p['sim']['cores'][i]['instructions'] for p in phases) for i in range(cores)]
+    cycles = [sum(p['sim']['cores'][i]['cycles'] for p in phases) for i in range(cores)]
+    return {
+        'KIPS': sum(p['host_profile']['KIPS'] * p['host_profile']['elapsed seconds'] for p in phases) / elapsed if elapsed > 0 else 0,
+        'peak RSS': usage.ru_maxrss, # kilobytes on Linux
+        'IPC': [i / c if c > 0 else 0 for i, c in zip(instructions, cycles)],
+        'wall seconds': wall
+    }
+
+def compare(baseline, results, tolerance):
+    ''' Yield a (failed, message) pair for each difference between the results and the baseline '''
+    for name, runs in results.items():
+        for trace, result in runs.items():
+            label = f'{name} {trace}'
+            base = baseline.get(name, {}).get(trace)
+            if base is None:
+                yield False, f'{label}: not in the baseline'
+                continue
+
+            change = result['KIPS'] / base['KIPS'] - 1 if base['KIPS'] > 0 else 0
+            yield change < -tolerance['KIPS'], f'{label}: KIPS {base["KIPS"]:.1f} -> {result["KIPS"]:.1f} ({change:+.1%})'
+
+            change = result['peak RSS'] / base['peak RSS'] - 1 if base['peak RSS'] > 0 else 0
+            if change > tolerance['peak RSS']:
+                yield True, f'{label}: peak RSS {base["peak RSS"]} kB -> {result["peak RSS"]} kB ({change:+.1%})'
+
+            for cpu, (old, new) in enumerate(zip(base['IPC'], result['IPC'])):
+                if abs(new - old) > tolerance['IPC'] * abs(old):
+                    yield True, f'{label}: CPU {cpu} IPC {old:.6f} -> {new:.6f}'
+
+    for name, runs in baseline.items():
+        for trace in runs:
+            if trace not in results.get(name, {}):
+                yield False, f'{name} {trace}: not run'
+
+def main():
+    parser = argparse.ArgumentParser(description='Measure end-to-end simulation throughput and compare it to a baseline')
+    parser.add_argument('--suite', default=str(champsim_root / 'tools' / 'throughput_suite.json'),
+            help='The suite description')
+    parser.add_argument('--build-dir', default=str(champsim_root / '_throughput'),
+            help='The directory to hold the generated configurations, traces, and per-run statistics')
+    parser.add_argument('--baseline', help='A previous result file to compare against')
+    parser.add_argument('--output', help='The file to write the results to. Defaults to throughput_results.json in the build directory')
+    parser.add_argument('--cores', type=int, action='append', help='Run only the configurations with this many cores')
+    parser.add_argument('--trace', action='append', choices=sorted(p.stem for p in trace_spec_dir.glob('*.json')), help='Run only this trace')
+    parser.add_argument('--no-build', action='store_false', dest='build', help='Use the executables from a previous build')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='The number of parallel build jobs')
+    args = parser.parse_args()
+
+    with open(args.suite) as rfp:
+        suite = json.load(rfp)
+    if args.cores:
+        suite['cores'] = [c for c in suite['cores'] if c in args.cores]
+    if args.trace:
+        suite['traces'] = [t for t in suite['traces'] if t in args.trace]
+
+    build_dir = pathlib.Path(args.build_dir).resolve()
+    build_dir.mkdir(parents=True, exist_ok=True)
+
+    configs = list(configurations(suite))
+    if args.build:
+        build(configs, build_dir, args.jobs)
+    trace_files = traces(suite, build_dir)
+
+    results = {}
+    for (name, config), (pattern, trace) in itertools.product(configs, trace_files.items()):
+        results.setdefault(name, {})[pattern] = result = run(champsim_root / 'bin' / config['executable_name'], trace, config['num_cores'], suite, build_dir / f'{name}_{pattern}.json')
+        print(f'{name:<56} {pattern:<14} {result["KIPS"]:>9.1f} KIPS {result["peak RSS"]:>9} kB IPC', ' '.join(f'{ipc:.4f}' for ipc in result['IPC']))
+
+    output = pathlib.Path(args.output) if args.output else build_dir / 'throughput_results.json'
+    with open(output, 'wt') as wfp:
+        json.dump({'suite': suite, 'host': os.uname().nodename, 'results': results}, wfp, indent=2)
+    print('Results written to', output)
+
+    if args.baseline:
+        with open(args.baseline) as rfp:
+            baseline = json.load(rfp)['results']
+        differences = list(compare(baseline, results, suite['tolerance']))
+        for failed, message in differences:
+            print('FAIL' if failed else '    ', message)
+        if any(failed for failed, _ in differences):
+            sys.exit(1)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,233 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Write a synthetic trace from a specification.
+ *
+ * The specification is a JSON object with the keys of champsim::trace_generator_spec. It may instead hold a list of "phases", each of which is such
+ * an object, and any other keys in the file are defaults for every phase. Sizes may be given in bytes or as strings such as "64MB". The trace is
+ * compressed according to the extension of the output file, as the trace reader expects: ".gz", ".xz", ".bz2", or uncompressed otherwise.
+ *
+ * With --clone, the trace is instead synthesized from a profile written by workload_profiler.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include "inf_stream.h"
+#include "trace_generator.h"
+#include "workload_clone.h"
+
+namespace
+{
+uint64_t parse_size(const nlohmann::json& j)
+{
+  if (!j.is_string()) {
+    return j.get<uint64_t>();
+  }
+
+  auto text = j.get<std::string>();
+  std::size_t consumed = 0;
+  auto value = std::stoull(text, &consumed, 0);
+  auto suffix = text.substr(consumed);
+  suffix.erase(std::remove(std::begin(suffix), std::end(suffix), ' '), std::end(suffix));
+  if (suffix.empty() || suffix == "B") {
+    return value;
+  }
+  if (suffix == "kB" || suffix == "KB" || suffix == "KiB") {
+    return value << 10;
+  }
+  if (suffix == "MB" || suffix == "MiB") {
+    return value << 20;
+  }
+  if (suffix == "GB" || suffix == "GiB") {
+    return value << 30;
+  }
+  throw std::invalid_argument{fmt::format("Unknown size '{}'", text)};
+}
+
+template <typename T>
+void read_size(const nlohmann::json& j, const char* key, T& value)
+{
+  if (j.contains(key)) {
+    value = static_cast<T>(parse_size(j.at(key)));
+  }
+}
+} // namespace
+
+namespace champsim
+{
+NLOHMANN_JSON_SERIALIZE_ENUM(trace_generator_spec::stream_kind, {{trace_generator_spec::stream_kind::stride, "stride"},
+                                                                 {trace_generator_spec::stream_kind::pointer_chase, "pointer_chase"},
+                                                                 {trace_generator_spec::stream_kind::random, "random"}})
+
+void from_json(const nlohmann::json& j, trace_generator_spec::data_stream& stream)
+{
+  stream.kind = j.value("kind", stream.kind);
+  read_size(j, "base", stream.base);
+  read_size(j, "footprint", stream.footprint);
+  stream.stride = j.value("stride", stream.stride);
+  stream.weight = j.value("weight", stream.weight);
+}
+
+void from_json(const nlohmann::json& j, trace_generator_spec& spec)
+{
+  spec.length = j.value("length", spec.length);
+  spec.seed = j.value("seed", spec.seed);
+  read_size(j, "code_base", spec.code_base);
+  read_size(j, "code_footprint", spec.code_footprint);
+  spec.load_fraction = j.value("load_fraction", spec.load_fraction);
+  spec.store_fraction = j.value("store_fraction", spec.store_fraction);
+  spec.branch_fraction = j.value("branch_fraction", spec.branch_fraction);
+  spec.conditional_weight = j.value("conditional_weight", spec.conditional_weight);
+  spec.direct_jump_weight = j.value("direct_jump_weight", spec.direct_jump_weight);
+  spec.indirect_weight = j.value("indirect_weight", spec.indirect_weight);
+  spec.call_weight = j.value("call_weight", spec.call_weight);
+  spec.return_weight = j.value("return_weight", spec.return_weight);
+  spec.branch_predictability = j.value("branch_predictability", spec.branch_predictability);
+  spec.indirect_targets = j.value("indirect_targets", spec.indirect_targets);
+  spec.dependency_chains = j.value("dependency_chains", spec.dependency_chains);
+  spec.chain_length = j.value("chain_length", spec.chain_length);
+  spec.streams = j.value("streams", spec.streams);
+}
+} // namespace champsim
+
+cloudsuite_instr to_cloudsuite(const input_instr& instr)
+{
+  cloudsuite_instr result{};
+  result.ip = instr.ip;
+  result.is_branch = instr.is_branch;
+  result.branch_taken = instr.branch_taken;
+  std::copy(std::begin(instr.destination_registers), std::end(instr.destination_registers), std::begin(result.destination_registers));
+  std::copy(std::begin(instr.source_registers), std::end(instr.source_registers), std::begin(result.source_registers));
+  std::copy(std::begin(instr.destination_memory), std::end(instr.destination_memory), std::begin(result.destination_memory));
+  std::copy(std::begin(instr.source_memory), std::end(instr.source_memory), std::begin(result.source_memory));
+  return result;
+}
+
+template <typename T, typename Stream, typename Generator>
+void write_trace(Stream&& stream, Generator& generator, uint64_t length)
+{
+  constexpr uint64_t chunk_size = 16384;
+  std::vector<T> buffer;
+  buffer.reserve(chunk_size);
+  for (uint64_t written = 0; written < length; written += std::size(buffer)) {
+    buffer.clear();
+    std::generate_n(std::back_inserter(buffer), std::min(chunk_size, length - written), [&] {
+      if constexpr (std::is_same_v<T, cloudsuite_instr>) {
+        return to_cloudsuite(generator());
+      } else {
+        return generator();
+      }
+    });
+    stream.write(reinterpret_cast<const char*>(std::data(buffer)), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                 static_cast<std::streamsize>(std::size(buffer) * sizeof(T)));
+  }
+}
+
+template <typename T, typename Generator>
+void write_trace_file(const std::string& fname, Generator& generator, uint64_t length)
+{
+  auto ends_with = [&](std::string_view suffix) {
+    return std::size(fname) >= std::size(suffix) && fname.compare(std::size(fname) - std::size(suffix), std::size(suffix), suffix) == 0;
+  };
+
+  if (ends_with("gz")) {
+    write_trace<T>(champsim::def_ostream<champsim::decomp_tags::gzip_tag_t<>>{fname}, generator, length);
+  } else if (ends_with("xz")) {
+    write_trace<T>(champsim::def_ostream<champsim::decomp_tags::lzma_tag_t<>>{fname}, generator, length);
+  } else if (ends_with("bz2")) {
+    write_trace<T>(champsim::def_ostream<champsim::decomp_tags::bzip2_tag_t>{fname}, generator, length);
+  } else {
+    write_trace<T>(std::ofstream{fname, std::ios::binary}, generator, length);
+  }
+}
+
+int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
+{
+  CLI::App app{"Write a synthetic ChampSim trace"};
+
+  std::string spec_name;
+  std::string clone_name;
+  std::string output_name;
+  uint64_t length = 1000000;
+  bool knob_cloudsuite = false;
+  std::optional<uint64_t> seed;
+
+  auto* spec_option = app.add_option("--spec", spec_name, "The JSON specification of the trace. If none is given, every parameter takes its default.")
+                          ->check(CLI::ExistingFile);
+  app.add_option("--clone", clone_name, "Synthesize the trace from a workload profile")->check(CLI::ExistingFile)->excludes(spec_option);
+  app.add_option("-n,--length", length, "The number of instructions to write");
+  app.add_option("--seed", seed, "Override the seed of every phase, or of the clone");
+  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Write the trace in the cloudsuite format");
+  app.add_option("output", output_name, "The trace file to write")->required();
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (!clone_name.empty()) {
+    std::ifstream profile_file{clone_name};
+    champsim::clone_generator generator{champsim::read_workload_profile(profile_file), seed.value_or(0)};
+    if (knob_cloudsuite) {
+      write_trace_file<cloudsuite_instr>(output_name, generator, length);
+    } else {
+      write_trace_file<input_instr>(output_name, generator, length);
+    }
+    return 0;
+  }
+
+  std::vector<champsim::trace_generator_spec> phases;
+  if (spec_name.empty()) {
+    phases.emplace_back();
+  } else {
+    std::ifstream spec_file{spec_name};
+    auto spec_json = nlohmann::json::parse(spec_file);
+    if (spec_json.contains("phases")) {
+      auto defaults = spec_json;
+      defaults.erase("phases");
+      for (const auto& phase_json : spec_json.at("phases")) {
+        auto merged = defaults;
+        merged.update(phase_json);
+        phases.push_back(merged.get<champsim::trace_generator_spec>());
+      }
+    } else {
+      phases.push_back(spec_json.get<champsim::trace_generator_spec>());
+    }
+  }
+
+  if (seed.has_value()) {
+    for (auto& phase : phases) {
+      phase.seed = seed.value();
+    }
+  }
+
+  champsim::trace_generator generator{phases};
+  if (knob_cloudsuite) {
+    write_trace_file<cloudsuite_instr>(output_name, generator, length);
+  } else {
+    write_trace_file<input_instr>(output_name, generator, length);
+  }
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Profile a trace into a statistical model that `trace_generator --clone` synthesizes a proxy trace from.
+ *
+ * The profile holds per-IP distributions of strides, reuse distances, dependency distances, and branch behavior, but no data and no absolute data
+ * addresses, so it can be shared where the trace cannot.
+ */
+
+#include <fstream>
+#include <limits>
+#include <string>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+
+#include "tracereader.h"
+#include "workload_clone.h"
+
+int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
+{
+  CLI::App app{"Profile a ChampSim trace for statistical cloning"};
+
+  std::string trace_name;
+  std::string output_name;
+  bool knob_cloudsuite = false;
+  uint64_t skip = 0;
+  uint64_t length = std::numeric_limits<uint64_t>::max();
+
+  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read the trace in the cloudsuite format");
+  app.add_option("--skip", skip, "The number of instructions to skip before profiling");
+  app.add_option("-n,--length", length, "The number of instructions to profile. If not specified, the rest of the trace is profiled.");
+  app.add_option("trace", trace_name, "The trace file to profile")->required()->check(CLI::ExistingFile);
+  app.add_option("output", output_name, "The JSON profile to write")->required();
+
+  CLI11_PARSE(app, argc, argv);
+
+  auto reader = get_tracereader(trace_name, 0, knob_cloudsuite, false);
+  for (uint64_t i = 0; i < skip && !reader.eof(); ++i) {
+    reader();
+  }
+
+  champsim::workload_profiler profiler;
+  uint64_t profiled = 0;
+  for (; profiled < length && !reader.eof(); ++profiled) {
+    profiler(reader());
+  }
+
+  auto profile = profiler.profile();
+  std::ofstream output_file{output_name};
+  champsim::write_workload_profile(output_file, profile);
+  fmt::print("Profiled {} instructions at {} IPs\n", profiled, std::size(profile.ips));
+
+  return 0;
+}